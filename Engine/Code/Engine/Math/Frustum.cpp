@@ -0,0 +1,78 @@
+#include "Engine/Math/Frustum.hpp"
+
+
+#include "Engine/Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+Frustum::Frustum()
+{
+	for ( int planeIndex = 0; planeIndex < NUM_PLANES; planeIndex++ )
+	{
+		m_planeNormals[ planeIndex ] = Vector3::ZERO;
+		m_planeDistances[ planeIndex ] = 0.f; //0 >= 0, so nothing is ever outside.
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+Frustum::Frustum( const Matrix4x4& viewProjection )
+{
+	//Gribb-Hartmann: clip space keeps -w <= x,y,z <= w, and each of those six inequalities is a plane in world space.
+	Vector4 rowX = viewProjection.GetRow( 0 );
+	Vector4 rowY = viewProjection.GetRow( 1 );
+	Vector4 rowZ = viewProjection.GetRow( 2 );
+	Vector4 rowW = viewProjection.GetRow( 3 );
+
+	Vector4 planes[ NUM_PLANES ];
+	planes[ LEFT ] = rowW + rowX;
+	planes[ RIGHT ] = rowW - rowX;
+	planes[ BOTTOM ] = rowW + rowY;
+	planes[ TOP ] = rowW - rowY;
+	planes[ NEAR_PLANE ] = rowW + rowZ;
+	planes[ FAR_PLANE ] = rowW - rowZ;
+
+	for ( int planeIndex = 0; planeIndex < NUM_PLANES; planeIndex++ )
+	{
+		const Vector4& plane = planes[ planeIndex ];
+		Vector3 normal = Vector3( plane.x, plane.y, plane.z );
+		float oneOverNormalLength = 1.f / normal.CalcLength();
+
+		m_planeNormals[ planeIndex ] = normal * oneOverNormalLength;
+		m_planeDistances[ planeIndex ] = plane.w * oneOverNormalLength;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool Frustum::IsPointInside( const Vector3& position ) const
+{
+	for ( int planeIndex = 0; planeIndex < NUM_PLANES; planeIndex++ )
+	{
+		if ( DotProduct( m_planeNormals[ planeIndex ], position ) + m_planeDistances[ planeIndex ] < 0.f )
+			return false;
+	}
+
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool Frustum::DoesOverlapAABB( const AABB3& bounds ) const
+{
+	for ( int planeIndex = 0; planeIndex < NUM_PLANES; planeIndex++ )
+	{
+		const Vector3& normal = m_planeNormals[ planeIndex ];
+
+		//Only the corner farthest along the plane normal matters: if even it is outside, the whole box is.
+		Vector3 farthestCorner;
+		farthestCorner.x = ( normal.x >= 0.f ) ? bounds.maxs.x : bounds.mins.x;
+		farthestCorner.y = ( normal.y >= 0.f ) ? bounds.maxs.y : bounds.mins.y;
+		farthestCorner.z = ( normal.z >= 0.f ) ? bounds.maxs.z : bounds.mins.z;
+
+		if ( DotProduct( normal, farthestCorner ) + m_planeDistances[ planeIndex ] < 0.f )
+			return false;
+	}
+
+	return true;
+}
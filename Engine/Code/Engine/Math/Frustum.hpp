@@ -0,0 +1,27 @@
+#pragma once
+
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Matrix4x4.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Six inward-facing planes pulled out of a view-projection matrix, i.e. whatever that matrix would clip.
+class Frustum
+{
+public:
+
+	enum FrustumPlane { LEFT = 0, RIGHT, BOTTOM, TOP, NEAR_PLANE, FAR_PLANE, NUM_PLANES }; //NEAR/FAR are taken by windows.h.
+
+	Frustum(); //Contains everything until built from a matrix.
+	explicit Frustum( const Matrix4x4& viewProjection );
+
+	bool IsPointInside( const Vector3& position ) const;
+	bool DoesOverlapAABB( const AABB3& bounds ) const; //Conservative: may keep a box hugging a frustum corner, never drops a visible one.
+
+
+private:
+
+	Vector3 m_planeNormals[ NUM_PLANES ]; //Unit length, pointing inside.
+	float m_planeDistances[ NUM_PLANES ]; //Inside when DotProduct( normal, point ) + distance >= 0.
+};
@@ -0,0 +1,99 @@
+#include "Engine/Math/Matrix4x4.hpp"
+
+
+#include "Engine/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC const Matrix4x4 Matrix4x4::IDENTITY;
+
+
+//--------------------------------------------------------------------------------------------------------------
+Matrix4x4::Matrix4x4()
+{
+	for ( int valueIndex = 0; valueIndex < 16; valueIndex++ )
+		m_values[ valueIndex ] = ( ( valueIndex % 5 ) == 0 ) ? 1.f : 0.f; //Diagonal is every 5th value.
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC Matrix4x4 Matrix4x4::CreatePerspectiveProjection( float fovDegreesY, float aspect, float nearDist, float farDist )
+{
+	float cotangentHalfFov = 1.f / tanf( ConvertDegreesToRadians( fovDegreesY * .5f ) );
+	float oneOverNearMinusFar = 1.f / ( nearDist - farDist );
+
+	Matrix4x4 projection;
+	projection.m_values[ 0 ] = cotangentHalfFov / aspect;
+	projection.m_values[ 5 ] = cotangentHalfFov;
+	projection.m_values[ 10 ] = ( farDist + nearDist ) * oneOverNearMinusFar;
+	projection.m_values[ 11 ] = -1.f;
+	projection.m_values[ 14 ] = ( 2.f * farDist * nearDist ) * oneOverNearMinusFar;
+	projection.m_values[ 15 ] = 0.f;
+	return projection;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC Matrix4x4 Matrix4x4::CreateRotationDegrees( float degrees, const Vector3& axisOfRotation )
+{
+	Vector3 axis = axisOfRotation;
+	axis.Normalize();
+
+	float c = CosDegrees( degrees );
+	float s = SinDegrees( degrees );
+	float oneMinusC = 1.f - c;
+
+	Matrix4x4 rotation;
+	rotation.m_values[ 0 ] = ( axis.x * axis.x * oneMinusC ) + c;
+	rotation.m_values[ 1 ] = ( axis.y * axis.x * oneMinusC ) + ( axis.z * s );
+	rotation.m_values[ 2 ] = ( axis.z * axis.x * oneMinusC ) - ( axis.y * s );
+	rotation.m_values[ 4 ] = ( axis.x * axis.y * oneMinusC ) - ( axis.z * s );
+	rotation.m_values[ 5 ] = ( axis.y * axis.y * oneMinusC ) + c;
+	rotation.m_values[ 6 ] = ( axis.z * axis.y * oneMinusC ) + ( axis.x * s );
+	rotation.m_values[ 8 ] = ( axis.x * axis.z * oneMinusC ) + ( axis.y * s );
+	rotation.m_values[ 9 ] = ( axis.y * axis.z * oneMinusC ) - ( axis.x * s );
+	rotation.m_values[ 10 ] = ( axis.z * axis.z * oneMinusC ) + c;
+	return rotation;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC Matrix4x4 Matrix4x4::CreateTranslation( const Vector3& translation )
+{
+	Matrix4x4 result;
+	result.m_values[ 12 ] = translation.x;
+	result.m_values[ 13 ] = translation.y;
+	result.m_values[ 14 ] = translation.z;
+	return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+Vector4 Matrix4x4::TransformPoint( const Vector3& position ) const
+{
+	return Vector4(
+		( m_values[ 0 ] * position.x ) + ( m_values[ 4 ] * position.y ) + ( m_values[ 8 ] * position.z ) + m_values[ 12 ],
+		( m_values[ 1 ] * position.x ) + ( m_values[ 5 ] * position.y ) + ( m_values[ 9 ] * position.z ) + m_values[ 13 ],
+		( m_values[ 2 ] * position.x ) + ( m_values[ 6 ] * position.y ) + ( m_values[ 10 ] * position.z ) + m_values[ 14 ],
+		( m_values[ 3 ] * position.x ) + ( m_values[ 7 ] * position.y ) + ( m_values[ 11 ] * position.z ) + m_values[ 15 ]
+	);
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+Matrix4x4 Matrix4x4::operator*( const Matrix4x4& rhs ) const
+{
+	Matrix4x4 result;
+	for ( int column = 0; column < 4; column++ )
+	{
+		for ( int row = 0; row < 4; row++ )
+		{
+			float sum = 0.f;
+			for ( int k = 0; k < 4; k++ )
+				sum += GetValue( row, k ) * rhs.GetValue( k, column );
+			result.m_values[ ( column * 4 ) + row ] = sum;
+		}
+	}
+	return result;
+}
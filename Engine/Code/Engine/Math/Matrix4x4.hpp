@@ -0,0 +1,33 @@
+#pragma once
+
+
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Vector4.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Column-major like OpenGL, so m_values[ ( column * 4 ) + row ] and the translation sits in m_values[ 12..14 ].
+//Compose like the fixed-function stack: A * B applies B first, matching glMultMatrix/glRotate/glTranslate order.
+class Matrix4x4
+{
+public:
+
+	Matrix4x4(); //Identity.
+
+	static Matrix4x4 CreatePerspectiveProjection( float fovDegreesY, float aspect, float nearDist, float farDist ); //Same as gluPerspective.
+	static Matrix4x4 CreateRotationDegrees( float degrees, const Vector3& axisOfRotation ); //Same as glRotatef.
+	static Matrix4x4 CreateTranslation( const Vector3& translation );
+
+	inline float GetValue( int row, int column ) const { return m_values[ ( column * 4 ) + row ]; }
+	inline Vector4 GetRow( int row ) const { return Vector4( m_values[ row ], m_values[ 4 + row ], m_values[ 8 + row ], m_values[ 12 + row ] ); }
+	Vector4 TransformPoint( const Vector3& position ) const; //w = 1, result not divided through by w.
+
+	Matrix4x4 operator*( const Matrix4x4& rhs ) const;
+
+
+public:
+
+	static const Matrix4x4 IDENTITY;
+
+	float m_values[ 16 ];
+};
@@ -9,6 +9,13 @@
 #include "Engine/Math/IntVector2.hpp"
 #include "Engine/Math/Vector3.hpp"
 #include "Engine/Math/Vector4.hpp"
+#include "Engine/Error/ErrorWarningAssert.hpp"
+#include <vector>
+
+#if defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) ) || defined( __SSE2__ )
+	#define NOISE_USE_SSE2
+	#include <emmintrin.h>
+#endif
 
 
 //-----------------------------------------------------------------------------------------------
@@ -786,9 +793,10 @@ float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, floa
 //		...where A is the <baseAmplitude> and P is the <persistance>.
 //	<persistance>: The fraction of amplitude of each subsequent octave, based on the amplitude of the previous octave.  For
 //		example, with a persistance of 0.3, each octave is only 30% as strong as the previous octave.
+//	<seed>: Picks the gradient lattice; 0 reproduces the original unseeded noise.
 //
 //--------------------------------------------------------------------------------------------------------------
-float ComputePerlinNoiseValueAtPosition2D( const Vector2& position, float perlinNoiseGridCellSize, int numOctaves, float persistence )
+float ComputePerlinNoiseValueAtPosition2D( const Vector2& position, float perlinNoiseGridCellSize, int numOctaves, float persistence, unsigned int seed )
 {
 	float totalPerlinNoise = 0.f;
 	float currentOctaveAmplitude = 1.f;
@@ -806,10 +814,10 @@ float ComputePerlinNoiseValueAtPosition2D( const Vector2& position, float perlin
 		float westWeight = 1.f - eastWeight;
 		float southWeight = 1.f - northWeight;
 
-		Vector2 southwestNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x, perlinCell.y );
-		Vector2 southeastNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x + 1, perlinCell.y );
-		Vector2 northeastNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x + 1, perlinCell.y + 1 );
-		Vector2 northwestNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x, perlinCell.y + 1 );
+		Vector2 southwestNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x, perlinCell.y, seed );
+		Vector2 southeastNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x + 1, perlinCell.y, seed );
+		Vector2 northeastNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x + 1, perlinCell.y + 1, seed );
+		Vector2 northwestNoiseGradient = GetPseudoRandomNoiseDirection2D( perlinCell.x, perlinCell.y + 1, seed );
 
 		float southwestDot = DotProduct( southwestNoiseGradient, perlinPositionUV );
 		float southeastDot = DotProduct( southeastNoiseGradient, Vector2( perlinPositionAntiUV.x, perlinPositionUV.y ) );
@@ -832,3 +840,150 @@ float ComputePerlinNoiseValueAtPosition2D( const Vector2& position, float perlin
 
 	return totalPerlinNoise;
 }
+
+
+//---------------------------------------------------------------------------
+// Batched version of the above over a grid of samples at
+//	gridMins + ( sampleX, sampleY ) * sampleSpacing, written row-major (x fastest)
+//	into <out_noiseValues>, which must hold numSamplesX * numSamplesY floats.
+//
+//	Each octave looks up the lattice gradients the grid touches once into a
+//	table shared by all samples, instead of four cos/sin pairs per sample.
+//	Rows are then blended four columns at a time with SSE2 where available.
+//	Every sample goes through the same float operations in the same order as
+//	ComputePerlinNoiseValueAtPosition2D, so results are bit-identical to it
+//	as long as the sample positions themselves are exact (e.g. whole blocks).
+//
+//---------------------------------------------------------------------------
+void ComputePerlinNoiseGrid2D( const Vector2& gridMins, int numSamplesX, int numSamplesY, float sampleSpacing, float perlinNoiseGridCellSize, int numOctaves, float persistence, float* out_noiseValues, unsigned int seed )
+{
+	ASSERT_OR_DIE( ( numSamplesX > 0 ) && ( numSamplesY > 0 ) && ( sampleSpacing > 0.f ), "ComputePerlinNoiseGrid2D Given Empty Grid" );
+
+	const int numSamples = numSamplesX * numSamplesY;
+	for ( int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex )
+		out_noiseValues[ sampleIndex ] = 0.f;
+
+	//Per-column terms only depend on x, so they're shared down every row. Gathered gradients are per-row scratch.
+	std::vector< float > scratch( 12 * numSamplesX );
+	float* columnUV = &scratch[ 0 ];
+	float* columnAntiUV = columnUV + numSamplesX;
+	float* columnEastWeight = columnAntiUV + numSamplesX;
+	float* columnWestWeight = columnEastWeight + numSamplesX;
+	float* southwestGradientsX = columnWestWeight + numSamplesX;
+	float* southwestGradientsY = southwestGradientsX + numSamplesX;
+	float* southeastGradientsX = southwestGradientsY + numSamplesX;
+	float* southeastGradientsY = southeastGradientsX + numSamplesX;
+	float* northeastGradientsX = southeastGradientsY + numSamplesX;
+	float* northeastGradientsY = northeastGradientsX + numSamplesX;
+	float* northwestGradientsX = northeastGradientsY + numSamplesX;
+	float* northwestGradientsY = northwestGradientsX + numSamplesX;
+	std::vector< int > columnCellOffsets( numSamplesX );
+	std::vector< Vector2 > gradientTable;
+
+	float currentOctaveAmplitude = 1.f;
+	float totalMaxAmplitude = 0.f;
+	float perlinGridFrequency = ( 1.f / perlinNoiseGridCellSize );
+	for ( int octaveNumber = 0; octaveNumber < numOctaves; ++octaveNumber )
+	{
+		//Positions only grow with the sample index, so the first and last samples bound the lattice cells touched.
+		int minCellX = (int)floor( ( gridMins.x + ( 0.f * sampleSpacing ) ) * perlinGridFrequency );
+		int maxCellX = (int)floor( ( gridMins.x + ( (float)( numSamplesX - 1 ) * sampleSpacing ) ) * perlinGridFrequency ) + 1;
+		int minCellY = (int)floor( ( gridMins.y + ( 0.f * sampleSpacing ) ) * perlinGridFrequency );
+		int maxCellY = (int)floor( ( gridMins.y + ( (float)( numSamplesY - 1 ) * sampleSpacing ) ) * perlinGridFrequency ) + 1;
+		int gradientTableWidth = maxCellX - minCellX + 1;
+
+		gradientTable.resize( gradientTableWidth * ( maxCellY - minCellY + 1 ) );
+		for ( int cellY = minCellY; cellY <= maxCellY; ++cellY )
+			for ( int cellX = minCellX; cellX <= maxCellX; ++cellX )
+				gradientTable[ ( ( cellY - minCellY ) * gradientTableWidth ) + ( cellX - minCellX ) ] = GetPseudoRandomNoiseDirection2D( cellX, cellY, seed );
+
+		for ( int sampleX = 0; sampleX < numSamplesX; ++sampleX )
+		{
+			float perlinPositionX = ( gridMins.x + ( (float)sampleX * sampleSpacing ) ) * perlinGridFrequency;
+			float perlinPositionFloorX = (float)floor( perlinPositionX );
+			columnCellOffsets[ sampleX ] = (int)perlinPositionFloorX - minCellX;
+			columnUV[ sampleX ] = perlinPositionX - perlinPositionFloorX;
+			columnAntiUV[ sampleX ] = columnUV[ sampleX ] - 1.f;
+			columnEastWeight[ sampleX ] = SmoothStep( columnUV[ sampleX ] );
+			columnWestWeight[ sampleX ] = 1.f - columnEastWeight[ sampleX ];
+		}
+
+		for ( int sampleY = 0; sampleY < numSamplesY; ++sampleY )
+		{
+			float perlinPositionY = ( gridMins.y + ( (float)sampleY * sampleSpacing ) ) * perlinGridFrequency;
+			float perlinPositionFloorY = (float)floor( perlinPositionY );
+			float rowUV = perlinPositionY - perlinPositionFloorY;
+			float rowAntiUV = rowUV - 1.f;
+			float northWeight = SmoothStep( rowUV );
+			float southWeight = 1.f - northWeight;
+
+			const Vector2* southGradients = &gradientTable[ ( (int)perlinPositionFloorY - minCellY ) * gradientTableWidth ];
+			const Vector2* northGradients = southGradients + gradientTableWidth;
+			for ( int sampleX = 0; sampleX < numSamplesX; ++sampleX )
+			{
+				int cellOffset = columnCellOffsets[ sampleX ];
+				southwestGradientsX[ sampleX ] = southGradients[ cellOffset ].x;
+				southwestGradientsY[ sampleX ] = southGradients[ cellOffset ].y;
+				southeastGradientsX[ sampleX ] = southGradients[ cellOffset + 1 ].x;
+				southeastGradientsY[ sampleX ] = southGradients[ cellOffset + 1 ].y;
+				northeastGradientsX[ sampleX ] = northGradients[ cellOffset + 1 ].x;
+				northeastGradientsY[ sampleX ] = northGradients[ cellOffset + 1 ].y;
+				northwestGradientsX[ sampleX ] = northGradients[ cellOffset ].x;
+				northwestGradientsY[ sampleX ] = northGradients[ cellOffset ].y;
+			}
+
+			float* rowNoiseValues = out_noiseValues + ( sampleY * numSamplesX );
+			int sampleX = 0;
+
+		#ifdef NOISE_USE_SSE2
+			const __m128 rowUV4 = _mm_set1_ps( rowUV );
+			const __m128 rowAntiUV4 = _mm_set1_ps( rowAntiUV );
+			const __m128 northWeight4 = _mm_set1_ps( northWeight );
+			const __m128 southWeight4 = _mm_set1_ps( southWeight );
+			const __m128 octaveAmplitude4 = _mm_set1_ps( currentOctaveAmplitude );
+			for ( ; sampleX + 4 <= numSamplesX; sampleX += 4 )
+			{
+				__m128 uv = _mm_loadu_ps( columnUV + sampleX );
+				__m128 antiUV = _mm_loadu_ps( columnAntiUV + sampleX );
+				__m128 eastWeight = _mm_loadu_ps( columnEastWeight + sampleX );
+				__m128 westWeight = _mm_loadu_ps( columnWestWeight + sampleX );
+
+				__m128 southwestDot = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( southwestGradientsX + sampleX ), uv ), _mm_mul_ps( _mm_loadu_ps( southwestGradientsY + sampleX ), rowUV4 ) );
+				__m128 southeastDot = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( southeastGradientsX + sampleX ), antiUV ), _mm_mul_ps( _mm_loadu_ps( southeastGradientsY + sampleX ), rowUV4 ) );
+				__m128 northeastDot = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( northeastGradientsX + sampleX ), antiUV ), _mm_mul_ps( _mm_loadu_ps( northeastGradientsY + sampleX ), rowAntiUV4 ) );
+				__m128 northwestDot = _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( northwestGradientsX + sampleX ), uv ), _mm_mul_ps( _mm_loadu_ps( northwestGradientsY + sampleX ), rowAntiUV4 ) );
+
+				__m128 southBlend = _mm_add_ps( _mm_mul_ps( eastWeight, southeastDot ), _mm_mul_ps( westWeight, southwestDot ) );
+				__m128 northBlend = _mm_add_ps( _mm_mul_ps( eastWeight, northeastDot ), _mm_mul_ps( westWeight, northwestDot ) );
+				__m128 fourWayBlend = _mm_add_ps( _mm_mul_ps( southWeight4, southBlend ), _mm_mul_ps( northWeight4, northBlend ) );
+
+				_mm_storeu_ps( rowNoiseValues + sampleX, _mm_add_ps( _mm_loadu_ps( rowNoiseValues + sampleX ), _mm_mul_ps( octaveAmplitude4, fourWayBlend ) ) );
+			}
+		#endif
+
+			for ( ; sampleX < numSamplesX; ++sampleX ) //Remainder, or everything without SSE2.
+			{
+				float southwestDot = ( southwestGradientsX[ sampleX ] * columnUV[ sampleX ] ) + ( southwestGradientsY[ sampleX ] * rowUV );
+				float southeastDot = ( southeastGradientsX[ sampleX ] * columnAntiUV[ sampleX ] ) + ( southeastGradientsY[ sampleX ] * rowUV );
+				float northeastDot = ( northeastGradientsX[ sampleX ] * columnAntiUV[ sampleX ] ) + ( northeastGradientsY[ sampleX ] * rowAntiUV );
+				float northwestDot = ( northwestGradientsX[ sampleX ] * columnUV[ sampleX ] ) + ( northwestGradientsY[ sampleX ] * rowAntiUV );
+
+				float southBlend = ( columnEastWeight[ sampleX ] * southeastDot ) + ( columnWestWeight[ sampleX ] * southwestDot );
+				float northBlend = ( columnEastWeight[ sampleX ] * northeastDot ) + ( columnWestWeight[ sampleX ] * northwestDot );
+				float fourWayBlend = ( southWeight * southBlend ) + ( northWeight * northBlend );
+
+				rowNoiseValues[ sampleX ] += currentOctaveAmplitude * fourWayBlend;
+			}
+		}
+
+		perlinGridFrequency *= 2.f;
+		totalMaxAmplitude += currentOctaveAmplitude;
+		currentOctaveAmplitude *= persistence;
+	}
+
+	if ( totalMaxAmplitude != 0.f )
+	{
+		for ( int sampleIndex = 0; sampleIndex < numSamples; ++sampleIndex )
+			out_noiseValues[ sampleIndex ] /= totalMaxAmplitude;
+	}
+}
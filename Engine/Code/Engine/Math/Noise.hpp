@@ -218,8 +218,9 @@ float GetPseudoRandomNoiseValueNegOneToOne3D( int positionX, int positionY, int
 float GetPseudoRandomNoiseValueZeroToOne3D( int positionX, int positionY, int positionZ );
 float GetPseudoNoiseAngleRadians1D( int position );
 float GetPseudoNoiseAngleRadians2D( int positionX, int positionY );
-Vector2 GetPseudoRandomNoiseDirection2D( int positionX, int positionY );
-float ComputePerlinNoiseValueAtPosition2D( const Vector2& position, float perlinNoiseGridCellSize, int numOctaves, float persistance );
+Vector2 GetPseudoRandomNoiseDirection2D( int positionX, int positionY, unsigned int seed=0 );
+float ComputePerlinNoiseValueAtPosition2D( const Vector2& position, float perlinNoiseGridCellSize, int numOctaves, float persistance, unsigned int seed=0 );
+void ComputePerlinNoiseGrid2D( const Vector2& gridMins, int numSamplesX, int numSamplesY, float sampleSpacing, float perlinNoiseGridCellSize, int numOctaves, float persistance, float* out_noiseValues, unsigned int seed=0 );
 
 
 //---------------------------------------------------------------------------
@@ -318,13 +319,24 @@ inline float GetPseudoNoiseAngleRadians2D( int positionX, int positionY )
 
 
 //-----------------------------------------------------------------------------------------------
-inline Vector2 GetPseudoRandomNoiseDirection2D( int xPosition, int yPosition )
+// Seed 0 keeps the original bit-noise hash, so anything generated before seeds existed is unchanged;
+//	any other seed hashes through Get2dNoiseUint instead.
+//-----------------------------------------------------------------------------------------------
+inline Vector2 GetPseudoRandomNoiseDirection2D( int xPosition, int yPosition, unsigned int seed )
 {
 	const float ONE_OVER_MAX_POSITIVE_INT = ( 1.f / 2147483648.f );
 	const float SCALE_FACTOR = ONE_OVER_MAX_POSITIVE_INT * 360.f;
-	int position = xPosition + ( yPosition * 57 );
-	int bits = ( position << 13 ) ^ position;
-	int pseudoRandomPositiveInt = ( bits * ( ( bits * bits * 15731 ) + 789221 ) + 1376312589 ) & 0x7fffffff;
+	int pseudoRandomPositiveInt;
+	if ( seed == 0 )
+	{
+		int position = xPosition + ( yPosition * 57 );
+		int bits = ( position << 13 ) ^ position;
+		pseudoRandomPositiveInt = ( bits * ( ( bits * bits * 15731 ) + 789221 ) + 1376312589 ) & 0x7fffffff;
+	}
+	else
+	{
+		pseudoRandomPositiveInt = (int)( Get2dNoiseUint( xPosition, yPosition, seed ) & 0x7fffffff );
+	}
 	float pseudoRandomDegrees = SCALE_FACTOR * (float)pseudoRandomPositiveInt;
 
 	// #TODO: Rewrite this to use the randomized int to look up Vector2 from a (small) cos/sin
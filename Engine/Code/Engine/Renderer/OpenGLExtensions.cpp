@@ -7,4 +7,6 @@
 PFNGLGENBUFFERSPROC			glGenBuffers		= nullptr;
 PFNGLBINDBUFFERPROC			glBindBuffer		= nullptr;
 PFNGLBUFFERDATAPROC			glBufferData		= nullptr;
-PFNGLDELETEBUFFERSPROC		glDeleteBuffers		= nullptr;
\ No newline at end of file
+PFNGLDELETEBUFFERSPROC		glDeleteBuffers		= nullptr;
+PFNGLBUFFERSUBDATAPROC		glBufferSubData		= nullptr;
+PFNGLMULTIDRAWARRAYSPROC	glMultiDrawArrays	= nullptr;
\ No newline at end of file
@@ -14,3 +14,5 @@ extern PFNGLGENBUFFERSPROC		glGenBuffers;
 extern PFNGLBINDBUFFERPROC		glBindBuffer;
 extern PFNGLBUFFERDATAPROC		glBufferData;
 extern PFNGLDELETEBUFFERSPROC	glDeleteBuffers;
+extern PFNGLBUFFERSUBDATAPROC	glBufferSubData;
+extern PFNGLMULTIDRAWARRAYSPROC	glMultiDrawArrays;
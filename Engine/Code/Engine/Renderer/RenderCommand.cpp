@@ -1,141 +1,295 @@
 #include "Engine/Renderer/RenderCommand.hpp"
 
 #include "Engine/Renderer/TheRenderer.hpp"
+#include "Engine/Math/MathUtils.hpp"
 
 
 //--------------------------------------------------------------------------------------------------------------
-std::list< RenderCommand* >* g_theRenderCommands = nullptr;
+RenderCommandPool* g_theRenderCommands = nullptr;
 
 
 //--------------------------------------------------------------------------------------------------------------
-void RenderCommandPoint::Render()
-{
-	float sizeScalar = .1f;
+static const float POINT_COMMAND_SIZE_SCALAR = .1f;
+static const float ARROW_COMMAND_HEAD_SCALAR = .5f;
+static const int SPHERE_COMMAND_SIDES_PER_CIRCLE = 10;
+
 
-	//x in XY.
-	g_theRenderer->DrawLine( m_position + ( Vector3( -1.f, -1.f, 0.f ) * sizeScalar ), m_position + ( Vector3( 1.f, 1.f, 0.f ) * sizeScalar ), m_color, m_color, m_lineThickness );
-	g_theRenderer->DrawLine( m_position + ( Vector3( -1.f, 1.f, 0.f ) * sizeScalar ), m_position + ( Vector3( 1.f, -1.f, 0.f ) * sizeScalar ), m_color, m_color, m_lineThickness );
+//--------------------------------------------------------------------------------------------------------------
+static inline void AppendLine( const Vector3& startPos, const Vector3& endPos, const Rgba& color, std::vector< Vertex3D_PCT >& out_lineVertexes )
+{
+	out_lineVertexes.push_back( Vertex3D_PCT( startPos, color ) );
+	out_lineVertexes.push_back( Vertex3D_PCT( endPos, color ) );
+}
 
-	//x in XZ.
-	g_theRenderer->DrawLine( m_position + ( Vector3( -1.f, 0.f, -1.f ) * sizeScalar ), m_position + ( Vector3( 1.f, 0.f, 1.f ) * sizeScalar ), m_color, m_color, m_lineThickness );
-	g_theRenderer->DrawLine( m_position + ( Vector3( -1.f, 0.f, 1.f ) * sizeScalar ), m_position + ( Vector3( 1.f, 0.f, -1.f ) * sizeScalar ), m_color, m_color, m_lineThickness );
 
-	//x in YZ.
-	g_theRenderer->DrawLine( m_position + ( Vector3( 0.f, -1.f, -1.f ) * sizeScalar ), m_position + ( Vector3( 0.f, 1.f, 1.f ) * sizeScalar ), m_color, m_color, m_lineThickness );
-	g_theRenderer->DrawLine( m_position + ( Vector3( 0.f, -1.f, 1.f ) * sizeScalar ), m_position + ( Vector3( 0.f, 1.f, -1.f ) * sizeScalar ), m_color, m_color, m_lineThickness );
+//--------------------------------------------------------------------------------------------------------------
+void RenderCommandPool::AddPoint( const Vector3& position, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
+{
+	AddCommand( RENDER_COMMAND_POINT, position, Vector3::ZERO, secondsToLive, depthMode, color, lineThickness );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void RenderCommandLine::Render()
+void RenderCommandPool::AddLine( const Vector3& startPos, const Vector3& endPos, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
 {
-	g_theRenderer->DrawLine( m_startPos, m_endPos, m_color, m_color, m_lineThickness );
+	AddCommand( RENDER_COMMAND_LINE, startPos, endPos, secondsToLive, depthMode, color, lineThickness );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void RenderCommandArrow::Render()
+void RenderCommandPool::AddArrow( const Vector3& startPos, const Vector3& endPos, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
 {
-	g_theRenderer->DrawLine( m_startPos, m_endPos, m_color, m_color, m_lineThickness );
+	AddCommand( RENDER_COMMAND_ARROW, startPos, endPos, secondsToLive, depthMode, color, lineThickness );
+}
 
-	float arrowScalar = .5f;
-	Vector3 arrowOffsets = ( m_endPos - m_startPos ) * arrowScalar;
-	Vector3 arrowX = Vector3( m_startPos.x + arrowOffsets.x, m_endPos.y, m_endPos.z );
-	Vector3 arrowY = Vector3( m_endPos.x, m_startPos.y + arrowOffsets.y, m_endPos.z );
-	Vector3 arrowZ = Vector3( m_endPos.x, m_endPos.y, m_startPos.z + arrowOffsets.z );
 
-	g_theRenderer->DrawLine( m_endPos, arrowX, m_color, m_color, m_lineThickness );
-	g_theRenderer->DrawLine( m_endPos, arrowY, m_color, m_color, m_lineThickness );
-	g_theRenderer->DrawLine( m_endPos, arrowZ, m_color, m_color, m_lineThickness );
+//--------------------------------------------------------------------------------------------------------------
+void RenderCommandPool::AddAABB3( const AABB3& bounds, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
+{
+	AddCommand( RENDER_COMMAND_AABB3, bounds.mins, bounds.maxs, secondsToLive, depthMode, color, lineThickness );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void RenderCommandAABB3::Render()
+void RenderCommandPool::AddSphere( const Vector3& centerPos, float radius, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
 {
-	g_theRenderer->DrawAABB( TheRenderer::VertexGroupingRule::AS_QUADS, m_bounds, m_color, m_lineThickness );
+	AddCommand( RENDER_COMMAND_SPHERE, centerPos, Vector3( radius, 0.f, 0.f ), secondsToLive, depthMode, color, lineThickness );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void RenderCommandSphere::Render()
+void RenderCommandPool::AddCommand( RenderCommandType type, const Vector3& firstPos, const Vector3& secondPos, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
 {
-	g_theRenderer->DrawSphere( TheRenderer::VertexGroupingRule::AS_LINES, m_centerPos, m_radius, 10.f, 10.f, m_color, m_lineThickness );
+	m_types.push_back( type );
+	m_firstPositions.push_back( firstPos );
+	m_secondPositions.push_back( secondPos );
+	m_colors.push_back( color );
+	m_secondsToLive.push_back( secondsToLive );
+	m_depthModes.push_back( depthMode );
+	m_lineThicknesses.push_back( lineThickness );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void RenderAndExpireDebugCommands() //Handles the depth modes.
+void RenderCommandPool::RemoveCommandBySwap( int commandIndex )
 {
-	auto commandIterEnd = g_theRenderCommands->end();
-	for ( auto commandIter = g_theRenderCommands->begin(); commandIter != commandIterEnd; )
+	int lastIndex = GetNumCommands() - 1;
+	if ( commandIndex != lastIndex )
 	{
-		RenderCommand* currentCommand = *commandIter;
+		m_types[ commandIndex ] = m_types[ lastIndex ];
+		m_firstPositions[ commandIndex ] = m_firstPositions[ lastIndex ];
+		m_secondPositions[ commandIndex ] = m_secondPositions[ lastIndex ];
+		m_colors[ commandIndex ] = m_colors[ lastIndex ];
+		m_secondsToLive[ commandIndex ] = m_secondsToLive[ lastIndex ];
+		m_depthModes[ commandIndex ] = m_depthModes[ lastIndex ];
+		m_lineThicknesses[ commandIndex ] = m_lineThicknesses[ lastIndex ];
+	}
+
+	m_types.pop_back();
+	m_firstPositions.pop_back();
+	m_secondPositions.pop_back();
+	m_colors.pop_back();
+	m_secondsToLive.pop_back();
+	m_depthModes.pop_back();
+	m_lineThicknesses.pop_back();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void RenderCommandPool::Update( float deltaSeconds )
+{
+	for ( unsigned int commandIndex = 0; commandIndex < m_secondsToLive.size(); commandIndex++ )
+		m_secondsToLive[ commandIndex ] -= deltaSeconds;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+std::vector< Vertex3D_PCT >& RenderCommandPool::GetOrCreateLineBatch( bool isDepthTested, float lineThickness )
+{
+	for ( LineBatch& lineBatch : m_lineBatches ) //Only ever a handful, one per thickness in use.
+		if ( ( lineBatch.m_isDepthTested == isDepthTested ) && ( lineBatch.m_lineThickness == lineThickness ) )
+			return lineBatch.m_vertexes;
+
+	LineBatch newBatch;
+	newBatch.m_isDepthTested = isDepthTested;
+	newBatch.m_lineThickness = lineThickness;
+	m_lineBatches.push_back( newBatch );
+	return m_lineBatches.back().m_vertexes;
+}
 
-		switch ( currentCommand->m_depthMode )
+
+//--------------------------------------------------------------------------------------------------------------
+void RenderCommandPool::AppendCommandLines( int commandIndex, const Rgba& color, std::vector< Vertex3D_PCT >& out_lineVertexes ) const
+{
+	const Vector3& firstPos = m_firstPositions[ commandIndex ];
+	const Vector3& secondPos = m_secondPositions[ commandIndex ];
+
+	switch ( m_types[ commandIndex ] )
+	{
+		case RENDER_COMMAND_POINT: //An x in each of XY, XZ, YZ.
 		{
-		case DEPTH_TEST_ON: 
-			g_theRenderer->EnableDepthTesting( true );
-			currentCommand->Render();
+			const float size = POINT_COMMAND_SIZE_SCALAR;
+			AppendLine( firstPos + Vector3( -size, -size, 0.f ), firstPos + Vector3( size, size, 0.f ), color, out_lineVertexes );
+			AppendLine( firstPos + Vector3( -size, size, 0.f ), firstPos + Vector3( size, -size, 0.f ), color, out_lineVertexes );
+			AppendLine( firstPos + Vector3( -size, 0.f, -size ), firstPos + Vector3( size, 0.f, size ), color, out_lineVertexes );
+			AppendLine( firstPos + Vector3( -size, 0.f, size ), firstPos + Vector3( size, 0.f, -size ), color, out_lineVertexes );
+			AppendLine( firstPos + Vector3( 0.f, -size, -size ), firstPos + Vector3( 0.f, size, size ), color, out_lineVertexes );
+			AppendLine( firstPos + Vector3( 0.f, -size, size ), firstPos + Vector3( 0.f, size, -size ), color, out_lineVertexes );
 			break;
-		case DEPTH_TEST_OFF:
-			g_theRenderer->EnableDepthTesting( false );
-			currentCommand->Render();
+		}
+		case RENDER_COMMAND_LINE:
+			AppendLine( firstPos, secondPos, color, out_lineVertexes );
 			break;
-		case DEPTH_TEST_DUAL:
-			unsigned char alphaBackup = currentCommand->m_color.alphaOpacity;
-			float sizeBackup = currentCommand->m_lineThickness;
-			g_theRenderer->EnableDepthTesting( false );
-			currentCommand->m_color.alphaOpacity >>= 2; //Halved.
-			currentCommand->m_lineThickness *= .3f;
-			currentCommand->Render();
-
-			g_theRenderer->EnableDepthTesting( true );
-			currentCommand->m_color.alphaOpacity = alphaBackup;
-			currentCommand->m_lineThickness = sizeBackup;
-			currentCommand->Render();
+		case RENDER_COMMAND_ARROW:
+		{
+			AppendLine( firstPos, secondPos, color, out_lineVertexes );
+
+			Vector3 arrowOffsets = ( secondPos - firstPos ) * ARROW_COMMAND_HEAD_SCALAR;
+			AppendLine( secondPos, Vector3( firstPos.x + arrowOffsets.x, secondPos.y, secondPos.z ), color, out_lineVertexes );
+			AppendLine( secondPos, Vector3( secondPos.x, firstPos.y + arrowOffsets.y, secondPos.z ), color, out_lineVertexes );
+			AppendLine( secondPos, Vector3( secondPos.x, secondPos.y, firstPos.z + arrowOffsets.z ), color, out_lineVertexes );
 			break;
 		}
-
-		if ( currentCommand->IsExpired() ) //Expire after draw or 1-frame commands wouldn't show.
+		case RENDER_COMMAND_AABB3: //12 edges: 4 around the bottom, 4 around the top, 4 joining them.
+		{
+			Vector3 corners[ 4 ] = {
+				Vector3( firstPos.x, firstPos.y, 0.f ), Vector3( secondPos.x, firstPos.y, 0.f ),
+				Vector3( secondPos.x, secondPos.y, 0.f ), Vector3( firstPos.x, secondPos.y, 0.f )
+			};
+			for ( int cornerIndex = 0; cornerIndex < 4; cornerIndex++ )
+			{
+				Vector3 corner = corners[ cornerIndex ];
+				Vector3 nextCorner = corners[ ( cornerIndex + 1 ) % 4 ];
+				AppendLine( Vector3( corner.x, corner.y, firstPos.z ), Vector3( nextCorner.x, nextCorner.y, firstPos.z ), color, out_lineVertexes );
+				AppendLine( Vector3( corner.x, corner.y, secondPos.z ), Vector3( nextCorner.x, nextCorner.y, secondPos.z ), color, out_lineVertexes );
+				AppendLine( Vector3( corner.x, corner.y, firstPos.z ), Vector3( corner.x, corner.y, secondPos.z ), color, out_lineVertexes );
+			}
+			break;
+		}
+		case RENDER_COMMAND_SPHERE: //A circle in each of YZ, XZ, XY, like DrawSphere.
 		{
-			commandIter = g_theRenderCommands->erase( commandIter );
+			const float radius = secondPos.x;
+			const float degreesPerSide = 360.f / (float)SPHERE_COMMAND_SIDES_PER_CIRCLE;
+			for ( int sideIndex = 0; sideIndex < SPHERE_COMMAND_SIDES_PER_CIRCLE; sideIndex++ )
+			{
+				float startCos = radius * CosDegrees( degreesPerSide * sideIndex );
+				float startSin = radius * SinDegrees( degreesPerSide * sideIndex );
+				float endCos = radius * CosDegrees( degreesPerSide * ( sideIndex + 1 ) );
+				float endSin = radius * SinDegrees( degreesPerSide * ( sideIndex + 1 ) );
 
-			delete currentCommand;
-			currentCommand = nullptr;
+				AppendLine( firstPos + Vector3( 0.f, startCos, startSin ), firstPos + Vector3( 0.f, endCos, endSin ), color, out_lineVertexes );
+				AppendLine( firstPos + Vector3( startCos, 0.f, startSin ), firstPos + Vector3( endCos, 0.f, endSin ), color, out_lineVertexes );
+				AppendLine( firstPos + Vector3( startCos, startSin, 0.f ), firstPos + Vector3( endCos, endSin, 0.f ), color, out_lineVertexes );
+			}
+			break;
 		}
-		else ++commandIter;
 	}
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void UpdateDebugCommands( float deltaSeconds )
+void RenderCommandPool::DrawLineBatches( bool isDepthTested )
 {
-	auto commandIterEnd = g_theRenderCommands->end();
-	for ( auto commandIter = g_theRenderCommands->begin(); commandIter != commandIterEnd; ++commandIter )
+	g_theRenderer->EnableDepthTesting( isDepthTested );
+	g_theRenderer->UnbindTexture();
+
+	for ( LineBatch& lineBatch : m_lineBatches )
 	{
-		RenderCommand* currentCommand = *commandIter;
-		currentCommand->Update( deltaSeconds );
+		if ( ( lineBatch.m_isDepthTested != isDepthTested ) || lineBatch.m_vertexes.empty() )
+			continue;
+
+		g_theRenderer->SetLineWidth( lineBatch.m_lineThickness );
+		g_theRenderer->DrawVertexArray_PCT( TheRenderer::VertexGroupingRule::AS_LINES, lineBatch.m_vertexes, lineBatch.m_vertexes.size() );
 	}
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void ClearDebugCommands() //Else program could shutdown before all commands expire.
+void RenderCommandPool::RenderAndExpire() //Handles the depth modes.
 {
-	auto commandIterEnd = g_theRenderCommands->end();
-	for ( auto commandIter = g_theRenderCommands->begin(); commandIter != commandIterEnd; )
+	//Drop batches no command used last frame, so one-off thicknesses don't pile up.
+	for ( unsigned int batchIndex = 0; batchIndex < m_lineBatches.size(); )
 	{
-		RenderCommand* currentCommand = *commandIter;
-
-		if ( currentCommand != nullptr ) //Expire after draw or 1-frame commands wouldn't show.
+		if ( m_lineBatches[ batchIndex ].m_vertexes.empty() )
+		{
+			m_lineBatches[ batchIndex ] = m_lineBatches.back();
+			m_lineBatches.pop_back();
+		}
+		else
 		{
-			commandIter = g_theRenderCommands->erase( commandIter );
+			m_lineBatches[ batchIndex ].m_vertexes.clear();
+			++batchIndex;
+		}
+	}
 
-			delete currentCommand;
-			currentCommand = nullptr;
+	for ( int commandIndex = 0; commandIndex < GetNumCommands(); commandIndex++ )
+	{
+		const Rgba& color = m_colors[ commandIndex ];
+		float lineThickness = m_lineThicknesses[ commandIndex ];
+
+		switch ( m_depthModes[ commandIndex ] )
+		{
+		case DEPTH_TEST_ON:
+			AppendCommandLines( commandIndex, color, GetOrCreateLineBatch( true, lineThickness ) );
+			break;
+		case DEPTH_TEST_OFF:
+			AppendCommandLines( commandIndex, color, GetOrCreateLineBatch( false, lineThickness ) );
+			break;
+		case DEPTH_TEST_DUAL:
+		{
+			Rgba fainterColor = color;
+			fainterColor.alphaOpacity >>= 2;
+			AppendCommandLines( commandIndex, fainterColor, GetOrCreateLineBatch( false, lineThickness * .3f ) );
+			AppendCommandLines( commandIndex, color, GetOrCreateLineBatch( true, lineThickness ) );
+			break;
+		}
 		}
-		else ++commandIter;
 	}
+
+	//Undepth-tested first, as the dual mode's fainter pass came first when commands drew one at a time.
+	DrawLineBatches( false );
+	DrawLineBatches( true );
+
+	for ( int commandIndex = 0; commandIndex < GetNumCommands(); )
+	{
+		if ( m_secondsToLive[ commandIndex ] <= 0.f )
+			RemoveCommandBySwap( commandIndex ); //Don't advance, the last command was swapped into this slot.
+		else
+			++commandIndex;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void RenderCommandPool::Clear()
+{
+	m_types.clear();
+	m_firstPositions.clear();
+	m_secondPositions.clear();
+	m_colors.clear();
+	m_secondsToLive.clear();
+	m_depthModes.clear();
+	m_lineThicknesses.clear();
+	m_lineBatches.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void RenderAndExpireDebugCommands()
+{
+	g_theRenderCommands->RenderAndExpire();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void UpdateDebugCommands( float deltaSeconds )
+{
+	g_theRenderCommands->Update( deltaSeconds );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void ClearDebugCommands() //Else program could shutdown before all commands expire.
+{
+	g_theRenderCommands->Clear();
 }
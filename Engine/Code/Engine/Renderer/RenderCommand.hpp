@@ -2,21 +2,22 @@
 
 
 #include "Engine/Renderer/Rgba.hpp"
+#include "Engine/Renderer/Vertexes.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/Vector3.hpp"
-#include <list>
+#include <vector>
 
 
 //-----------------------------------------------------------------------------
-struct RenderCommand;
-extern std::list< RenderCommand* >* g_theRenderCommands; //Because deleted from at random frequently (expirations).
+class RenderCommandPool;
+extern RenderCommandPool* g_theRenderCommands;
 void RenderAndExpireDebugCommands();
 void UpdateDebugCommands( float deltaSeconds );
 void ClearDebugCommands();
 
 
 //-----------------------------------------------------------------------------
-enum DepthMode { 
+enum DepthMode {
 	DEPTH_TEST_ON,
 	DEPTH_TEST_OFF,
 	DEPTH_TEST_DUAL, //Drawn once on (brighter/bigger), once off (fainter/smaller).
@@ -25,114 +26,61 @@ enum DepthMode {
 
 
 //-----------------------------------------------------------------------------
-struct RenderCommand
-{
-	Rgba m_color;
-	float m_secondsToLive;
-	DepthMode m_depthMode;
-	float m_lineThickness;
-
-	RenderCommand( float secondsToLive = 0.f, 
-				   DepthMode depthMode = DEPTH_TEST_ON, 
-				   const Rgba& color = Rgba::WHITE,
-				   float lineThickness = 1.f )
-		: m_color( color )
-		, m_secondsToLive( secondsToLive )
-		, m_depthMode( depthMode ) 
-		, m_lineThickness( lineThickness )
-	{
-	}
-
-	bool IsExpired() { return m_secondsToLive <= 0.f; }
-	void Update( float deltaSeconds ) { m_secondsToLive -= deltaSeconds; }
-	void UpdateRenderMode();
-	void virtual Render() = 0;
-};
-
-//-----------------------------------------------------------------------------
-struct RenderCommandPoint : public RenderCommand
-{
-	Vector3 m_position;
-
-	RenderCommandPoint( const Vector3& position, 
-						float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
-		: RenderCommand( secondsToLive, depthMode, color, lineThickness )
-		, m_position( position ) 
-	{
-	}
-
-	void Render() override;
+enum RenderCommandType {
+	RENDER_COMMAND_POINT,
+	RENDER_COMMAND_LINE,
+	RENDER_COMMAND_ARROW,
+	RENDER_COMMAND_AABB3,
+	RENDER_COMMAND_SPHERE,
+	NUM_RENDER_COMMAND_TYPES
 };
 
 
 //-----------------------------------------------------------------------------
-struct RenderCommandLine : public RenderCommand
+//Debug commands kept as parallel arrays rather than a list of heap-allocated objects, removed by swapping in the last one.
+//Every command is turned into lines each frame, gathered into one batch per depth test setting and thickness,
+//so a frame's worth of debug drawing costs one draw per batch instead of one or more per command.
+class RenderCommandPool
 {
-	Vector3 m_startPos;
-	Vector3 m_endPos;
-
-	RenderCommandLine( const Vector3& startPos,
-					   const Vector3& endPos,
-					   float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
-		: RenderCommand( secondsToLive, depthMode, color, lineThickness )
-		, m_startPos( startPos )
-		, m_endPos( endPos ) 
-	{
-	}
+public:
 
-	void Render() override;
-};
+	void AddPoint( const Vector3& position, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness );
+	void AddLine( const Vector3& startPos, const Vector3& endPos, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness );
+	void AddArrow( const Vector3& startPos, const Vector3& endPos, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness );
+	void AddAABB3( const AABB3& bounds, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness ); //Wireframe.
+	void AddSphere( const Vector3& centerPos, float radius, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness );
 
+	void Update( float deltaSeconds );
+	void RenderAndExpire(); //Expires after drawing, else 1-frame commands wouldn't show.
+	void Clear();
 
-//-----------------------------------------------------------------------------
-struct RenderCommandArrow : public RenderCommand
-{
-	Vector3 m_startPos;
-	Vector3 m_endPos;
-
-	RenderCommandArrow( const Vector3& startPos,
-						const Vector3& endPos,
-						float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
-		: RenderCommand( secondsToLive, depthMode, color, lineThickness )
-		, m_startPos( startPos )
-		, m_endPos( endPos ) 
-	{
-	}
+	inline int GetNumCommands() const { return (int)m_types.size(); }
 
-	void Render() override;
-};
 
+private:
 
-//-----------------------------------------------------------------------------
-struct RenderCommandAABB3 : public RenderCommand
-{
-	AABB3 m_bounds;
-
-	RenderCommandAABB3( const AABB3& bounds,
-						float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
-		: RenderCommand( secondsToLive, depthMode, color, lineThickness )
-		, m_bounds( bounds ) 
+	struct LineBatch
 	{
-	}
-
-	void Render() override;
-};
-
-
-//-----------------------------------------------------------------------------
-struct RenderCommandSphere : public RenderCommand
-{
-	Vector3 m_centerPos;
-	float m_radius;
-
-	RenderCommandSphere( const Vector3& centerPos,
-						 float radius,
-						 float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness )
-		: RenderCommand( secondsToLive, depthMode, color, lineThickness )
-		, m_centerPos( centerPos )
-		, m_radius( radius )
-	{
-	}
-
-	void Render() override;
+		bool m_isDepthTested;
+		float m_lineThickness;
+		std::vector< Vertex3D_PCT > m_vertexes; //Kept across frames so its capacity is reused.
+	};
+
+	void AddCommand( RenderCommandType type, const Vector3& firstPos, const Vector3& secondPos, float secondsToLive, DepthMode depthMode, const Rgba& color, float lineThickness );
+	void RemoveCommandBySwap( int commandIndex );
+	std::vector< Vertex3D_PCT >& GetOrCreateLineBatch( bool isDepthTested, float lineThickness );
+	void AppendCommandLines( int commandIndex, const Rgba& color, std::vector< Vertex3D_PCT >& out_lineVertexes ) const;
+	void DrawLineBatches( bool isDepthTested );
+
+	//Parallel arrays, one entry per command. What the two positions mean depends on the type:
+	//point (position, unused), line and arrow (start, end), AABB3 (mins, maxs), sphere (center, radius in x).
+	std::vector< RenderCommandType > m_types;
+	std::vector< Vector3 > m_firstPositions;
+	std::vector< Vector3 > m_secondPositions;
+	std::vector< Rgba > m_colors;
+	std::vector< float > m_secondsToLive;
+	std::vector< DepthMode > m_depthModes;
+	std::vector< float > m_lineThicknesses;
+
+	std::vector< LineBatch > m_lineBatches;
 };
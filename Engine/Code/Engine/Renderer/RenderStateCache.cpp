@@ -0,0 +1,142 @@
+#include "Engine/Renderer/RenderStateCache.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+void RenderStateCache::Invalidate()
+{
+	for ( int capabilityIndex = 0; capabilityIndex < NUM_CAPABILITIES; capabilityIndex++ )
+		m_capabilities[ capabilityIndex ] = UNKNOWN_STATE;
+	for ( int clientArrayIndex = 0; clientArrayIndex < NUM_CLIENT_ARRAYS; clientArrayIndex++ )
+		m_clientArrays[ clientArrayIndex ] = UNKNOWN_STATE;
+	m_depthMask = UNKNOWN_STATE;
+
+	m_isBlendFuncKnown = false;
+	m_isAlphaFuncKnown = false;
+	m_isLineWidthKnown = false;
+	m_isPointSizeKnown = false;
+	m_isArrayBufferKnown = false;
+	m_isTextureKnown = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void RenderStateCache::InvalidateTextureState()
+{
+	m_capabilities[ CAP_TEXTURE_2D ] = UNKNOWN_STATE;
+	m_isTextureKnown = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void RenderStateCache::OnArrayBufferDeleted( unsigned int vboID )
+{
+	if ( m_isArrayBufferKnown && ( m_boundArrayBuffer == vboID ) )
+		m_boundArrayBuffer = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetFlag( int& inout_cachedFlag, bool enabled )
+{
+	int newFlag = enabled ? 1 : 0;
+	if ( !CountCall( inout_cachedFlag == newFlag ) )
+		return false;
+
+	inout_cachedFlag = newFlag;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetCapability( Capability capability, bool enabled )
+{
+	return ShouldSetFlag( m_capabilities[ capability ], enabled );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetClientArray( ClientArray clientArray, bool enabled )
+{
+	return ShouldSetFlag( m_clientArrays[ clientArray ], enabled );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetDepthMask( bool enabled )
+{
+	return ShouldSetFlag( m_depthMask, enabled );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetBlendFunc( int sourceBlend, int destinationBlend )
+{
+	if ( !CountCall( m_isBlendFuncKnown && ( m_blendSource == sourceBlend ) && ( m_blendDestination == destinationBlend ) ) )
+		return false;
+
+	m_isBlendFuncKnown = true;
+	m_blendSource = sourceBlend;
+	m_blendDestination = destinationBlend;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetAlphaFunc( int alphaComparatorFunction, float alphaComparatorValue )
+{
+	if ( !CountCall( m_isAlphaFuncKnown && ( m_alphaComparatorFunction == alphaComparatorFunction ) && ( m_alphaComparatorValue == alphaComparatorValue ) ) )
+		return false;
+
+	m_isAlphaFuncKnown = true;
+	m_alphaComparatorFunction = alphaComparatorFunction;
+	m_alphaComparatorValue = alphaComparatorValue;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetLineWidth( float lineWidth )
+{
+	if ( !CountCall( m_isLineWidthKnown && ( m_lineWidth == lineWidth ) ) )
+		return false;
+
+	m_isLineWidthKnown = true;
+	m_lineWidth = lineWidth;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldSetPointSize( float pointSize )
+{
+	if ( !CountCall( m_isPointSizeKnown && ( m_pointSize == pointSize ) ) )
+		return false;
+
+	m_isPointSizeKnown = true;
+	m_pointSize = pointSize;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldBindArrayBuffer( unsigned int vboID )
+{
+	if ( !CountCall( m_isArrayBufferKnown && ( m_boundArrayBuffer == vboID ) ) )
+		return false;
+
+	m_isArrayBufferKnown = true;
+	m_boundArrayBuffer = vboID;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool RenderStateCache::ShouldBindTexture( unsigned int textureID )
+{
+	if ( !CountCall( m_isTextureKnown && ( m_boundTexture == textureID ) ) )
+		return false;
+
+	m_isTextureKnown = true;
+	m_boundTexture = textureID;
+	return true;
+}
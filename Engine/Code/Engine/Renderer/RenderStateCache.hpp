@@ -0,0 +1,67 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Bookkeeping only: shadows the GL state TheRenderer last set, so it can skip calls that wouldn't change anything.
+//Each Should* returns true if the call must still be made (and records the new value), else counts it as skipped.
+//Starts out, and returns to on Invalidate(), not knowing any state, so the first set of each always goes through.
+class RenderStateCache
+{
+public:
+
+	enum Capability { CAP_DEPTH_TEST, CAP_CULL_FACE, CAP_ALPHA_TEST, CAP_BLEND, CAP_TEXTURE_2D, CAP_LINE_SMOOTH, NUM_CAPABILITIES };
+	enum ClientArray { CLIENT_VERTEX_ARRAY, CLIENT_COLOR_ARRAY, CLIENT_TEXTURE_COORD_ARRAY, NUM_CLIENT_ARRAYS };
+
+	RenderStateCache() { Invalidate(); ResetCallCounts(); }
+
+	void Invalidate();
+	void InvalidateTextureState(); //For code that binds textures behind TheRenderer's back, e.g. Texture's ctor.
+	void OnArrayBufferDeleted( unsigned int vboID ); //GL falls back to buffer 0 if the deleted one was bound.
+
+	bool ShouldSetCapability( Capability capability, bool enabled );
+	bool ShouldSetClientArray( ClientArray clientArray, bool enabled );
+	bool ShouldSetDepthMask( bool enabled );
+	bool ShouldSetBlendFunc( int sourceBlend, int destinationBlend );
+	bool ShouldSetAlphaFunc( int alphaComparatorFunction, float alphaComparatorValue );
+	bool ShouldSetLineWidth( float lineWidth );
+	bool ShouldSetPointSize( float pointSize );
+	bool ShouldBindArrayBuffer( unsigned int vboID );
+	bool ShouldBindTexture( unsigned int textureID );
+
+	inline unsigned int GetNumCallsIssued() const { return m_numCallsIssued; }
+	inline unsigned int GetNumCallsSkipped() const { return m_numCallsSkipped; }
+	inline void ResetCallCounts() { m_numCallsIssued = 0; m_numCallsSkipped = 0; }
+
+
+private:
+
+	static const int UNKNOWN_STATE = -1; //For the tri-state flags below.
+
+	bool ShouldSetFlag( int& inout_cachedFlag, bool enabled );
+	inline bool CountCall( bool isRedundant ) { if ( isRedundant ) ++m_numCallsSkipped; else ++m_numCallsIssued; return !isRedundant; }
+
+	int m_capabilities[ NUM_CAPABILITIES ];
+	int m_clientArrays[ NUM_CLIENT_ARRAYS ];
+	int m_depthMask;
+
+	bool m_isBlendFuncKnown;
+	int m_blendSource;
+	int m_blendDestination;
+
+	bool m_isAlphaFuncKnown;
+	int m_alphaComparatorFunction;
+	float m_alphaComparatorValue;
+
+	bool m_isLineWidthKnown;
+	float m_lineWidth;
+	bool m_isPointSizeKnown;
+	float m_pointSize;
+
+	bool m_isArrayBufferKnown;
+	unsigned int m_boundArrayBuffer;
+	bool m_isTextureKnown;
+	unsigned int m_boundTexture;
+
+	unsigned int m_numCallsIssued;
+	unsigned int m_numCallsSkipped;
+};
@@ -15,6 +15,16 @@ SpriteSheet::SpriteSheet( const std::string& imageFilePath, int tilesWide, int t
 }
 
 
+//--------------------------------------------------------------------------------------------------------------
+SpriteSheet::SpriteSheet( int tilesWide, int tilesHigh, int tileWidth, int tileHeight )
+	: m_spriteSheetTexture( nullptr )
+	, m_spriteLayout( tilesWide, tilesHigh )
+	, m_tileSize( tileWidth, tileHeight )
+	, m_texelsPerSprite( 1.f / (float) tilesWide, 1.f / (float) tilesHigh )
+{
+}
+
+
 //--------------------------------------------------------------------------------------------------------------
 AABB2 SpriteSheet::GetTexCoordsFromSpriteCoords( int spriteX, int spriteY ) const
 {
@@ -17,6 +17,7 @@ class SpriteSheet
 {
 public:
 	SpriteSheet( const std::string& imageFilePath, int tilesWide, int tilesHigh, int tileWidth, int tileHeight );
+	SpriteSheet( int tilesWide, int tilesHigh, int tileWidth, int tileHeight ); //Layout only, no texture, e.g. for headless tools that just need tex coords.
 
 	AABB2 GetTexCoordsFromSpriteCoords( int spriteX, int spriteY ) const; // mostly for atlases
 	AABB2 GetTexCoordsFromSpriteIndex( int spriteIndex ) const; // mostly for sprite animations, ensure 0-based index
@@ -2,6 +2,7 @@
 // Based on code written by Squirrel Eiserloh
 //
 #include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/TheRenderer.hpp"
 
 
 #define WIN32_LEAN_AND_MEAN
@@ -69,6 +70,8 @@ Texture::Texture( const std::string& imageFilePath )
 	stbi_image_free( imageData );
 
 	glDisable( GL_TEXTURE_2D );
+	if ( g_theRenderer != nullptr )
+		g_theRenderer->InvalidateTextureState(); //Since we just bound and disabled texturing behind its back.
 }
 
 
@@ -117,6 +120,8 @@ Texture::Texture( const unsigned char* imageData, const IntVector2& textureSize,
 				  imageData );		// Location of the actual pixel data bytes/buffer
 
 	glDisable( GL_TEXTURE_2D );
+	if ( g_theRenderer != nullptr )
+		g_theRenderer->InvalidateTextureState(); //Since we just bound and disabled texturing behind its back.
 }
 
 
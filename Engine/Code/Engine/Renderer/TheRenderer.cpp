@@ -15,6 +15,7 @@
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/AABB3.hpp"
+#include "Engine/Renderer/RenderStateCache.hpp"
 
 
 //--------------------------------------------------------------------------------------------------------------
@@ -46,7 +47,9 @@ unsigned int TheRenderer::GetOpenGLVertexGroupingRule(unsigned int TheRendererVe
 
 //--------------------------------------------------------------------------------------------------------------
 TheRenderer::TheRenderer()
-	:m_defaultFont( BitmapFont::CreateOrGetFont( "Data/Fonts/SquirrelFixedFont.png" ) )
+	: m_defaultFont( BitmapFont::CreateOrGetFont( "Data/Fonts/SquirrelFixedFont.png" ) )
+	, m_isBatchingText( false )
+	, m_textBatchCount( 0 )
 {
 	DebuggerPrintf( "OpenGL Vendor is: %s\n", glGetString( GL_VENDOR ) );
 	DebuggerPrintf( "OpenGL Version is: %s\n", glGetString( GL_VERSION ) );
@@ -55,11 +58,13 @@ TheRenderer::TheRenderer()
 	glBindBuffer = (PFNGLBINDBUFFERPROC)wglGetProcAddress( "glBindBuffer" );
 	glBufferData = (PFNGLBUFFERDATAPROC)wglGetProcAddress( "glBufferData" );
 	glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)wglGetProcAddress( "glDeleteBuffers" );
+	glBufferSubData = (PFNGLBUFFERSUBDATAPROC)wglGetProcAddress( "glBufferSubData" );
+	glMultiDrawArrays = (PFNGLMULTIDRAWARRAYSPROC)wglGetProcAddress( "glMultiDrawArrays" );
 
-	glEnable( GL_BLEND );
-	glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
-	glEnable( GL_LINE_SMOOTH );
-	glLineWidth( 1.5f );
+	SetCapability( RenderStateCache::CAP_BLEND, GL_BLEND, true );
+	SetBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+	SetCapability( RenderStateCache::CAP_LINE_SMOOTH, GL_LINE_SMOOTH, true );
+	SetLineWidth( 1.5f );
 
 	CreateBuiltInTextures();
 }
@@ -69,6 +74,9 @@ TheRenderer::TheRenderer()
 TheRenderer::~TheRenderer()
 {
 	delete m_defaultFont;
+
+	for ( unsigned int arenaPageVboID : m_arenaPageVboIDs )
+		glDeleteBuffers( 1, &arenaPageVboID );
 }
 
 
@@ -106,30 +114,100 @@ void TheRenderer::ClearScreenDepthBuffer()
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::EnableDepthTesting( bool flagValue )
 {
-	if ( flagValue ) glEnable( GL_DEPTH_TEST );
-	else glDisable( GL_DEPTH_TEST );
+	SetCapability( RenderStateCache::CAP_DEPTH_TEST, GL_DEPTH_TEST, flagValue );
 }
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::EnableAlphaTesting( bool flagValue )
 {
-	if ( flagValue ) glEnable( GL_ALPHA_TEST );
-	else glDisable( GL_ALPHA_TEST );
+	SetCapability( RenderStateCache::CAP_ALPHA_TEST, GL_ALPHA_TEST, flagValue );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::SetAlphaFunc( int alphaComparatorFunction, float alphaComparatorValue )
 {
-	glAlphaFunc( alphaComparatorFunction, alphaComparatorValue );
+	if ( m_renderStateCache.ShouldSetAlphaFunc( alphaComparatorFunction, alphaComparatorValue ) )
+		glAlphaFunc( alphaComparatorFunction, alphaComparatorValue );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::EnableBackfaceCulling( bool flagValue )
 {
-	if ( flagValue ) glEnable( GL_CULL_FACE );
-	else glDisable( GL_CULL_FACE );
+	SetCapability( RenderStateCache::CAP_CULL_FACE, GL_CULL_FACE, flagValue );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::EnableDepthWriting( bool flagValue )
+{
+	if ( m_renderStateCache.ShouldSetDepthMask( flagValue ) )
+		glDepthMask( flagValue ? GL_TRUE : GL_FALSE );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::SetCapability( RenderStateCache::Capability capability, unsigned int glCapability, bool flagValue )
+{
+	if ( !m_renderStateCache.ShouldSetCapability( capability, flagValue ) )
+		return;
+
+	if ( flagValue ) glEnable( glCapability );
+	else glDisable( glCapability );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::BindArrayBuffer( unsigned int vboID )
+{
+	if ( m_renderStateCache.ShouldBindArrayBuffer( vboID ) )
+		glBindBuffer( GL_ARRAY_BUFFER, vboID );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Every draw path here feeds all three from Vertex3D_PCT, so they're left on between draws rather than toggled around each.
+void TheRenderer::EnablePCTClientArrays()
+{
+	if ( m_renderStateCache.ShouldSetClientArray( RenderStateCache::CLIENT_VERTEX_ARRAY, true ) )
+		glEnableClientState( GL_VERTEX_ARRAY );
+	if ( m_renderStateCache.ShouldSetClientArray( RenderStateCache::CLIENT_COLOR_ARRAY, true ) )
+		glEnableClientState( GL_COLOR_ARRAY );
+	if ( m_renderStateCache.ShouldSetClientArray( RenderStateCache::CLIENT_TEXTURE_COORD_ARRAY, true ) )
+		glEnableClientState( GL_TEXTURE_COORD_ARRAY );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::InvalidateRenderStateCache()
+{
+	m_renderStateCache.Invalidate();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::InvalidateTextureState()
+{
+	m_renderStateCache.InvalidateTextureState();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+RenderFrameStats TheRenderer::GetFrameStats() const
+{
+	RenderFrameStats frameStats = m_frameStats;
+	frameStats.m_numStateChanges = m_renderStateCache.GetNumCallsIssued();
+	frameStats.m_numStateChangesSkipped = m_renderStateCache.GetNumCallsSkipped();
+	return frameStats;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::ResetFrameStats()
+{
+	m_frameStats = RenderFrameStats();
+	m_renderStateCache.ResetCallCounts();
 }
 
 
@@ -137,31 +215,33 @@ void TheRenderer::EnableBackfaceCulling( bool flagValue )
 void TheRenderer::CreateVbo( unsigned int& out_vboID )
 {
 	glGenBuffers( 1, &out_vboID );
+	++m_frameStats.m_numBuffersCreated;
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::UpdateVbo( unsigned int vboID, const Vertex3D_PCT* vertexArrayData, unsigned int vertexArraySizeInBytes )
 {
-	glBindBuffer( GL_ARRAY_BUFFER, vboID );
+	BindArrayBuffer( vboID );
 
 	glBufferData( GL_ARRAY_BUFFER, vertexArraySizeInBytes, vertexArrayData, GL_STATIC_DRAW );
-
-	glBindBuffer( GL_ARRAY_BUFFER, 0 );
+	m_frameStats.m_numVboBytesUploaded += vertexArraySizeInBytes;
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::BindVbo( unsigned int vboID )
 {
-	glBindBuffer( GL_ARRAY_BUFFER, vboID );
+	BindArrayBuffer( vboID );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::DestroyVbo( unsigned int vboID )
 {
+	m_renderStateCache.OnArrayBufferDeleted( vboID );
 	glDeleteBuffers( 1, &vboID );
+	++m_frameStats.m_numBuffersDestroyed;
 }
 
 
@@ -170,23 +250,116 @@ void TheRenderer::DrawVbo_PCT( unsigned int vboID, int numVerts, VertexGroupingR
 {
 	if ( numVerts == 0 ) return;
 
-	glBindBuffer( GL_ARRAY_BUFFER, vboID );
-
-	glEnableClientState( GL_VERTEX_ARRAY );
-	glEnableClientState( GL_COLOR_ARRAY );
-	glEnableClientState( GL_TEXTURE_COORD_ARRAY );
+	BindArrayBuffer( vboID );
+	EnablePCTClientArrays();
 
 	glVertexPointer( 3, GL_FLOAT, sizeof( Vertex3D_PCT ), (const GLvoid*)offsetof( Vertex3D_PCT, m_position ) );
 	glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( Vertex3D_PCT ), (const GLvoid*)offsetof( Vertex3D_PCT, m_color ) );
 	glTexCoordPointer( 2, GL_FLOAT, sizeof( Vertex3D_PCT ), (const GLvoid*)offsetof( Vertex3D_PCT, m_texCoords ) );
 
 	glDrawArrays( GetOpenGLVertexGroupingRule( vertexGroupingRule ), 0, numVerts );
+	++m_frameStats.m_numDrawCalls;
+	m_frameStats.m_numVertexesSubmitted += numVerts;
+
+	UnbindTexture();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::UpdateArenaVertexes( VertexArenaAllocation& inout_allocation, const Vertex3D_PCT* vertexArrayData, unsigned int numVertexes )
+{
+	if ( inout_allocation.IsValid() && ( numVertexes > inout_allocation.m_numVertexesReserved ) )
+		m_vertexArena.Free( inout_allocation );
+
+	if ( numVertexes == 0 )
+		return; //Keeps any allocation it already had, for when it next has faces again.
+
+	if ( !inout_allocation.IsValid() )
+		inout_allocation = m_vertexArena.Allocate( numVertexes );
+
+	//A new page was carved out, so back it with a buffer before writing into it.
+	while ( m_arenaPageVboIDs.size() < (size_t)m_vertexArena.GetNumPages() )
+	{
+		unsigned int pageVboID;
+		glGenBuffers( 1, &pageVboID );
+		++m_frameStats.m_numBuffersCreated;
+		BindArrayBuffer( pageVboID );
+		glBufferData( GL_ARRAY_BUFFER, m_vertexArena.GetPageCapacity( m_arenaPageVboIDs.size() ) * sizeof( Vertex3D_PCT ), nullptr, GL_DYNAMIC_DRAW );
+		m_arenaPageVboIDs.push_back( pageVboID );
+	}
+
+	BindArrayBuffer( m_arenaPageVboIDs[ inout_allocation.m_pageIndex ] );
+	glBufferSubData( GL_ARRAY_BUFFER, inout_allocation.m_firstVertex * sizeof( Vertex3D_PCT ), numVertexes * sizeof( Vertex3D_PCT ), vertexArrayData );
+	m_frameStats.m_numVboBytesUploaded += numVertexes * sizeof( Vertex3D_PCT );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::FreeArenaVertexes( VertexArenaAllocation& allocation )
+{
+	m_vertexArena.Free( allocation );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::QueueArenaDraw( const VertexArenaAllocation& allocation, unsigned int numVertexes )
+{
+	if ( !allocation.IsValid() || ( numVertexes == 0 ) )
+		return;
+
+	QueuedArenaDraw queuedDraw;
+	queuedDraw.m_pageIndex = allocation.m_pageIndex;
+	queuedDraw.m_firstVertex = (int)allocation.m_firstVertex;
+	queuedDraw.m_numVertexes = (int)numVertexes;
+	m_queuedArenaDraws.push_back( queuedDraw );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Default: one glMultiDrawArrays per arena page, keeping queue order only within each page. Fine for opaque geometry.
+//Preserving queue order instead issues one per consecutive run on the same page, as blending needs for translucent geometry.
+void TheRenderer::DrawQueuedArenaVertexes( VertexGroupingRule vertexGroupingRule, bool preserveQueueOrder /*= false*/ )
+{
+	EnablePCTClientArrays();
+
+	unsigned int runStartIndex = 0;
+	while ( runStartIndex < m_queuedArenaDraws.size() )
+	{
+		int pageIndex = m_queuedArenaDraws[ runStartIndex ].m_pageIndex;
+		unsigned int runEndIndex = runStartIndex;
+		while ( ( runEndIndex < m_queuedArenaDraws.size() ) && ( m_queuedArenaDraws[ runEndIndex ].m_pageIndex == pageIndex ) )
+			++runEndIndex;
+
+		//When not preserving order, sweep the rest of the queue for this page too, and mark those taken.
+		unsigned int gatherEndIndex = preserveQueueOrder ? runEndIndex : m_queuedArenaDraws.size();
+		m_multiDrawFirsts.clear();
+		m_multiDrawCounts.clear();
+		for ( unsigned int drawIndex = runStartIndex; drawIndex < gatherEndIndex; drawIndex++ )
+		{
+			QueuedArenaDraw& queuedDraw = m_queuedArenaDraws[ drawIndex ];
+			if ( queuedDraw.m_pageIndex != pageIndex )
+				continue;
+
+			m_multiDrawFirsts.push_back( queuedDraw.m_firstVertex );
+			m_multiDrawCounts.push_back( queuedDraw.m_numVertexes );
+			m_frameStats.m_numVertexesSubmitted += queuedDraw.m_numVertexes;
+			queuedDraw.m_pageIndex = -1;
+		}
+
+		//Pointers are offsets into the bound buffer, so they're only re-specified once per multi-draw rather than per mesh.
+		BindArrayBuffer( m_arenaPageVboIDs[ pageIndex ] );
+		glVertexPointer( 3, GL_FLOAT, sizeof( Vertex3D_PCT ), (const GLvoid*)offsetof( Vertex3D_PCT, m_position ) );
+		glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof( Vertex3D_PCT ), (const GLvoid*)offsetof( Vertex3D_PCT, m_color ) );
+		glTexCoordPointer( 2, GL_FLOAT, sizeof( Vertex3D_PCT ), (const GLvoid*)offsetof( Vertex3D_PCT, m_texCoords ) );
 
-	glDisableClientState( GL_VERTEX_ARRAY );
-	glDisableClientState( GL_COLOR_ARRAY );
-	glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+		glMultiDrawArrays( GetOpenGLVertexGroupingRule( vertexGroupingRule ), m_multiDrawFirsts.data(), m_multiDrawCounts.data(), (GLsizei)m_multiDrawFirsts.size() );
+		++m_frameStats.m_numDrawCalls;
 
-	glBindBuffer( GL_ARRAY_BUFFER, 0 );
+		runStartIndex = runEndIndex;
+		while ( ( runStartIndex < m_queuedArenaDraws.size() ) && ( m_queuedArenaDraws[ runStartIndex ].m_pageIndex == -1 ) )
+			++runStartIndex; //Skip entries an earlier page's sweep already drew.
+	}
+	m_queuedArenaDraws.clear();
 
 	UnbindTexture();
 }
@@ -202,28 +375,40 @@ void TheRenderer::SetDrawColor( float red, float green, float blue, float opacit
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::SetLineWidth( float newLineWidth )
 {
-	glLineWidth( newLineWidth );
+	if ( m_renderStateCache.ShouldSetLineWidth( newLineWidth ) )
+		glLineWidth( newLineWidth );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::SetBlendFunc( int sourceBlend, int destinationBlend )
 {
-	glBlendFunc( sourceBlend, destinationBlend );
+	if ( m_renderStateCache.ShouldSetBlendFunc( sourceBlend, destinationBlend ) )
+		glBlendFunc( sourceBlend, destinationBlend );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::SetRenderFlag( int flagNameToSet )
 {
-	glEnable( flagNameToSet );
+	switch ( flagNameToSet ) //Route what the cache shadows through it, so it doesn't go stale.
+	{
+		case GL_DEPTH_TEST: SetCapability( RenderStateCache::CAP_DEPTH_TEST, GL_DEPTH_TEST, true ); break;
+		case GL_CULL_FACE: SetCapability( RenderStateCache::CAP_CULL_FACE, GL_CULL_FACE, true ); break;
+		case GL_ALPHA_TEST: SetCapability( RenderStateCache::CAP_ALPHA_TEST, GL_ALPHA_TEST, true ); break;
+		case GL_BLEND: SetCapability( RenderStateCache::CAP_BLEND, GL_BLEND, true ); break;
+		case GL_TEXTURE_2D: SetCapability( RenderStateCache::CAP_TEXTURE_2D, GL_TEXTURE_2D, true ); break;
+		case GL_LINE_SMOOTH: SetCapability( RenderStateCache::CAP_LINE_SMOOTH, GL_LINE_SMOOTH, true ); break;
+		default: glEnable( flagNameToSet ); break;
+	}
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::SetPointSize( float thickness )
 {
-	glPointSize( thickness );
+	if ( m_renderStateCache.ShouldSetPointSize( thickness ) )
+		glPointSize( thickness );
 }
 
 
@@ -297,7 +482,7 @@ void TheRenderer::PopView()
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::DrawPoint( const Vector3& position, float thickness, const Rgba& color /*= Rgba() */ )
 {
-	glPointSize( thickness );
+	SetPointSize( thickness );
 
 	UnbindTexture();
 
@@ -309,7 +494,7 @@ void TheRenderer::DrawPoint( const Vector3& position, float thickness, const Rgb
 void TheRenderer::DrawLine( const Vector2& startPos, const Vector2& endPos, 
 	const Rgba& startColor /*=Rgba()*/, const Rgba& endColor /*=Rgba()*/, float lineThickness /*= 1.f */ )
 {
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	UnbindTexture();
 
@@ -322,7 +507,7 @@ void TheRenderer::DrawLine( const Vector2& startPos, const Vector2& endPos,
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::DrawLine( const Vector3& startPos, const Vector3& endPos, const Rgba& startColor /*= Rgba()*/, const Rgba& endColor /*= Rgba()*/, float lineThickness /*= 1.f */ )
 {
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	UnbindTexture();
 
@@ -333,12 +518,11 @@ void TheRenderer::DrawLine( const Vector3& startPos, const Vector3& endPos, cons
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::DrawAABB( const int vertexGroupingRule, const AABB3& bounds, const Texture& texture, const AABB2* texCoords, const Rgba& tint /*= Rgba()*/, float lineThickness /*= 1.f*/ )
 {
-	glEnable( GL_TEXTURE_2D );
-	glBindTexture( GL_TEXTURE_2D, texture.GetTextureID() );
+	BindTexture( &texture );
 
 	glColor4ub( tint.red, tint.green, tint.blue, tint.alphaOpacity );
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	Vertex3D_PCT vertexes[24];
 
@@ -388,10 +572,9 @@ void TheRenderer::DrawAABB( const int vertexGroupingRule, const AABB3& bounds, c
 void TheRenderer::DrawAABB( const int vertexGroupingRule, const AABB2& bounds, const Texture& texture,
 	const AABB2& texCoords /*= AABB2(0,0,1,1)*/, const Rgba& tint  /*=Rgba()*/, float lineThickness /*= 1.f */ )
 {
-	glEnable( GL_TEXTURE_2D );
-	glBindTexture( GL_TEXTURE_2D, texture.GetTextureID() );
+	BindTexture( &texture );
 	
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	Vertex3D_PCT vertexes[4];
 
@@ -411,7 +594,7 @@ void TheRenderer::DrawAABB( const int vertexGroupingRule, const AABB2& bounds, c
 {
 	UnbindTexture();
 	
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 	
 	Vertex3D_PCT vertexes[ 4 ];
 
@@ -429,7 +612,7 @@ void TheRenderer::DrawAABB( const int vertexGroupingRule, const AABB3& bounds, c
 {
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 
 	Vertex3D_PCT vertexes[24];
@@ -480,7 +663,7 @@ void TheRenderer::DrawShadedAABB( const int vertexGroupingRule, const AABB2& bou
 {
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	Vertex3D_PCT vertexes[ 4 ];
 
@@ -498,7 +681,7 @@ void TheRenderer::DrawShadedAABB( const int vertexGroupingRule, const AABB3& bou
 {
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 
 	Vertex3D_PCT vertexes[ 24 ];
@@ -549,7 +732,7 @@ void TheRenderer::DrawQuad( const int vertexGroupingRule, const Vector2& topLeft
 {
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	Vertex3D_PCT vertexes[ 4 ];
 
@@ -572,7 +755,7 @@ void TheRenderer::DrawPolygon( const int vertexGroupingRule, const Vector2& cent
 
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	for ( float radians = 0.f; radians < radiansTotal; radians += radiansPerSide ) {
 		float rotatedRadians = radians + ConvertDegreesToRadians( degreesOffset );
@@ -590,28 +773,128 @@ void TheRenderer::DrawText2D( const Vector2& startBottomLeft, const std::string&
 {
 	if ( font == nullptr ) font = m_defaultFont;
 
-	Vector2 glyphBottomLeft = startBottomLeft;
-	Vector2 cellSize( cellAspect * cellHeight, cellHeight );
+	const CachedTextMesh& textMesh = GetOrBuildTextMesh( asciiText, cellHeight, tint, font, cellAspect, drawDropShadow );
+	const Texture* fontTexture = font->GetFontTexture();
 
-	for ( int stringIndex = 0; stringIndex < (int)asciiText.size( ); stringIndex++ )
+	if ( !m_isBatchingText )
 	{
-		AABB2 texCoords = font->GetTexCoordsForGlyph( asciiText[ stringIndex ] );
+		PushView();
+		TranslateView( startBottomLeft );
+		BindTexture( fontTexture );
+		DrawVertexArray_PCT( AS_QUADS, textMesh.m_vertexes, textMesh.m_vertexes.size() );
+		PopView();
+		return;
+	}
+
+	TextBatch* textBatch = nullptr;
+	for ( TextBatch& existingBatch : m_textBatches )
+		if ( existingBatch.m_fontTexture == fontTexture )
+			textBatch = &existingBatch;
+	if ( textBatch == nullptr )
+	{
+		m_textBatches.push_back( TextBatch() );
+		textBatch = &m_textBatches.back();
+		textBatch->m_fontTexture = fontTexture;
+	}
+
+	Vector3 offset( startBottomLeft.x, startBottomLeft.y, 0.f );
+	for ( const Vertex3D_PCT& vertex : textMesh.m_vertexes )
+	{
+		textBatch->m_vertexes.push_back( vertex );
+		textBatch->m_vertexes.back().m_position += offset;
+	}
+}
+
 
-		Vector2 glyphTopRight = glyphBottomLeft + cellSize;
-		AABB2 renderBounds = AABB2( glyphBottomLeft, glyphTopRight );
-		Texture* fontTexture = font->GetFontTexture();
+//--------------------------------------------------------------------------------------------------------------
+const TheRenderer::CachedTextMesh& TheRenderer::GetOrBuildTextMesh( const std::string& asciiText, float cellHeight, const Rgba& tint, const BitmapFont* font, float cellAspect, bool drawDropShadow )
+{
+	size_t key = std::hash< std::string >()( asciiText );
+	size_t fieldHashes[ 5 ] = {
+		std::hash< float >()( cellHeight ), std::hash< float >()( cellAspect ), std::hash< const void* >()( font ),
+		( (size_t)tint.red << 24 ) | ( (size_t)tint.green << 16 ) | ( (size_t)tint.blue << 8 ) | (size_t)tint.alphaOpacity,
+		drawDropShadow ? 1U : 0U
+	};
+	for ( size_t fieldHash : fieldHashes )
+		key ^= fieldHash + 0x9e3779b9 + ( key << 6 ) + ( key >> 2 );
+
+	if ( m_textMeshCache.size() >= TEXT_MESH_CACHE_MAX_ENTRIES )
+		m_textMeshCache.clear(); //Only if text is drawn without ever ending a batch to age entries out.
+
+	CachedTextMesh& textMesh = m_textMeshCache[ key ];
+	textMesh.m_lastUsedTextBatch = m_textBatchCount;
+	bool isCacheHit = !textMesh.m_vertexes.empty() && ( textMesh.m_text == asciiText ) && ( textMesh.m_cellHeight == cellHeight ) && ( textMesh.m_cellAspect == cellAspect )
+		&& ( textMesh.m_tint == tint ) && ( textMesh.m_tint.alphaOpacity == tint.alphaOpacity ) && ( textMesh.m_font == font ) && ( textMesh.m_hasDropShadow == drawDropShadow );
+	if ( isCacheHit )
+		return textMesh; //Else it's new or a hash collision, so (re)build it in place.
+
+	textMesh.m_text = asciiText;
+	textMesh.m_cellHeight = cellHeight;
+	textMesh.m_cellAspect = cellAspect;
+	textMesh.m_tint = tint;
+	textMesh.m_font = font;
+	textMesh.m_hasDropShadow = drawDropShadow;
+	textMesh.m_vertexes.clear();
+
+	Vector2 cellSize( cellAspect * cellHeight, cellHeight );
+	const Vector2 shadowOffset = Vector2( 2.f, -2.f );
 
-		if ( drawDropShadow )
+	//All shadows before any glyphs, so no glyph's shadow lands on top of its neighbor.
+	int numPasses = drawDropShadow ? 2 : 1;
+	for ( int passIndex = 0; passIndex < numPasses; passIndex++ )
+	{
+		bool isShadowPass = drawDropShadow && ( passIndex == 0 );
+		Rgba color = isShadowPass ? Rgba::BLACK : tint;
+		Vector2 glyphBottomLeft = isShadowPass ? shadowOffset : Vector2::ZERO;
+
+		for ( int stringIndex = 0; stringIndex < (int)asciiText.size(); stringIndex++ )
 		{
-			AABB2 shadowRenderBounds = renderBounds;
-			Vector2 shadowOffset = Vector2( 2.f, -2.f );
-			shadowRenderBounds.mins += shadowOffset;
-			shadowRenderBounds.maxs += shadowOffset;
-			g_theRenderer->DrawAABB( VertexGroupingRule::AS_QUADS, shadowRenderBounds, *fontTexture, texCoords, Rgba::BLACK );
+			AABB2 texCoords = font->GetTexCoordsForGlyph( asciiText[ stringIndex ] );
+			Vector2 glyphTopRight = glyphBottomLeft + cellSize;
+
+			//Same winding and texel flip as DrawAABB's textured AABB2.
+			textMesh.m_vertexes.push_back( Vertex3D_PCT( Vector3( glyphBottomLeft.x, glyphBottomLeft.y, 0.f ), Vector2( texCoords.mins.x, texCoords.maxs.y ), color ) );
+			textMesh.m_vertexes.push_back( Vertex3D_PCT( Vector3( glyphTopRight.x, glyphBottomLeft.y, 0.f ), Vector2( texCoords.maxs.x, texCoords.maxs.y ), color ) );
+			textMesh.m_vertexes.push_back( Vertex3D_PCT( Vector3( glyphTopRight.x, glyphTopRight.y, 0.f ), Vector2( texCoords.maxs.x, texCoords.mins.y ), color ) );
+			textMesh.m_vertexes.push_back( Vertex3D_PCT( Vector3( glyphBottomLeft.x, glyphTopRight.y, 0.f ), Vector2( texCoords.mins.x, texCoords.mins.y ), color ) );
+
+			glyphBottomLeft.x += cellSize.x;
 		}
-		g_theRenderer->DrawAABB( VertexGroupingRule::AS_QUADS, renderBounds, *fontTexture, texCoords, tint );
+	}
+
+	return textMesh;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::BeginTextBatch()
+{
+	ASSERT_OR_DIE( !m_isBatchingText, "BeginTextBatch Called Again Before EndTextBatch" );
+	m_isBatchingText = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void TheRenderer::EndTextBatch()
+{
+	ASSERT_OR_DIE( m_isBatchingText, "EndTextBatch Called Without BeginTextBatch" );
+	m_isBatchingText = false;
 
-		glyphBottomLeft.x += cellSize.x;
+	for ( TextBatch& textBatch : m_textBatches )
+	{
+		BindTexture( textBatch.m_fontTexture );
+		DrawVertexArray_PCT( AS_QUADS, textBatch.m_vertexes, textBatch.m_vertexes.size() );
+	}
+	m_textBatches.clear();
+
+	//Strings that change every frame, like positions, would otherwise pile up here.
+	++m_textBatchCount;
+	for ( auto cacheIter = m_textMeshCache.begin(); cacheIter != m_textMeshCache.end(); )
+	{
+		if ( ( m_textBatchCount - cacheIter->second.m_lastUsedTextBatch ) > TEXT_MESH_CACHE_MAX_UNUSED_BATCHES )
+			cacheIter = m_textMeshCache.erase( cacheIter );
+		else
+			++cacheIter;
 	}
 }
 
@@ -621,7 +904,7 @@ void TheRenderer::DrawAxes( float length, float lineThickness /*=1.f*/, float al
 {
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	DrawLine( Vector3( 0.f, 0.f, 0.f ), Vector3( length, 0.f, 0.f ), Rgba( 1.f, 0.f, 0.f, alphaOpacity ), Rgba( 1.f, 0.f, 0.f, alphaOpacity ), lineThickness );
 	DrawLine( Vector3( 0.f, 0.f, 0.f ), Vector3( 0.f, length, 0.f ), Rgba( 0.f, 1.f, 0.f, alphaOpacity ), Rgba( 0.f, 1.f, 0.f, alphaOpacity ), lineThickness );
@@ -645,19 +928,16 @@ void TheRenderer::DrawVertexArray_PCT( const int vertexGroupingRule, const std::
 {
 	if ( vertexArraySize == 0 ) return;
 
-	glEnableClientState( GL_VERTEX_ARRAY );
-	glEnableClientState( GL_COLOR_ARRAY );
-	glEnableClientState( GL_TEXTURE_COORD_ARRAY );
+	BindArrayBuffer( 0 ); //Pointers below are client memory, not offsets into a buffer.
+	EnablePCTClientArrays();
 
 	glVertexPointer( 3, GL_FLOAT, sizeof( Vertex3D_PCT ), &vertexArrayData[ 0 ].m_position );
 	glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof ( Vertex3D_PCT ), &vertexArrayData[ 0 ].m_color );
 	glTexCoordPointer( 2, GL_FLOAT, sizeof( Vertex3D_PCT ), &vertexArrayData[ 0 ].m_texCoords );
 
 	glDrawArrays( GetOpenGLVertexGroupingRule( vertexGroupingRule ), 0, vertexArraySize );
-
-	glDisableClientState( GL_VERTEX_ARRAY );
-	glDisableClientState( GL_COLOR_ARRAY );
-	glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+	++m_frameStats.m_numDrawCalls;
+	m_frameStats.m_numVertexesSubmitted += vertexArraySize;
 
 	UnbindTexture();
 }
@@ -668,19 +948,16 @@ void TheRenderer::DrawVertexArray_PCT( const int vertexGroupingRule, const Verte
 {
 	if ( vertexArraySize == 0 ) return;
 
-	glEnableClientState( GL_VERTEX_ARRAY );
-	glEnableClientState( GL_COLOR_ARRAY );
-	glEnableClientState( GL_TEXTURE_COORD_ARRAY );
+	BindArrayBuffer( 0 ); //Pointers below are client memory, not offsets into a buffer.
+	EnablePCTClientArrays();
 
 	glVertexPointer( 3, GL_FLOAT, sizeof( Vertex3D_PCT ), &vertexArrayData[ 0 ].m_position );
 	glColorPointer( 4, GL_UNSIGNED_BYTE, sizeof ( Vertex3D_PCT ), &vertexArrayData[ 0 ].m_color );
 	glTexCoordPointer( 2, GL_FLOAT, sizeof( Vertex3D_PCT ), &vertexArrayData[ 0 ].m_texCoords );
 
 	glDrawArrays( GetOpenGLVertexGroupingRule( vertexGroupingRule ), 0, vertexArraySize );
-
-	glDisableClientState( GL_VERTEX_ARRAY );
-	glDisableClientState( GL_COLOR_ARRAY );
-	glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+	++m_frameStats.m_numDrawCalls;
+	m_frameStats.m_numVertexesSubmitted += vertexArraySize;
 
 	UnbindTexture();
 }
@@ -689,13 +966,15 @@ void TheRenderer::DrawVertexArray_PCT( const int vertexGroupingRule, const Verte
 //--------------------------------------------------------------------------------------------------------------
 void TheRenderer::BindTexture( const Texture* texture )
 {
-	glEnable( GL_TEXTURE_2D );
+	SetCapability( RenderStateCache::CAP_TEXTURE_2D, GL_TEXTURE_2D, true );
 
+	//Texture's ctor binds and disables texturing behind our back, hence it invalidates this part of the cache.
 	unsigned int paramTextureID = texture->GetTextureID();
-
-	//if ( m_currentTextureID == paramTextureID ) return; //What makes this break things when uncommented out?
-	
-	glBindTexture( GL_TEXTURE_2D, paramTextureID );
+	if ( m_renderStateCache.ShouldBindTexture( paramTextureID ) )
+	{
+		glBindTexture( GL_TEXTURE_2D, paramTextureID );
+		++m_frameStats.m_numTextureBinds;
+	}
 	m_currentTextureID = paramTextureID;
 }
 
@@ -714,7 +993,7 @@ void TheRenderer::DrawSphere( const int vertexGroupingRule, const Vector3& cente
 
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	std::vector<Vertex3D_PCT> vertexes;
 	
@@ -783,7 +1062,7 @@ void TheRenderer::DrawCylinder( const int vertexGroupingRule, const Vector3& cen
 {
 	UnbindTexture();
 
-	glLineWidth( lineThickness );
+	SetLineWidth( lineThickness );
 
 	std::vector<Vertex3D_PCT> vertexes;
 	float heightStep = ceil( 1.f / numSlices );
@@ -4,8 +4,11 @@
 //For default arguments.
 #include "Engine/Renderer/Vertexes.hpp"
 #include "Engine/Math/AABB2.hpp"
+#include "Engine/Renderer/VertexArena.hpp"
+#include "Engine/Renderer/RenderStateCache.hpp"
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 
 //-----------------------------------------------------------------------------
@@ -16,6 +19,34 @@ class AABB3;
 
 //-----------------------------------------------------------------------------
 extern TheRenderer* g_theRenderer;
+static const unsigned int TEXT_MESH_CACHE_MAX_UNUSED_BATCHES = 30; //Text batches, i.e. frames, before a cached string mesh is dropped.
+static const unsigned int TEXT_MESH_CACHE_MAX_ENTRIES = 1024;
+
+
+//-----------------------------------------------------------------------------
+struct RenderFrameStats //Everything TheRenderer submitted since the last ResetFrameStats.
+{
+	RenderFrameStats()
+		: m_numDrawCalls( 0 )
+		, m_numVertexesSubmitted( 0 )
+		, m_numVboBytesUploaded( 0 )
+		, m_numBuffersCreated( 0 )
+		, m_numBuffersDestroyed( 0 )
+		, m_numTextureBinds( 0 )
+		, m_numStateChanges( 0 )
+		, m_numStateChangesSkipped( 0 )
+	{
+	}
+
+	unsigned int m_numDrawCalls; //A glMultiDrawArrays counts once.
+	unsigned int m_numVertexesSubmitted;
+	unsigned int m_numVboBytesUploaded; //Through UpdateVbo and UpdateArenaVertexes.
+	unsigned int m_numBuffersCreated;
+	unsigned int m_numBuffersDestroyed;
+	unsigned int m_numTextureBinds; //Only those not skipped as redundant.
+	unsigned int m_numStateChanges; //Ditto, includes the texture binds and buffer binds.
+	unsigned int m_numStateChangesSkipped;
+};
 
 
 //-----------------------------------------------------------------------------
@@ -36,6 +67,7 @@ public:
 
 	void EnableDepthTesting( bool flagValue );
 	void EnableBackfaceCulling( bool flagValue );
+	void EnableDepthWriting( bool flagValue );
 	void EnableAlphaTesting( bool flagValue );
 	void SetAlphaFunc( int alphaComparatorFunction, float alphaComparatorValue );
 	void SetDrawColor( float red, float green, float blue, float opacity ); 
@@ -46,6 +78,13 @@ public:
 	void BindTexture( const Texture* texture );
 	void UnbindTexture();
 
+	//Redundant state calls are skipped against a shadow of what was last set. See RenderStateCache.
+	void InvalidateRenderStateCache(); //After any GL state is changed without going through TheRenderer.
+	void InvalidateTextureState();
+
+	RenderFrameStats GetFrameStats() const;
+	void ResetFrameStats(); //Call at the start of each frame.
+
 	void SetOrtho( const Vector2& bottomLeft, const Vector2& topRight );
 	void SetPerspective( float fovDegreesY, float aspect, float nearDist, float farDist );
 	void TranslateView( const Vector2& translation );
@@ -78,6 +117,8 @@ public:
 	void DrawCylinder( const int vertexGroupingRule, const Vector3& centerPos, float radius, float height, float numSlices, float numSidesPerSlice, const Rgba& tint = Rgba(), float lineThickness = 1.0f );
 
 	void DrawText2D( const Vector2& startBottomLeft, const std::string& asciiText, float cellHeight, const Rgba& tint = Rgba( ), const BitmapFont* font = nullptr, float cellAspect = 1.f, bool drawDropShadow = true );
+	void BeginTextBatch(); //Until EndTextBatch, DrawText2D only gathers its quads, then they're drawn with one bind and draw per font.
+	void EndTextBatch();
 
 	void DrawAxes( float length, float lineThickness = 1.f, float alphaOpacity = 1.f, bool drawZ = false );
 	void DrawDebugAxes( float length = 1.f, float lineThickness = 1.f, bool drawZ = false );
@@ -93,10 +134,48 @@ public:
 
 	void DrawVbo_PCT( unsigned int vboID, int numVerts, VertexGroupingRule vertexGroupingRule );
 
+	//Vertex arena commands, for many small meshes sharing a few big buffers, e.g. chunks.
+	void UpdateArenaVertexes( VertexArenaAllocation& inout_allocation, const Vertex3D_PCT* vertexArrayData, unsigned int numVertexes ); //Reuses the allocation if it still fits.
+	void FreeArenaVertexes( VertexArenaAllocation& allocation );
+	void QueueArenaDraw( const VertexArenaAllocation& allocation, unsigned int numVertexes );
+	void DrawQueuedArenaVertexes( VertexGroupingRule vertexGroupingRule, bool preserveQueueOrder = false ); //Clears the queue. See .cpp on ordering.
+	inline unsigned int GetNumArenaPages() const { return m_vertexArena.GetNumPages(); }
+
 private:
 	void CreateBuiltInTextures();
 	unsigned int GetOpenGLVertexGroupingRule( unsigned int TheRendererVertexGroupingRule ) const;
+	void SetCapability( RenderStateCache::Capability capability, unsigned int glCapability, bool flagValue );
+	void BindArrayBuffer( unsigned int vboID );
+	void EnablePCTClientArrays();
 	BitmapFont* m_defaultFont;
 	Texture* m_defaultTexture;
 	unsigned int m_currentTextureID;
+	RenderStateCache m_renderStateCache;
+
+	VertexArena m_vertexArena;
+	std::vector< unsigned int > m_arenaPageVboIDs; //Parallel to m_vertexArena's pages.
+	struct QueuedArenaDraw { int m_pageIndex; int m_firstVertex; int m_numVertexes; };
+	std::vector< QueuedArenaDraw > m_queuedArenaDraws; //In the order queued.
+	std::vector< int > m_multiDrawFirsts; //Scratch GLint/GLsizei arrays for glMultiDrawArrays.
+	std::vector< int > m_multiDrawCounts;
+
+	//Glyph quads per string, relative to its start position, keyed by a hash of everything that shapes them.
+	struct CachedTextMesh
+	{
+		std::string m_text;
+		float m_cellHeight;
+		float m_cellAspect;
+		Rgba m_tint;
+		const BitmapFont* m_font;
+		bool m_hasDropShadow;
+		unsigned int m_lastUsedTextBatch;
+		std::vector< Vertex3D_PCT > m_vertexes;
+	};
+	const CachedTextMesh& GetOrBuildTextMesh( const std::string& asciiText, float cellHeight, const Rgba& tint, const BitmapFont* font, float cellAspect, bool drawDropShadow );
+	std::unordered_map< size_t, CachedTextMesh > m_textMeshCache;
+	struct TextBatch { const Texture* m_fontTexture; std::vector< Vertex3D_PCT > m_vertexes; };
+	std::vector< TextBatch > m_textBatches; //One per font used since BeginTextBatch.
+	RenderFrameStats m_frameStats; //State change counts live in m_renderStateCache, merged in by GetFrameStats.
+	bool m_isBatchingText;
+	unsigned int m_textBatchCount; //How many batches have ended, for aging out cached meshes.
 };
\ No newline at end of file
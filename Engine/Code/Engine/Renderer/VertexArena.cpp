@@ -0,0 +1,102 @@
+#include "Engine/Renderer/VertexArena.hpp"
+
+
+#include "Engine/Error/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+VertexArenaAllocation VertexArena::Allocate( unsigned int numVertexes )
+{
+	VertexArenaAllocation allocation;
+	if ( numVertexes == 0 )
+		return allocation;
+
+	unsigned int numVertexesToReserve = ( ( numVertexes + VERTEX_ARENA_ALLOCATION_GRANULARITY - 1 ) / VERTEX_ARENA_ALLOCATION_GRANULARITY ) * VERTEX_ARENA_ALLOCATION_GRANULARITY;
+
+	for ( int pageIndex = 0; pageIndex < GetNumPages(); pageIndex++ )
+		if ( TryAllocateFromPage( pageIndex, numVertexesToReserve, allocation ) )
+			return allocation;
+
+	Page newPage;
+	newPage.m_numVertexes = ( numVertexesToReserve > VERTEX_ARENA_VERTEXES_PER_PAGE ) ? numVertexesToReserve : VERTEX_ARENA_VERTEXES_PER_PAGE;
+	newPage.m_freeRanges[ 0 ] = newPage.m_numVertexes;
+	m_pages.push_back( newPage );
+
+	bool didAllocate = TryAllocateFromPage( GetNumPages() - 1, numVertexesToReserve, allocation );
+	ASSERT_OR_DIE( didAllocate, "VertexArena Failed to Allocate From a Fresh Page" );
+	return allocation;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool VertexArena::TryAllocateFromPage( int pageIndex, unsigned int numVertexes, VertexArenaAllocation& out_allocation )
+{
+	std::map< unsigned int, unsigned int >& freeRanges = m_pages[ pageIndex ].m_freeRanges;
+
+	//First fit, so allocations pack toward the front of the earliest pages.
+	for ( std::map< unsigned int, unsigned int >::iterator rangeIter = freeRanges.begin(); rangeIter != freeRanges.end(); ++rangeIter )
+	{
+		unsigned int rangeStart = rangeIter->first;
+		unsigned int rangeLength = rangeIter->second;
+		if ( rangeLength < numVertexes )
+			continue;
+
+		freeRanges.erase( rangeIter );
+		if ( rangeLength > numVertexes )
+			freeRanges[ rangeStart + numVertexes ] = rangeLength - numVertexes;
+
+		out_allocation.m_pageIndex = pageIndex;
+		out_allocation.m_firstVertex = rangeStart;
+		out_allocation.m_numVertexesReserved = numVertexes;
+		return true;
+	}
+
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void VertexArena::Free( VertexArenaAllocation& allocation )
+{
+	if ( !allocation.IsValid() )
+		return;
+
+	std::map< unsigned int, unsigned int >& freeRanges = m_pages[ allocation.m_pageIndex ].m_freeRanges;
+	unsigned int rangeStart = allocation.m_firstVertex;
+	unsigned int rangeLength = allocation.m_numVertexesReserved;
+
+	//Merge with the free range right after, then the one right before, so ranges never fragment on free.
+	std::map< unsigned int, unsigned int >::iterator nextIter = freeRanges.find( rangeStart + rangeLength );
+	if ( nextIter != freeRanges.end() )
+	{
+		rangeLength += nextIter->second;
+		freeRanges.erase( nextIter );
+	}
+
+	std::map< unsigned int, unsigned int >::iterator prevIter = freeRanges.lower_bound( rangeStart );
+	if ( prevIter != freeRanges.begin() )
+	{
+		--prevIter;
+		if ( prevIter->first + prevIter->second == rangeStart )
+		{
+			rangeStart = prevIter->first;
+			rangeLength += prevIter->second;
+			freeRanges.erase( prevIter );
+		}
+	}
+
+	freeRanges[ rangeStart ] = rangeLength;
+	allocation = VertexArenaAllocation();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+unsigned int VertexArena::GetNumVertexesFree() const
+{
+	unsigned int numVertexesFree = 0;
+	for ( const Page& page : m_pages )
+		for ( const std::pair< unsigned int, unsigned int >& freeRange : page.m_freeRanges )
+			numVertexesFree += freeRange.second;
+
+	return numVertexesFree;
+}
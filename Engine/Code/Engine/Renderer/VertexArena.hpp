@@ -0,0 +1,51 @@
+#pragma once
+
+
+#include <map>
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------------------
+static const unsigned int VERTEX_ARENA_VERTEXES_PER_PAGE = 1 << 20; //24MB of Vertex3D_PCT per buffer.
+static const unsigned int VERTEX_ARENA_ALLOCATION_GRANULARITY = 256; //Vertexes. Slack so small remeshes fit back in place.
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct VertexArenaAllocation
+{
+	VertexArenaAllocation() : m_pageIndex( -1 ), m_firstVertex( 0 ), m_numVertexesReserved( 0 ) {}
+	inline bool IsValid() const { return m_pageIndex >= 0; }
+
+	int m_pageIndex;
+	unsigned int m_firstVertex;
+	unsigned int m_numVertexesReserved;
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Bookkeeping only: which vertex ranges of which pages are free. TheRenderer owns the buffer behind each page.
+//A page is added whenever nothing free fits, and one too big for a whole page gets an oversized page of its own.
+class VertexArena
+{
+public:
+
+	VertexArenaAllocation Allocate( unsigned int numVertexes );
+	void Free( VertexArenaAllocation& allocation ); //Also resets the allocation to invalid.
+
+	inline int GetNumPages() const { return (int)m_pages.size(); }
+	inline unsigned int GetPageCapacity( int pageIndex ) const { return m_pages[ pageIndex ].m_numVertexes; }
+	unsigned int GetNumVertexesFree() const;
+
+
+private:
+
+	struct Page
+	{
+		unsigned int m_numVertexes;
+		std::map< unsigned int, unsigned int > m_freeRanges; //First vertex to range length, kept coalesced.
+	};
+
+	bool TryAllocateFromPage( int pageIndex, unsigned int numVertexes, VertexArenaAllocation& out_allocation );
+
+	std::vector< Page > m_pages;
+};
@@ -74,3 +74,18 @@ const std::string GetAsUppercase( const std::string& mixedCaseString )
 
 	return copyToTurnUppercase;
 }
+
+
+//-----------------------------------------------------------------------------------------------
+bool FindCommandLineOptionValue( const std::string& commandLine, const std::string& optionName, std::string& out_value )
+{
+	std::string optionPrefix = "-" + optionName + "=";
+	size_t optionStart = commandLine.find( optionPrefix );
+	if ( optionStart == std::string::npos )
+		return false;
+
+	size_t valueStart = optionStart + optionPrefix.size();
+	size_t valueEnd = commandLine.find( ' ', valueStart );
+	out_value = commandLine.substr( valueStart, ( valueEnd == std::string::npos ) ? std::string::npos : ( valueEnd - valueStart ) );
+	return !out_value.empty();
+}
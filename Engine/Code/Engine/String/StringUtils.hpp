@@ -9,4 +9,5 @@
 const std::string Stringf( const char* format, ... ); //Use this most often.
 const std::string Stringf( const int maxLength, const char* format, ... ); //For 1000s+ chars.
 const std::string GetAsLowercase( const std::string& mixedCaseString );
-const std::string GetAsUppercase( const std::string& mixedCaseString );
\ No newline at end of file
+const std::string GetAsUppercase( const std::string& mixedCaseString );
+bool FindCommandLineOptionValue( const std::string& commandLine, const std::string& optionName, std::string& out_value ); //For "-optionName=value".
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "Engine/Time/Profiler.hpp"
+
+
+#include "Engine/Time/Time.hpp"
+#include "Engine/Error/ErrorWarningAssert.hpp"
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------------------------
+struct ProfilerEvent
+{
+	const char* m_zoneName;
+	double m_startSeconds;
+	double m_endSeconds;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct ProfilerZoneAccumulator
+{
+	const char* m_zoneName;
+	int m_depth;
+	double m_secondsThisFrame;
+	double m_averageMilliseconds;
+	bool m_hasAverage;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+struct ProfilerThreadBuffer
+{
+	unsigned int m_threadIndex; //Becomes the trace's tid.
+	std::vector< ProfilerEvent > m_events; //Ring of PROFILER_EVENTS_PER_THREAD.
+	std::atomic< unsigned int > m_numEventsRecorded; //Ever, so the ring's next slot is this modulo its size.
+	int m_currentDepth;
+	const char* m_openZoneNames[ PROFILER_MAX_ZONE_DEPTH ];
+	double m_openZoneStartSeconds[ PROFILER_MAX_ZONE_DEPTH ];
+	int m_openZoneAccumulatorIndexes[ PROFILER_MAX_ZONE_DEPTH ];
+	std::vector< ProfilerZoneAccumulator > m_zoneAccumulators; //In order of first entry, so parents precede children.
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static std::mutex s_profilerMutex; //Guards the two lists below, never a buffer's contents.
+static std::vector< ProfilerThreadBuffer* > s_allThreadBuffers; //Never freed, so an export still sees ended threads.
+static std::vector< ProfilerThreadBuffer* > s_releasedThreadBuffers;
+
+
+//-----------------------------------------------------------------------------------------------
+struct ProfilerThreadBufferOwner //Hands the buffer back when its thread ends.
+{
+	ProfilerThreadBuffer* m_buffer;
+
+	~ProfilerThreadBufferOwner()
+	{
+		if ( m_buffer == nullptr )
+			return;
+
+		std::lock_guard< std::mutex > lock( s_profilerMutex );
+		m_buffer->m_currentDepth = 0;
+		s_releasedThreadBuffers.push_back( m_buffer );
+	}
+};
+static thread_local ProfilerThreadBufferOwner s_threadBufferOwner = { nullptr };
+
+
+//-----------------------------------------------------------------------------------------------
+static ProfilerThreadBuffer* GetOrAcquireThreadBuffer()
+{
+	if ( s_threadBufferOwner.m_buffer != nullptr )
+		return s_threadBufferOwner.m_buffer;
+
+	std::lock_guard< std::mutex > lock( s_profilerMutex );
+	if ( !s_releasedThreadBuffers.empty() )
+	{
+		s_threadBufferOwner.m_buffer = s_releasedThreadBuffers.back();
+		s_releasedThreadBuffers.pop_back();
+		return s_threadBufferOwner.m_buffer;
+	}
+
+	ProfilerThreadBuffer* newBuffer = new ProfilerThreadBuffer();
+	newBuffer->m_threadIndex = s_allThreadBuffers.size();
+	newBuffer->m_events.resize( PROFILER_EVENTS_PER_THREAD );
+	newBuffer->m_numEventsRecorded = 0;
+	newBuffer->m_currentDepth = 0;
+	s_allThreadBuffers.push_back( newBuffer );
+
+	s_threadBufferOwner.m_buffer = newBuffer;
+	return newBuffer;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ProfilerBeginZone( const char* zoneName )
+{
+	ProfilerThreadBuffer* threadBuffer = GetOrAcquireThreadBuffer();
+	int depth = threadBuffer->m_currentDepth++;
+	if ( depth >= PROFILER_MAX_ZONE_DEPTH )
+		return; //Still counted, so the matching end unwinds correctly, but too deep to record.
+
+	int accumulatorIndex = -1;
+	for ( int zoneIndex = 0; zoneIndex < (int)threadBuffer->m_zoneAccumulators.size(); zoneIndex++ )
+		if ( threadBuffer->m_zoneAccumulators[ zoneIndex ].m_zoneName == zoneName ) //Same literal, same pointer.
+			accumulatorIndex = zoneIndex;
+	if ( accumulatorIndex == -1 )
+	{
+		ProfilerZoneAccumulator newAccumulator = { zoneName, depth, 0.0, 0.0, false };
+		threadBuffer->m_zoneAccumulators.push_back( newAccumulator );
+		accumulatorIndex = threadBuffer->m_zoneAccumulators.size() - 1;
+	}
+
+	threadBuffer->m_openZoneNames[ depth ] = zoneName;
+	threadBuffer->m_openZoneAccumulatorIndexes[ depth ] = accumulatorIndex;
+	threadBuffer->m_openZoneStartSeconds[ depth ] = GetCurrentTimeSeconds(); //Last, to leave the above out of the zone's time.
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ProfilerEndZone()
+{
+	double endSeconds = GetCurrentTimeSeconds();
+
+	ProfilerThreadBuffer* threadBuffer = GetOrAcquireThreadBuffer();
+	ASSERT_OR_DIE( threadBuffer->m_currentDepth > 0, "ProfilerEndZone Called Without a Matching ProfilerBeginZone" );
+	int depth = --threadBuffer->m_currentDepth;
+	if ( depth >= PROFILER_MAX_ZONE_DEPTH )
+		return;
+
+	double startSeconds = threadBuffer->m_openZoneStartSeconds[ depth ];
+	threadBuffer->m_zoneAccumulators[ threadBuffer->m_openZoneAccumulatorIndexes[ depth ] ].m_secondsThisFrame += endSeconds - startSeconds;
+
+	unsigned int eventNumber = threadBuffer->m_numEventsRecorded.load( std::memory_order_relaxed );
+	ProfilerEvent& newEvent = threadBuffer->m_events[ eventNumber % PROFILER_EVENTS_PER_THREAD ];
+	newEvent.m_zoneName = threadBuffer->m_openZoneNames[ depth ];
+	newEvent.m_startSeconds = startSeconds;
+	newEvent.m_endSeconds = endSeconds;
+	threadBuffer->m_numEventsRecorded.store( eventNumber + 1, std::memory_order_release ); //Publishes the event to an export.
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void ProfilerEndFrame()
+{
+	ProfilerThreadBuffer* threadBuffer = GetOrAcquireThreadBuffer();
+	for ( ProfilerZoneAccumulator& zone : threadBuffer->m_zoneAccumulators )
+	{
+		double millisecondsThisFrame = zone.m_secondsThisFrame * 1000.0;
+		if ( zone.m_hasAverage )
+			zone.m_averageMilliseconds += ( millisecondsThisFrame - zone.m_averageMilliseconds ) * PROFILER_ROLLING_AVERAGE_WEIGHT;
+		else
+			zone.m_averageMilliseconds = millisecondsThisFrame;
+
+		zone.m_hasAverage = true;
+		zone.m_secondsThisFrame = 0.0;
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void GetProfilerZoneAverages( std::vector< ProfilerZoneAverage >& out_zoneAverages )
+{
+	out_zoneAverages.clear();
+
+	ProfilerThreadBuffer* threadBuffer = GetOrAcquireThreadBuffer();
+	for ( const ProfilerZoneAccumulator& zone : threadBuffer->m_zoneAccumulators )
+	{
+		if ( !zone.m_hasAverage )
+			continue;
+
+		ProfilerZoneAverage zoneAverage = { zone.m_zoneName, zone.m_depth, zone.m_averageMilliseconds };
+		out_zoneAverages.push_back( zoneAverage );
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+//Another thread may still be recording while this reads its ring, so its very oldest events could be mid-overwrite.
+//Fine for a debug capture, and better than making every zone take a lock.
+bool ExportProfilerCaptureToChromeTrace( const std::string& filePath )
+{
+	FILE* file = nullptr;
+	errno_t err = fopen_s( &file, filePath.c_str(), "w" );
+	if ( err != 0 || file == nullptr )
+	{
+		DebuggerPrintf( "Profiler failed to open %s for export.\n", filePath.c_str() );
+		return false;
+	}
+
+	fprintf( file, "{ \"displayTimeUnit\": \"ms\", \"traceEvents\": [\n" );
+	bool isFirstEvent = true;
+	unsigned int numEventsExported = 0;
+
+	std::lock_guard< std::mutex > lock( s_profilerMutex );
+	for ( const ProfilerThreadBuffer* threadBuffer : s_allThreadBuffers )
+	{
+		unsigned int numEventsRecorded = threadBuffer->m_numEventsRecorded.load( std::memory_order_acquire );
+		unsigned int numEventsKept = ( numEventsRecorded < PROFILER_EVENTS_PER_THREAD ) ? numEventsRecorded : PROFILER_EVENTS_PER_THREAD;
+
+		for ( unsigned int eventNumber = numEventsRecorded - numEventsKept; eventNumber < numEventsRecorded; eventNumber++ )
+		{
+			const ProfilerEvent& event = threadBuffer->m_events[ eventNumber % PROFILER_EVENTS_PER_THREAD ];
+
+			//Zone names are code literals, so they're trusted not to need JSON escaping.
+			fprintf( file, "%s\t{ \"name\": \"%s\", \"cat\": \"zone\", \"ph\": \"X\", \"pid\": 0, \"tid\": %u, \"ts\": %.3f, \"dur\": %.3f }",
+					 isFirstEvent ? "" : ",\n", event.m_zoneName, threadBuffer->m_threadIndex,
+					 event.m_startSeconds * 1000000.0, ( event.m_endSeconds - event.m_startSeconds ) * 1000000.0 );
+			isFirstEvent = false;
+			++numEventsExported;
+		}
+	}
+
+	fprintf( file, "\n] }\n" );
+	fclose( file );
+
+	DebuggerPrintf( "Profiler exported %u zones from %u threads to %s.\n", numEventsExported, (unsigned int)s_allThreadBuffers.size(), filePath.c_str() );
+	return true;
+}
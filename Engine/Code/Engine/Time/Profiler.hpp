@@ -0,0 +1,55 @@
+#pragma once
+
+
+#include <string>
+#include <vector>
+
+
+//-----------------------------------------------------------------------------------------------
+//Set to 0 (e.g. in the project's preprocessor definitions) to compile every PROFILE_SCOPE out.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILE_SCOPE_CONCAT_INNER( a, b ) a##b
+#define PROFILE_SCOPE_CONCAT( a, b ) PROFILE_SCOPE_CONCAT_INNER( a, b )
+#if PROFILER_ENABLED
+	#define PROFILE_SCOPE( zoneName ) ProfileScope PROFILE_SCOPE_CONCAT( profileScope_, __LINE__ )( zoneName ) //zoneName must be a string literal.
+#else
+	#define PROFILE_SCOPE( zoneName )
+#endif
+
+
+//-----------------------------------------------------------------------------------------------
+static const unsigned int PROFILER_EVENTS_PER_THREAD = 1 << 14; //Ring buffer size, oldest zones are overwritten first.
+static const int PROFILER_MAX_ZONE_DEPTH = 32;
+static const double PROFILER_ROLLING_AVERAGE_WEIGHT = .05; //Of each new frame's time in a zone's average.
+
+
+//-----------------------------------------------------------------------------------------------
+//Each thread records into its own ring buffer without locking. Threads that end hand their buffer, events and all,
+//to the next thread that profiles, so short-lived workers don't each cost a buffer.
+void ProfilerBeginZone( const char* zoneName );
+void ProfilerEndZone();
+
+//Rolling averages only cover the thread calling ProfilerEndFrame, i.e. the main thread, once per frame.
+struct ProfilerZoneAverage
+{
+	const char* m_zoneName;
+	int m_depth; //Of its first appearance, for indenting.
+	double m_averageMilliseconds; //Per frame, summed over every entry into the zone that frame.
+};
+void ProfilerEndFrame();
+void GetProfilerZoneAverages( std::vector< ProfilerZoneAverage >& out_zoneAverages );
+
+//Writes every thread's buffered zones in the Chrome about:tracing (chrome://tracing) JSON format.
+bool ExportProfilerCaptureToChromeTrace( const std::string& filePath );
+
+
+//-----------------------------------------------------------------------------------------------
+class ProfileScope
+{
+public:
+	ProfileScope( const char* zoneName ) { ProfilerBeginZone( zoneName ); }
+	~ProfileScope() { ProfilerEndZone(); }
+};
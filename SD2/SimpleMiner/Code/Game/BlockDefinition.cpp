@@ -39,6 +39,7 @@ void BlockDefinition::InitializeBlockDefinitions()
 	tempDefinition.m_toughness = 0.f;
 	tempDefinition.m_isSolid = false;
 	tempDefinition.m_isOpaque = false;
+	tempDefinition.m_isTranslucent = false;
 	s_blockDefinitionRegistry[ BlockType::AIR ] = tempDefinition;
 
 	texCoords = g_textureAtlas->GetTexCoordsFromSpriteCoords( 15, 11 );
@@ -48,7 +49,8 @@ void BlockDefinition::InitializeBlockDefinitions()
 	tempDefinition.m_emittedLightLevel = 0;
 	tempDefinition.m_toughness = 0.f;
 	tempDefinition.m_isSolid = false;
-	tempDefinition.m_isOpaque = true;
+	tempDefinition.m_isOpaque = false; //So the terrain under it still gets meshed and lit.
+	tempDefinition.m_isTranslucent = true;
 	tempDefinition.m_walkingSounds.push_back( splashSound1 );
 	tempDefinition.m_walkingSounds.push_back( splashSound2 );
 	tempDefinition.m_placingSounds.push_back( splashSound1 );
@@ -56,6 +58,7 @@ void BlockDefinition::InitializeBlockDefinitions()
 	s_blockDefinitionRegistry[ BlockType::WATER ] = tempDefinition;
 	tempDefinition.m_walkingSounds.clear();
 	tempDefinition.m_placingSounds.clear();
+	tempDefinition.m_isTranslucent = false;
 
 	texCoords = g_textureAtlas->GetTexCoordsFromSpriteCoords( 2, 12 );
 	tempDefinition.m_texCoordsTop = texCoords;
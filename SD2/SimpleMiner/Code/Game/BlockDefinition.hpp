@@ -18,6 +18,7 @@ struct BlockDefinition
 	float m_toughness;
 	bool m_isSolid;
 	bool m_isOpaque;
+	bool m_isTranslucent;
 
 	std::vector< SoundID > m_walkingSounds;
 	std::vector< SoundID > m_breakingSounds;
@@ -27,8 +28,13 @@ struct BlockDefinition
 	static void InitializeBlockDefinitions();
 	static inline bool IsSolid( BlockType type ) { return s_blockDefinitionRegistry[ type ].m_isSolid; } //Things that aren't solid can't be selected by raycast or collided with.
 	static inline bool IsOpaque( BlockType type ) { return s_blockDefinitionRegistry[ type ].m_isOpaque; } //Things that aren't opaque don't occlude faces in HSR and end lighting column descents.
+	static inline bool IsTranslucent( BlockType type ) { return s_blockDefinitionRegistry[ type ].m_isTranslucent; } //Meshed separately and drawn blended, after everything opaque.
 	static inline int GetLightLevel( BlockType type ) { return s_blockDefinitionRegistry[ type ].m_emittedLightLevel; }
 	static inline float GetSecondsToBreak( BlockType type ) { return s_blockDefinitionRegistry[ type ].m_toughness; }
+	static inline bool IsFluid( BlockType type ) { return ( type == WATER ) || ( type == LAVA ); }
+	static inline bool FallsWhenUnsupported( BlockType type ) { return ( type == SAND ) || ( type == RED_SAND ) || ( type == GRAVEL ); }
+	static inline int GetMaxFluidLevel( BlockType type ) { return ( type == LAVA ) ? FLUID_MAX_LEVEL_LAVA : FLUID_MAX_LEVEL_WATER; }
+	static inline unsigned int GetBlockTickDelay( BlockType type ); //0 for blocks that never need a scheduled update.
 	static inline AABB2 GetSideTexCoords( BlockType type ) { return s_blockDefinitionRegistry[ type ].m_texCoordsSides; }
 	static void PlayBreakingSound( BlockType blockTypeBroken );
 	static void PlayPlacingSound( BlockType blockTypePlaced );
@@ -36,4 +42,17 @@ struct BlockDefinition
 	static void PlayWalkingSound( BlockType randomResult );
 
 	static float m_secondsSinceLastDigSound;
-};
\ No newline at end of file
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline unsigned int BlockDefinition::GetBlockTickDelay( BlockType type )
+{
+	switch ( type )
+	{
+		case WATER: return BLOCK_TICK_DELAY_WATER;
+		case LAVA: return BLOCK_TICK_DELAY_LAVA;
+		case SAND: case RED_SAND: case GRAVEL: return BLOCK_TICK_DELAY_FALLING;
+		default: return 0;
+	}
+}
@@ -13,132 +13,84 @@ BlockInfo::BlockInfo( Chunk* chunkOfBlock, LocalBlockIndex indexOfBlockInThatChu
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool BlockInfo::StepSouth() //-y.
+bool BlockInfo::StepSouthIntoEastNeighbor() //From y == 0 to the east neighbor's y == max.
 {
-	bool onEastBoundary = false;
-	LocalBlockCoords lbc = GetLocalBlockCoordsFromLocalBlockIndex( m_myBlockIndex );
-	if ( lbc.y == 0 )
-		onEastBoundary = true; //0-based to 1-based.
-
-
-	if ( onEastBoundary )
-	{
-		if ( m_myChunk->m_eastNeighbor == nullptr )
-			return false;
-
-		m_myChunk = m_myChunk->m_eastNeighbor;
-
-		m_myBlockIndex = GetLocalBlockIndexFromLocalBlockCoords( LocalBlockCoords( lbc.x, CHUNK_Y_WIDTH_IN_BLOCKS - 1, lbc.z ) );
-	}
-	else m_myBlockIndex -= CHUNK_Y_WIDTH_IN_BLOCKS;
+	if ( m_myChunk->m_eastNeighbor == nullptr )
+		return false;
 
+	m_myChunk = m_myChunk->m_eastNeighbor;
+	m_myBlockIndex |= LOCAL_Y_BITMASK_IN_INDEX;
 	return true;
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool BlockInfo::StepNorth() //+y.
+bool BlockInfo::StepNorthIntoWestNeighbor() //From y == max to the west neighbor's y == 0.
 {
-	bool onWestBoundary = false;
-	LocalBlockCoords lbc = GetLocalBlockCoordsFromLocalBlockIndex( m_myBlockIndex );
-	if ( lbc.y == CHUNK_Y_WIDTH_IN_BLOCKS - 1 )
-		onWestBoundary = true; //0-based to 1-based.
-
-	if ( onWestBoundary )
-	{
-		if ( m_myChunk->m_westNeighbor == nullptr ) 
-			return false;
-
-		m_myChunk = m_myChunk->m_westNeighbor;
-
-		m_myBlockIndex = GetLocalBlockIndexFromLocalBlockCoords( LocalBlockCoords( lbc.x, 0, lbc.z ) );
-	}
-	else m_myBlockIndex += CHUNK_Y_WIDTH_IN_BLOCKS;
+	if ( m_myChunk->m_westNeighbor == nullptr ) 
+		return false;
 
+	m_myChunk = m_myChunk->m_westNeighbor;
+	m_myBlockIndex &= ~LOCAL_Y_BITMASK_IN_INDEX;
 	return true;
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool BlockInfo::StepEast() //+x. Corresponds to back (NOT FRONT) faces, however, because we look down +x.
+bool BlockInfo::StepEastIntoNorthNeighbor() //From x == max to the north neighbor's x == 0.
 {
-	bool onNorthBoundary = false;
-	LocalBlockCoords lbc = GetLocalBlockCoordsFromLocalBlockIndex( m_myBlockIndex );
-	if ( lbc.x == CHUNK_X_LENGTH_IN_BLOCKS - 1 )
-		onNorthBoundary = true; //0-based to 1-based.
-
-
-	if ( onNorthBoundary )
-	{
-		if ( m_myChunk->m_northNeighbor == nullptr )
-			return false;
-
-		m_myChunk = m_myChunk->m_northNeighbor;
-
-		m_myBlockIndex = GetLocalBlockIndexFromLocalBlockCoords( LocalBlockCoords( 0, lbc.y, lbc.z ) );
-	}
-	else m_myBlockIndex++;
+	if ( m_myChunk->m_northNeighbor == nullptr )
+		return false;
 
+	m_myChunk = m_myChunk->m_northNeighbor;
+	m_myBlockIndex &= ~LOCAL_X_BITMASK;
 	return true;
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool BlockInfo::StepWest() //-x. Corresponds to FRONT (NOT BACK) faces, however, because we look down +x.
+bool BlockInfo::StepWestIntoSouthNeighbor() //From x == 0 to the south neighbor's x == max.
 {
-	bool onSouthBoundary = false;
-	LocalBlockCoords lbc = GetLocalBlockCoordsFromLocalBlockIndex( m_myBlockIndex );
-	if ( lbc.x == 0 ) 
-		onSouthBoundary = true; //0-based to 1-based.
-
-
-	if ( onSouthBoundary )
-	{
-		if ( m_myChunk->m_southNeighbor == nullptr )
-			return false;
-
-		m_myChunk = m_myChunk->m_southNeighbor;
-
-		m_myBlockIndex = GetLocalBlockIndexFromLocalBlockCoords( LocalBlockCoords( CHUNK_X_LENGTH_IN_BLOCKS - 1, lbc.y, lbc.z ) );
-	}
-	else m_myBlockIndex--;
+	if ( m_myChunk->m_southNeighbor == nullptr )
+		return false;
 
+	m_myChunk = m_myChunk->m_southNeighbor;
+	m_myBlockIndex |= LOCAL_X_BITMASK;
 	return true;
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool BlockInfo::StepUp() //+z.
+bool BlockInfo::StepTowardFace( BlockFace face )
 {
-	bool onSkyBoundary = false;
-	LocalBlockCoords lbc = GetLocalBlockCoordsFromLocalBlockIndex( m_myBlockIndex );
-	if ( lbc.z == CHUNK_Z_HEIGHT_IN_BLOCKS - 1 )
-		onSkyBoundary = true; //0-based to 1-based.
-
-	if ( onSkyBoundary )
-		return false;
-	else 
-		m_myBlockIndex += NUM_COLUMNS_PER_CHUNK;
-
-	return true;
+	switch ( face )
+	{
+		case BOTTOM: return StepDown(); //-z, down.
+		case TOP: return StepUp(); //+z, up.
+		case LEFT: return StepNorth(); //+y, left.
+		case RIGHT: return StepSouth(); //-y, right.
+		case FRONT: return StepWest(); //-x, south because looking down +x.
+		case BACK: return StepEast(); //+x, north.
+		default: return false;
+	}
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool BlockInfo::StepDown() //-z.
+unsigned char BlockInfo::GetNeighbors( BlockInfo out_neighbors[ NUM_FACES ] ) const
 {
-	bool onGroundBoundary = false;
-	LocalBlockCoords lbc = GetLocalBlockCoordsFromLocalBlockIndex( m_myBlockIndex );
-	if ( lbc.z == 0 )
-		onGroundBoundary = true; //0-based to 1-based.
-
+	unsigned char existingNeighborsMask = 0;
 
-	if ( onGroundBoundary )
-		return false;
-	else
-		m_myBlockIndex -= NUM_COLUMNS_PER_CHUNK;
+	for ( int face = 0; face < NUM_FACES; face++ )
+	{
+		out_neighbors[ face ] = *this;
+		if ( out_neighbors[ face ].StepTowardFace( static_cast<BlockFace>( face ) ) )
+			existingNeighborsMask |= BIT( face );
+		else
+			out_neighbors[ face ] = BlockInfo(); //Null chunk, so it can't be mistaken for a real neighbor.
+	}
 
-	return true;
+	return existingNeighborsMask;
 }
 
 
@@ -17,18 +17,97 @@ struct BlockInfo //WARNING: DO NOT HOLD ONTO, DATA IS LIKELY TO BECOME OBSOLETE.
 
 	BlockInfo() : m_myChunk( nullptr ), m_myBlockIndex( 0 ) {}
 	BlockInfo( Chunk* chunkOfBlock, LocalBlockIndex indexOfBlockInThatChunk );
-	bool StepSouth();
-	bool StepNorth();
-	bool StepEast();
-	bool StepWest();
-	bool StepUp();
-	bool StepDown();
+
+	//Boundary tests are masks on the packed index, so only crossing into a neighbor chunk leaves the inline path.
+	inline bool StepSouth();
+	inline bool StepNorth();
+	inline bool StepEast();
+	inline bool StepWest();
+	inline bool StepUp();
+	inline bool StepDown();
+	bool StepTowardFace( BlockFace face );
+	unsigned char GetNeighbors( BlockInfo out_neighbors[ NUM_FACES ] ) const; //Indexed by BlockFace. Returns BIT( face ) set for each neighbor that exists.
+
 	Block* GetBlock() const;
 	inline bool operator==( const BlockInfo& other ) const;
 	inline bool operator!=( const BlockInfo& other ) const;
+
+
+private:
+
+	bool StepSouthIntoEastNeighbor();
+	bool StepNorthIntoWestNeighbor();
+	bool StepEastIntoNorthNeighbor();
+	bool StepWestIntoSouthNeighbor();
 };
 
 
+//--------------------------------------------------------------------------------------------------------------
+inline bool BlockInfo::StepSouth() //-y.
+{
+	if ( ( m_myBlockIndex & LOCAL_Y_BITMASK_IN_INDEX ) == 0 )
+		return StepSouthIntoEastNeighbor();
+
+	m_myBlockIndex -= CHUNK_X_LENGTH_IN_BLOCKS;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline bool BlockInfo::StepNorth() //+y.
+{
+	if ( ( m_myBlockIndex & LOCAL_Y_BITMASK_IN_INDEX ) == LOCAL_Y_BITMASK_IN_INDEX )
+		return StepNorthIntoWestNeighbor();
+
+	m_myBlockIndex += CHUNK_X_LENGTH_IN_BLOCKS;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline bool BlockInfo::StepEast() //+x. Corresponds to back (NOT FRONT) faces, however, because we look down +x.
+{
+	if ( ( m_myBlockIndex & LOCAL_X_BITMASK ) == LOCAL_X_BITMASK )
+		return StepEastIntoNorthNeighbor();
+
+	m_myBlockIndex++;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline bool BlockInfo::StepWest() //-x. Corresponds to FRONT (NOT BACK) faces, however, because we look down +x.
+{
+	if ( ( m_myBlockIndex & LOCAL_X_BITMASK ) == 0 )
+		return StepWestIntoSouthNeighbor();
+
+	m_myBlockIndex--;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline bool BlockInfo::StepUp() //+z.
+{
+	if ( m_myBlockIndex >= NUM_BLOCKS_PER_CHUNK - NUM_COLUMNS_PER_CHUNK )
+		return false; //Top layer, nothing above chunks.
+
+	m_myBlockIndex += NUM_COLUMNS_PER_CHUNK;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline bool BlockInfo::StepDown() //-z.
+{
+	if ( m_myBlockIndex < NUM_COLUMNS_PER_CHUNK )
+		return false; //Bottom layer, nothing below chunks.
+
+	m_myBlockIndex -= NUM_COLUMNS_PER_CHUNK;
+	return true;
+}
+
+
 //--------------------------------------------------------------------------------------------------------------
 inline bool BlockInfo::operator==( const BlockInfo& other ) const 
 {
@@ -40,4 +119,4 @@ inline bool BlockInfo::operator==( const BlockInfo& other ) const
 inline bool BlockInfo::operator!=( const BlockInfo& other ) const
 {
 	return !(*this == other);
-}
\ No newline at end of file
+}
@@ -0,0 +1,34 @@
+#include "Game/BlockTickQueue.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool BlockTickQueue::Schedule( LocalBlockIndex lbi, unsigned int dueTick )
+{
+	if ( !m_scheduledBlockIndexes.insert( lbi ).second )
+		return false;
+
+	ScheduledBlockTick newTick = { dueTick, lbi };
+	m_ticksByDueTick.push( newTick );
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool BlockTickQueue::PopDueTick( unsigned int currentTick, LocalBlockIndex& out_lbi )
+{
+	if ( m_ticksByDueTick.empty() || ( m_ticksByDueTick.top().m_dueTick > currentTick ) )
+		return false;
+
+	out_lbi = m_ticksByDueTick.top().m_blockIndex;
+	m_ticksByDueTick.pop();
+	m_scheduledBlockIndexes.erase( out_lbi ); //Before the update runs, so it can reschedule itself.
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void BlockTickQueue::Clear()
+{
+	m_ticksByDueTick = std::priority_queue< ScheduledBlockTick, std::vector< ScheduledBlockTick >, std::greater< ScheduledBlockTick > >();
+	m_scheduledBlockIndexes.clear();
+}
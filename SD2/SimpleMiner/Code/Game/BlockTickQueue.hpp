@@ -0,0 +1,41 @@
+#pragma once
+
+
+#include <functional>
+#include <queue>
+#include <unordered_set>
+#include <vector>
+
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct ScheduledBlockTick
+{
+	unsigned int m_dueTick; //World simulation tick on or after which the block updates.
+	LocalBlockIndex m_blockIndex;
+
+	inline bool operator>( const ScheduledBlockTick& other ) const { return m_dueTick > other.m_dueTick; }
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//A chunk's pending block updates, soonest first. Each block is queued at most once: scheduling it again while it
+//waits keeps the earlier due tick, so a block poked by every neighbor in a flood still only updates once.
+class BlockTickQueue
+{
+public:
+
+	bool Schedule( LocalBlockIndex lbi, unsigned int dueTick ); //False if that block was already waiting.
+	bool PopDueTick( unsigned int currentTick, LocalBlockIndex& out_lbi );
+	void Clear();
+
+	inline bool IsEmpty() const { return m_ticksByDueTick.empty(); }
+	inline unsigned int GetNumScheduled() const { return m_ticksByDueTick.size(); }
+
+
+private:
+
+	std::priority_queue< ScheduledBlockTick, std::vector< ScheduledBlockTick >, std::greater< ScheduledBlockTick > > m_ticksByDueTick;
+	std::unordered_set< LocalBlockIndex > m_scheduledBlockIndexes; //For the dedupe, as the heap can't be searched.
+};
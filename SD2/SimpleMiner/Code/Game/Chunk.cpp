@@ -6,10 +6,19 @@
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Input/TheInput.hpp"
 #include "Engine/Math/Noise.hpp"
+#include "Engine/Time/Profiler.hpp"
+#include <deque>
 
 
 #include "Game/BlockDefinition.hpp"
 #include "Game/BlockInfo.hpp"
+#include "Game/HeightmapCache.hpp"
+#include "Game/StructureRegistry.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Shared by every chunk in every dimension, since structures and neighbors keep asking for the same columns.
+static HeightmapCache s_groundHeightCache( &Chunk::GenerateGroundHeightTile, GROUND_HEIGHT_CACHE_MAX_TILES );
 
 
 //--------------------------------------------------------------------------------------------------------------
@@ -21,7 +30,6 @@ Chunk::Chunk( ChunkCoords chunkPosition, Dimension chunkDimension )
 	, m_currentSkyLightLevel( MAX_LIGHTING_LEVEL )
 	, m_chunkDimension( chunkDimension )
 {
-	g_theRenderer->CreateVbo( m_vboID );
 	WorldCoords chunkCenterInWorldUnits = GetChunkCenterInWorldUnits();
 	m_chunkCornersInWorldUnits[ NORTHEAST_BOTTOM ] = chunkCenterInWorldUnits + WorldCoords( CHUNK_X_LENGTH_IN_BLOCKS*0.5f, CHUNK_Y_WIDTH_IN_BLOCKS*0.5f, 0.f );
 	m_chunkCornersInWorldUnits[ NORTHWEST_BOTTOM ] = chunkCenterInWorldUnits + WorldCoords( -CHUNK_X_LENGTH_IN_BLOCKS*0.5f, CHUNK_Y_WIDTH_IN_BLOCKS*0.5f, 0.f );
@@ -32,13 +40,30 @@ Chunk::Chunk( ChunkCoords chunkPosition, Dimension chunkDimension )
 	m_chunkCornersInWorldUnits[ SOUTHWEST_TOP ] = chunkCenterInWorldUnits + WorldCoords( -CHUNK_X_LENGTH_IN_BLOCKS*0.5f, -CHUNK_Y_WIDTH_IN_BLOCKS*0.5f, (float)CHUNK_Z_HEIGHT_IN_BLOCKS );
 	m_chunkCornersInWorldUnits[ SOUTHEAST_TOP ] = chunkCenterInWorldUnits + WorldCoords( CHUNK_X_LENGTH_IN_BLOCKS*0.5f, -CHUNK_Y_WIDTH_IN_BLOCKS*0.5f, (float)CHUNK_Z_HEIGHT_IN_BLOCKS );
 
+	m_renderBounds = AABB3( m_chunkCornersInWorldUnits[ SOUTHWEST_BOTTOM ], m_chunkCornersInWorldUnits[ NORTHEAST_TOP ] );
+
+	for ( int sectionIndex = 0; sectionIndex < NUM_SECTIONS_PER_CHUNK; sectionIndex++ )
+	{
+		m_sectionConnectivity[ sectionIndex ] = SECTION_ALL_FACES_CONNECTED;
+		m_sectionVisitStamps[ sectionIndex ] = 0;
+	}
+	m_dirtySectionConnectivityMask = (unsigned char)( BIT( NUM_SECTIONS_PER_CHUNK ) - 1 );
+	m_nonAirSectionMask = m_dirtySectionConnectivityMask;
+	m_chunkVisitStamp = 0;
+	m_numVertexes = 0;
+	m_numTranslucentVertexes = 0;
+
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 Chunk::~Chunk()
 {
-	g_theRenderer->DestroyVbo( m_vboID );
+	if ( g_theRenderer != nullptr ) //Headless pre-generation only ever saves chunks out.
+	{
+		g_theRenderer->FreeArenaVertexes( m_arenaAllocation );
+		g_theRenderer->FreeArenaVertexes( m_translucentArenaAllocation );
+	}
 }
 
 
@@ -68,12 +93,15 @@ void Chunk::PopulateChunkWithFlatStructure()
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::PopulateChunkWithPerlinNoise()
+void Chunk::PopulateChunkWithPerlinNoise( StructureRegistry& structureRegistry )
 {
+	int columnGroundHeights[ NUM_COLUMNS_PER_CHUNK ];
+	GetGroundHeightsWithPerlinNoiseForAllColumns( columnGroundHeights );
+
 	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
 	{
 		GlobalColumnCoords globalColumnCoords = GetGlobalColumnCoordsFromChunkColumnIndex( columnIndex );
-		int columnGroundHeight = GetGroundHeightWithPerlinNoiseForColumn( globalColumnCoords );
+		int columnGroundHeight = columnGroundHeights[ columnIndex ];
 
 		//Populating with basic generation first ensures structures will be injected on top of the basic, not basic on top of the structures.
 		if ( m_chunkDimension == DIM_OVERWORLD ) 
@@ -82,21 +110,11 @@ void Chunk::PopulateChunkWithPerlinNoise()
 			PopulateColumnWithNetherBlocksWithPerlinNoise( globalColumnCoords, columnIndex, columnGroundHeight );
 	}
 
-	if ( g_generateVillages )
-	{
-		int centerColumnIndex = ( NUM_COLUMNS_PER_CHUNK >> 1 ); //Replacing div by 2.
-		GlobalColumnCoords chunkCenter = GetGlobalColumnCoordsFromChunkColumnIndex( centerColumnIndex );
-		GlobalColumnCoords villageCenterCoordsIfExists = LookForVillageCenterWithPerlinNoiseAroundColumn( chunkCenter );
-		bool foundVillage = ( villageCenterCoordsIfExists != GlobalColumnCoords::ZERO );
-
-		//Unless we never saw a village center in range of this chunk, make village building requests--ignored just before assignment if outside this chunk.
-		if ( foundVillage )
-		{
-			int groundHeightAtVillageCenter = GetGroundHeightWithPerlinNoiseForColumn( villageCenterCoordsIfExists );
-			GlobalBlockCoords villageWorldCenter = GlobalBlockCoords( (int)villageCenterCoordsIfExists.x, (int)villageCenterCoordsIfExists.y, groundHeightAtVillageCenter );
-			BuildVillage( villageWorldCenter );
-		}
-	}
+	//Structures are placed once per registry cell, each chunk just stamps the parts that reach into it.
+	std::vector< const Structure* > overlappingStructures;
+	structureRegistry.GetStructuresOverlappingChunk( m_chunkDimension, m_chunkPosition, overlappingStructures );
+	for ( const Structure* structure : overlappingStructures )
+		StampStructure( *structure );
 }
 
 
@@ -195,346 +213,127 @@ void Chunk::PopulateColumnWithNetherBlocksWithPerlinNoise( GlobalColumnCoords gl
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::BuildVillage( GlobalBlockCoords villageWorldCenter )
+void Chunk::SetBlockTypeIfLocal( GlobalBlockCoords blockGlobalMins, BlockType newType )
 {
-	//Use coord types for math operations, but use BlockInfo type for block-neighbor checking.
-	GlobalBlockCoords villageWorldMins = villageWorldCenter - GlobalBlockCoords( VILLAGE_RADIUS_X_BLOCKS, VILLAGE_RADIUS_Y_BLOCKS, 0 );
-	GlobalBlockCoords villageWorldMaxs = villageWorldCenter + GlobalBlockCoords( VILLAGE_RADIUS_X_BLOCKS, VILLAGE_RADIUS_Y_BLOCKS, 0 );
-
-	//Call a series of build regions, later to be picked out from either more Perlin grids or the village Perlin grid in a repeatable way.
-	//Note that "mins" is lower-left, "maxs" is upper-right of a region.
-	GlobalBlockCoords regionSize = GlobalBlockCoords( VILLAGE_RADIUS_X_BLOCKS - VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER, VILLAGE_RADIUS_Y_BLOCKS - VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER, 0 );
-
-	//Portal shrine in lower-left quadrant of village.
-	GlobalBlockCoords portalShrineMins		= villageWorldMins;
-	GlobalBlockCoords portalShrineMaxs		= portalShrineMins + regionSize;
-
-	//Pond in upper-right quadrant of village.
-	GlobalBlockCoords pondMaxs				= villageWorldMaxs;
-	GlobalBlockCoords pondMins				= pondMaxs - regionSize;
-
-	//Treasure shrine in lower-right quadrant of village.
-	GlobalBlockCoords treasureShrineMins	= GlobalBlockCoords( villageWorldCenter.x + VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER, villageWorldMins.y, villageWorldCenter.z ); //+1 else on center.
-	GlobalBlockCoords treasureShrineMaxs	= treasureShrineMins + regionSize;
-
-	BuildVillageRoads( villageWorldMins, villageWorldMaxs, villageWorldCenter );
-	BuildPond( pondMins, pondMaxs );
-	BuildPortalShrine( portalShrineMins, portalShrineMaxs ); //Later send in %'s of the village sizes.
-	BuildTreasureShrine( treasureShrineMins, treasureShrineMaxs );
+	WorldCoordsXY blockWorldMinsXY = WorldCoordsXY( (float)blockGlobalMins.x, (float)blockGlobalMins.y );
+	ChunkCoords coordsForChunkContainingWorldPosOfBlock = GetChunkCoordsFromWorldCoordsXY( blockWorldMinsXY );
+	if ( coordsForChunkContainingWorldPosOfBlock != m_chunkPosition ) return; //Request was not for a block in this chunk.
 
-	//Mark the village center for now.
-	SetBlockTypeIfLocal( villageWorldCenter, BlockType::GLOWSTONE );
+	//Now we know the block is in this chunk, so we can transform the global block coords local to this chunk.
+	WorldCoordsXY chunkWorldMins = GetChunkMinsInWorldUnits();
+	LocalBlockCoords lbc = LocalBlockCoords( blockGlobalMins.x - (int)chunkWorldMins.x, blockGlobalMins.y - (int)chunkWorldMins.y, blockGlobalMins.z );
+	LocalBlockIndex lbi = GetLocalBlockIndexFromLocalBlockCoords( lbc );
+	m_blocks[ lbi ].SetBlockType( newType );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::BuildVillageRoads( GlobalBlockCoords villageWorldMins, GlobalBlockCoords villageWorldMaxs, GlobalBlockCoords villageWorldCenter )
+void Chunk::StampStructure( const Structure& structure )
 {
-	int roadRadius = VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER;
+	WorldCoordsXY chunkWorldMins = GetChunkMinsInWorldUnits();
+	int chunkMinX = (int)chunkWorldMins.x;
+	int chunkMinY = (int)chunkWorldMins.y;
 
-	//Place pond blocks.
-	for ( int y = villageWorldMins.y; y <= villageWorldMaxs.y; y++ )
+	for ( const StructureBlock& structureBlock : structure.m_blocks )
 	{
-		for ( int x = villageWorldMins.x; x <= villageWorldMaxs.x; x++ )
-		{
-			GlobalColumnCoords currentColumn = GlobalColumnCoords( (float)x, (float)y );
-			int currentColumnGroundHeight = GetGroundHeightWithPerlinNoiseForColumn( currentColumn );
-			BlockType roadType = GRAVEL; //( m_chunkDimension == DIM_NETHER ? MYCELIUM : GRAVEL ); -- didn't look quite right, but try another this way sometime.
+		LocalBlockCoords lbc = LocalBlockCoords( structureBlock.m_position.x - chunkMinX, structureBlock.m_position.y - chunkMinY, structureBlock.m_position.z );
+		if ( ( lbc.x < 0 ) || ( lbc.x >= CHUNK_X_LENGTH_IN_BLOCKS ) || ( lbc.y < 0 ) || ( lbc.y >= CHUNK_Y_WIDTH_IN_BLOCKS ) )
+			continue; //Request was not for a block in this chunk.
 
-			bool inRangeOnX = ( ( x < ( villageWorldCenter.x + roadRadius ) ) && ( x > ( villageWorldCenter.x - roadRadius ) ) );
-			bool inRangeOnY = ( ( y < ( villageWorldCenter.y + roadRadius ) ) && ( y > ( villageWorldCenter.y - roadRadius ) ) );
-			if ( inRangeOnX || inRangeOnY )
-			{
-				SetBlockTypeIfLocal( GlobalBlockCoords( x, y, currentColumnGroundHeight ), roadType );
-			}
-		}
+		m_blocks[ GetLocalBlockIndexFromLocalBlockCoords( lbc ) ].SetBlockType( structureBlock.m_type );
 	}
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::BuildPortalShrine( GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs )
+STATIC void Chunk::GetGroundHeightPerlinParameters( Dimension dimension, float& out_gridCellSize, int& out_numOctaves, float& out_persistance )
 {
-	int bottomOfShrine = GetMaxColumnGroundHeightForArea( shrineWorldMins, shrineWorldMaxs );
-
-	//Place shrine's floor blocks.
-	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
-	{
-		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
-		{
-			if ( m_chunkDimension == DIM_NETHER )
-			{
-				SetBlockTypeIfLocal( GlobalBlockCoords( x, y, bottomOfShrine ), BlockType::MYCELIUM );
-			}
-			else
-			{
-				SetBlockTypeIfLocal( GlobalBlockCoords( x, y, bottomOfShrine ), BlockType::BROWNSTONE );
-			}
-		}
-	}
+	out_gridCellSize = GROUND_HEIGHT_PERLIN_GRID_CELL_SIZE;
+	out_numOctaves = GROUND_HEIGHT_PERLIN_NUM_OCTAVES;
+	out_persistance = GROUND_HEIGHT_PERLIN_PERSISTANCE_PERCENTAGE;
 
-	//Place shrine's pillar blocks.
-	int topOfShrine = bottomOfShrine + VILLAGE_PORTAL_SHRINE_HEIGHT;
-	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
-	{
-		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
-		{
-			for ( int z = 0; z <= topOfShrine; z++ )
-			{
-				bool shouldFormTowerBand = ( ( z & 7 ) == 0 ); //& 7 replaces mod by 8.
-
-				if ( z < bottomOfShrine ) //Foundation.
-				{
-					SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
-				}
-				else if ( x == shrineWorldMins.x || x == shrineWorldMaxs.x )
-				{
-					if ( shouldFormTowerBand || y == shrineWorldMins.y || y == shrineWorldMaxs.y )
-					{
-						if ( m_chunkDimension == DIM_NETHER )
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::NETHERRACK );
-						}
-						else
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
-						}
-					}
-					else //Place the blocks between the corner pillars.
-					{
-						if ( m_chunkDimension == DIM_NETHER )
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::RED_SAND );
-						}
-						else
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::BROWNSTONE );
-						}
-					}
-				}
-				else if ( y == shrineWorldMins.y || y == shrineWorldMaxs.y )
-				{
-					if ( shouldFormTowerBand || x == shrineWorldMins.x || x == shrineWorldMaxs.x )
-					{
-						if ( m_chunkDimension == DIM_NETHER )
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::NETHERRACK );
-						}
-						else
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
-						}
-					}
-					else //Place the blocks between the corner pillars.
-					{
-						if ( m_chunkDimension == DIM_NETHER )
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::RED_SAND );
-						}
-						else
-						{
-							SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::BROWNSTONE );
-						}
-					}
-				}
-
-			}
-		}
-	}
-
-	//Place shrine's floating platform you have to access via climbing tower.
-	int portalPlatformHeight = topOfShrine;
-	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
+	//Changes for Nether.
+	if ( dimension == DIM_NETHER )
 	{
-		//Skip outer ring.
-		if ( ( y <= ( shrineWorldMins.y + 1 ) ) || ( y >= ( shrineWorldMaxs.y - 1 ) ) )
-			continue;
-
-		//Fill rows inside outer ring.
-		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
-		{
-			//Skip outer ring.
-			if ( ( x <= ( shrineWorldMins.x + 1 ) ) || ( x >= ( shrineWorldMaxs.x - 1 ) ) ) 
-				continue;
-
-			SetBlockTypeIfLocal( GlobalBlockCoords( x, y, portalPlatformHeight ), BlockType::GLOWSTONE );
-		}
+		out_gridCellSize *= 2.f;
+		out_numOctaves += 2;
+		out_persistance *= 2.f;
 	}
-
-	//Place the portal block(s) after finding shrine center.
-	int shrineSizeOnX = abs( shrineWorldMaxs.x - shrineWorldMins.x );
-	int shrineSizeOnY = abs( shrineWorldMaxs.y - shrineWorldMins.y );
-
-	GlobalBlockCoords shrineWorldCenter = shrineWorldMins + GlobalBlockCoords( shrineSizeOnX >> 1, shrineSizeOnY >> 1, 0 ); //div by 2 replaced.
-	GlobalBlockCoords portalWorldMins = GlobalBlockCoords( shrineWorldCenter.x, shrineWorldCenter.y, topOfShrine-1 );
-
-	SetBlockTypeIfLocal( portalWorldMins, BlockType::PORTAL );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::BuildTreasureShrine( GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs )
+STATIC int Chunk::ConvertPerlinValueToGroundHeight( Dimension dimension, float perlinValue )
 {
-	int bottomOfShrine = GetMaxColumnGroundHeightForArea( shrineWorldMins, shrineWorldMaxs );
-	int topOfShrine = bottomOfShrine + VILLAGE_TREASURE_SHRINE_HEIGHT;
+	float perlinAmplitude = GROUND_HEIGHT_PERLIN_AMPLITUDE;
+	int minimumGroundHeight = GROUND_HEIGHT_MINIMUM;
 
-	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
+	//Changes for Nether.
+	if ( dimension == DIM_NETHER )
 	{
-		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
-		{
-			GlobalColumnCoords currentColumnInPond = GlobalColumnCoords( (float)x, (float)y );
-			int currentColumnGroundHeight = GetGroundHeightWithPerlinNoiseForColumn( currentColumnInPond );
-			GlobalBlockCoords currentBlockWorldMins = GlobalBlockCoords( x, y, currentColumnGroundHeight );
+		perlinAmplitude *= 2.f;
+		minimumGroundHeight >>= 1; //replaces div by 2.
+	}
 
-			SetBlockTypeIfLocal( GlobalBlockCoords( x, y, topOfShrine ), BlockType::GOLD_BRICK );
-			SetBlockTypeIfLocal( GlobalBlockCoords( x, y, bottomOfShrine ), BlockType::GOLD_BRICK );
+	int groundHeight = static_cast<int>( perlinAmplitude * perlinValue ) + minimumGroundHeight;
 
-			for ( int z = 0; z < topOfShrine; z++ ) //Place walls.
-			{
-				if ( z < bottomOfShrine ) //Foundation.
-				{
-					SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
-				}
-				else if ( x == shrineWorldMins.x || x == shrineWorldMaxs.x )
-				{
-					if ( y == shrineWorldMins.y || y == shrineWorldMaxs.y )
-					{
-						SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::GOLD_BRICK );
-					}
-				}
-				else if ( y == shrineWorldMins.y || y == shrineWorldMaxs.y )
-				{
-					if ( x == shrineWorldMins.x || x == shrineWorldMaxs.x )
-					{
-						SetBlockTypeIfLocal( GlobalBlockCoords( x, y, z ), BlockType::GOLD_BRICK );
-					}
-				}
-			}
-		}
-	}
+	return ( groundHeight < 0 ) ? 0 : groundHeight; //In the case that the Perlin value is negative.
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::BuildClimbingTower( GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs )
+STATIC void Chunk::GenerateGroundHeightTile( Dimension dimension, const ChunkCoords& tileCoords, int out_groundHeights[ NUM_COLUMNS_PER_CHUNK ] )
 {
-	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
-	{
-		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
-		{
-			GlobalColumnCoords currentColumnInPond = GlobalColumnCoords( (float)x, (float)y );
-			int currentColumnGroundHeight = GetGroundHeightWithPerlinNoiseForColumn( currentColumnInPond );
-			GlobalBlockCoords currentBlockWorldMins = GlobalBlockCoords( x, y, currentColumnGroundHeight );
+	float perlinGridCellSize;
+	int perlinNumOctaves;
+	float perlinPersistancePercentage;
+	GetGroundHeightPerlinParameters( dimension, perlinGridCellSize, perlinNumOctaves, perlinPersistancePercentage );
+
+	//Column indices run x-fastest, matching the grid's row-major output, and column coords are whole blocks so this matches the per-column noise exactly.
+	WorldCoordsXY tileMins( (float)( tileCoords.x * CHUNK_X_LENGTH_IN_BLOCKS ), (float)( tileCoords.y * CHUNK_Y_WIDTH_IN_BLOCKS ) );
+	float perlinValues[ NUM_COLUMNS_PER_CHUNK ];
+	ComputePerlinNoiseGrid2D(
+		tileMins,
+		CHUNK_X_LENGTH_IN_BLOCKS,
+		CHUNK_Y_WIDTH_IN_BLOCKS,
+		1.f,
+		perlinGridCellSize,
+		perlinNumOctaves,
+		perlinPersistancePercentage,
+		perlinValues,
+		g_worldSeed
+	);
 
-			SetBlockTypeIfLocal( currentBlockWorldMins, BlockType::BROWNSTONE );
-		}
-	}
+	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
+		out_groundHeights[ columnIndex ] = ConvertPerlinValueToGroundHeight( dimension, perlinValues[ columnIndex ] );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::BuildPond( GlobalBlockCoords pondWorldMins, GlobalBlockCoords pondWorldMaxs )
+int Chunk::GetGroundHeightWithPerlinNoiseForColumn( GlobalColumnCoords globalColumnCoords ) const
 {
-	int topOfPond = GetMaxColumnGroundHeightForArea( pondWorldMins, pondWorldMaxs ); //Pond goes down from ground level.
-	int bottomOfPond = topOfPond - VILLAGE_POND_HEIGHT;
-
-	//Place pond blocks.
-	for ( int y = pondWorldMins.y; y <= pondWorldMaxs.y; y++ )
-	{
-		for ( int x = pondWorldMins.x; x <= pondWorldMaxs.x; x++ )
-		{
-			for ( int z = 0; z < CHUNK_Z_HEIGHT_IN_BLOCKS; z++ )
-			{
-				GlobalBlockCoords currentBlockWorldMins = GlobalBlockCoords( x, y, z );
-
-				BlockType wallType = ( m_chunkDimension == DIM_NETHER ? NETHERRACK : COBBLESTONE );
-
-				if ( z > topOfPond )
-				{
-					continue;
-				}
-				else if ( z < bottomOfPond )
-				{
-					SetBlockTypeIfLocal( currentBlockWorldMins, wallType );
-				}
-				else if ( ( x == pondWorldMins.x ) || ( x == pondWorldMaxs.x ) || ( y == pondWorldMins.y ) || ( y == pondWorldMaxs.y ) )
-				{
-					SetBlockTypeIfLocal( currentBlockWorldMins, wallType ); //Perimeter wall.
-				}
-				else
-				{
-					BlockType pondContent = ( m_chunkDimension == DIM_NETHER ? LAVA : WATER );
-					SetBlockTypeIfLocal( currentBlockWorldMins, pondContent );
-				}
-			}
-		}
-	}
+	return s_groundHeightCache.GetColumnHeight( m_chunkDimension, globalColumnCoords );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-int Chunk::GetMaxColumnGroundHeightForArea( const GlobalBlockCoords& areaMins, const GlobalBlockCoords& areaMaxs ) const
+STATIC int Chunk::GetGroundHeightWithPerlinNoiseForColumn( Dimension dimension, GlobalColumnCoords globalColumnCoords )
 {
-	//To get the bottom of a construct, we have to take the max ground height of all columns in range.
-	int currentMaxColumnGroundHeight = -1;
-	for ( int y = areaMins.y; y <= areaMaxs.y; y++ )
-	{
-		for ( int x = areaMins.x; x <= areaMaxs.x; x++ )
-		{
-			GlobalColumnCoords currentColumn = GlobalColumnCoords( (float)x, (float)y );
-			int currentColumnGroundHeight = GetGroundHeightWithPerlinNoiseForColumn( currentColumn );
-
-			if ( currentMaxColumnGroundHeight < currentColumnGroundHeight )
-				currentMaxColumnGroundHeight = currentColumnGroundHeight;
-		}
-	}
-	return currentMaxColumnGroundHeight;
+	return s_groundHeightCache.GetColumnHeight( dimension, globalColumnCoords );
 }
 
+
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::SetBlockTypeIfLocal( GlobalBlockCoords blockGlobalMins, BlockType newType )
+STATIC void Chunk::GetGroundHeightTileWithPerlinNoise( Dimension dimension, const ChunkCoords& tileCoords, int out_groundHeights[ NUM_COLUMNS_PER_CHUNK ] )
 {
-	WorldCoordsXY blockWorldMinsXY = WorldCoordsXY( (float)blockGlobalMins.x, (float)blockGlobalMins.y );
-	ChunkCoords coordsForChunkContainingWorldPosOfBlock = GetChunkCoordsFromWorldCoordsXY( blockWorldMinsXY );
-	if ( coordsForChunkContainingWorldPosOfBlock != m_chunkPosition ) return; //Request was not for a block in this chunk.
-
-	//Now we know the block is in this chunk, so we can transform the global block coords local to this chunk.
-	WorldCoordsXY chunkWorldMins = GetChunkMinsInWorldUnits();
-	LocalBlockCoords lbc = LocalBlockCoords( blockGlobalMins.x - (int)chunkWorldMins.x, blockGlobalMins.y - (int)chunkWorldMins.y, blockGlobalMins.z );
-	LocalBlockIndex lbi = GetLocalBlockIndexFromLocalBlockCoords( lbc );
-	m_blocks[ lbi ].SetBlockType( newType );
+	s_groundHeightCache.GetTileHeights( dimension, tileCoords, out_groundHeights );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-int Chunk::GetGroundHeightWithPerlinNoiseForColumn( GlobalColumnCoords globalColumnCoords ) const
+void Chunk::GetGroundHeightsWithPerlinNoiseForAllColumns( int out_groundHeights[ NUM_COLUMNS_PER_CHUNK ] ) const
 {
-	float perlinGridCellSize = GROUND_HEIGHT_PERLIN_GRID_CELL_SIZE;
-	int perlinNumOctaves = GROUND_HEIGHT_PERLIN_NUM_OCTAVES;
-	float perlinPersistancePercentage = GROUND_HEIGHT_PERLIN_PERSISTANCE_PERCENTAGE;
-	float perlinAmplitude = GROUND_HEIGHT_PERLIN_AMPLITUDE;
-	int minimumGroundHeight = GROUND_HEIGHT_MINIMUM;
-
-	//Changes for Nether.
-	if ( m_chunkDimension == DIM_NETHER )
-	{
-		perlinGridCellSize *= 2.f;
-		perlinNumOctaves += 2;
-		perlinPersistancePercentage *= 2.f;
-		perlinAmplitude *= 2.f;
-		minimumGroundHeight >>= 1; //replaces div by 2.
-	}
-
-	float perlinValue = ComputePerlinNoiseValueAtPosition2D(
-		globalColumnCoords,
-		perlinGridCellSize,
-		perlinNumOctaves,
-		perlinPersistancePercentage
-	);
-
-	int groundHeight = static_cast<int>( perlinAmplitude * perlinValue ) + minimumGroundHeight;
-
-	return ( groundHeight < 0 ) ? 0 : groundHeight; //In the case that the Perlin value is negative.
+	s_groundHeightCache.GetTileHeights( m_chunkDimension, m_chunkPosition, out_groundHeights );
 }
 
 
@@ -552,7 +351,8 @@ int Chunk::GetCeilingHeightWithPerlinNoiseForColumn( GlobalColumnCoords globalCo
 		globalColumnCoords,
 		perlinGridCellSize,
 		perlinNumOctaves,
-		perlinPersistancePercentage
+		perlinPersistancePercentage,
+		g_worldSeed
 	);
 
 	int ceilingHeight = (int)( perlinAmplitude * perlinValue ) + maximumCeilingHeight;
@@ -562,61 +362,6 @@ int Chunk::GetCeilingHeightWithPerlinNoiseForColumn( GlobalColumnCoords globalCo
 }
 
 
-//--------------------------------------------------------------------------------------------------------------
-GlobalColumnCoords Chunk::LookForVillageCenterWithPerlinNoiseAroundColumn( GlobalColumnCoords globalColumnCoords )
-{
-	//Squirrel suggestion: just check around me in 5x5 chunk area, because I'm checking so much less?
-
-	//Loop over the possible range of a village from where a center could maximally be outside current column.
-	float searchMinX = globalColumnCoords.x - ( VILLAGE_RADIUS_X_BLOCKS * VILLAGE_NUM_CHUNKS_TO_LOOK_FOR_VILLAGE );
-	float searchMaxX = globalColumnCoords.x + ( VILLAGE_RADIUS_X_BLOCKS * VILLAGE_NUM_CHUNKS_TO_LOOK_FOR_VILLAGE );
-	float searchMinY = globalColumnCoords.y - ( VILLAGE_RADIUS_Y_BLOCKS * VILLAGE_NUM_CHUNKS_TO_LOOK_FOR_VILLAGE );
-	float searchMaxY = globalColumnCoords.y + ( VILLAGE_RADIUS_Y_BLOCKS * VILLAGE_NUM_CHUNKS_TO_LOOK_FOR_VILLAGE );
-
-	//GOAL: revise this to only check against 5x5 of chunks.
-	for ( float y = searchMinY; y <= searchMaxY; y++ )
-	{
-		for ( float x = searchMinX; x <= searchMaxX; x++ )
-		{
-			GlobalColumnCoords columnToSearch = GlobalColumnCoords( x, y );
-			GlobalColumnCoords northNeighborToCurrentColumn = GlobalColumnCoords( x, y + 1 );
-			GlobalColumnCoords southNeighborToCurrentColumn = GlobalColumnCoords( x, y - 1 );
-			GlobalColumnCoords eastNeighborToCurrentColumn = GlobalColumnCoords( x + 1, y );
-			GlobalColumnCoords westNeighborToCurrentColumn = GlobalColumnCoords( x - 1, y ); //Halving the calls by halving neighbors checked, i.e. excluding:
-// 			GlobalColumnCoords northeastNeighborToCurrentColumn = GlobalColumnCoords( x + 1, y + 1 );
-// 			GlobalColumnCoords southeastNeighborToCurrentColumn = GlobalColumnCoords( x + 1, y - 1 );
-// 			GlobalColumnCoords northwestNeighborToCurrentColumn = GlobalColumnCoords( x - 1, y + 1 );
-// 			GlobalColumnCoords southwestNeighborToCurrentColumn = GlobalColumnCoords( x - 1, y - 1 );
-
-//			float currentVillagePerlinGridValue = 1.f; //Makes it a world of villages if uncommented! Kept for easy testing.
-
-			float currentVillagePerlinGridValue = ComputePerlinNoiseValueAtPosition2D(
-				columnToSearch,
-				VILLAGE_PERLIN_GRID_CELL_SIZE,
-				VILLAGE_PERLIN_GRID_NUM_OCTAVES,
-				VILLAGE_PERLIN_GRID_PERSISTANCE
-			);
-
-			if ( currentVillagePerlinGridValue <= ComputePerlinNoiseValueAtPosition2D( northNeighborToCurrentColumn, VILLAGE_PERLIN_GRID_CELL_SIZE, VILLAGE_PERLIN_GRID_NUM_OCTAVES, VILLAGE_PERLIN_GRID_PERSISTANCE ) )
-				continue;
-			
-			if ( currentVillagePerlinGridValue <= ComputePerlinNoiseValueAtPosition2D( southNeighborToCurrentColumn, VILLAGE_PERLIN_GRID_CELL_SIZE, VILLAGE_PERLIN_GRID_NUM_OCTAVES, VILLAGE_PERLIN_GRID_PERSISTANCE ) )
-				continue;
-			
-			if ( currentVillagePerlinGridValue <= ComputePerlinNoiseValueAtPosition2D( eastNeighborToCurrentColumn, VILLAGE_PERLIN_GRID_CELL_SIZE, VILLAGE_PERLIN_GRID_NUM_OCTAVES, VILLAGE_PERLIN_GRID_PERSISTANCE ) )
-				continue;
-			
-			if ( currentVillagePerlinGridValue <= ComputePerlinNoiseValueAtPosition2D( westNeighborToCurrentColumn, VILLAGE_PERLIN_GRID_CELL_SIZE, VILLAGE_PERLIN_GRID_NUM_OCTAVES, VILLAGE_PERLIN_GRID_PERSISTANCE ) )
-				continue;
-
-			return columnToSearch; //At this point we know columnToSearch is a local maxima of the Perlin grid, i.e. a village center.
-		}
-	}
-
-	return GlobalColumnCoords::ZERO;
-}
-
-
 //--------------------------------------------------------------------------------------------------------------
 void Chunk::PopulateChunkWithRleString( const std::vector< unsigned char >& rleString )
 {
@@ -647,19 +392,96 @@ void Chunk::PopulateChunkWithRleString( const std::vector< unsigned char >& rleS
 //--------------------------------------------------------------------------------------------------------------
 void Chunk::RebuildVertexArray()
 {
+	++g_chunksMeshed;
+
 	std::vector< Vertex3D_PCT > vertexes;
-	vertexes.reserve( 10000 );
-	PopulateChunkVertexArray( vertexes );
+	std::vector< Vertex3D_PCT > translucentVertexes;
+	PopulateChunkVertexArray( vertexes, translucentVertexes );
 	m_numVertexes = vertexes.size();
+	m_numTranslucentVertexes = translucentVertexes.size();
+	UpdateRenderBounds( vertexes, translucentVertexes );
+	UpdateDirtySectionConnectivity();
 	
 	if ( g_renderChunksWithVertexArrays ) 
+	{
 		m_vertexes = vertexes;
+		m_translucentVertexes = translucentVertexes;
+	}
 	
-	g_theRenderer->UpdateVbo( m_vboID, vertexes.data(), m_numVertexes * sizeof( Vertex3D_PCT ) );
+	g_theRenderer->UpdateArenaVertexes( m_arenaAllocation, vertexes.data(), m_numVertexes );
+	g_theRenderer->UpdateArenaVertexes( m_translucentArenaAllocation, translucentVertexes.data(), m_numTranslucentVertexes );
 	m_isVertexArrayDirty = false;
 }
 
 
+//--------------------------------------------------------------------------------------------------------------
+void Chunk::UpdateRenderBounds( const std::vector< Vertex3D_PCT >& vertexes, const std::vector< Vertex3D_PCT >& translucentVertexes )
+{
+	if ( vertexes.empty() && translucentVertexes.empty() ) //Nothing to draw, so leave a flat box on the chunk floor rather than the whole column.
+	{
+		m_renderBounds.mins = m_chunkCornersInWorldUnits[ SOUTHWEST_BOTTOM ];
+		m_renderBounds.maxs = m_chunkCornersInWorldUnits[ NORTHEAST_BOTTOM ];
+		return;
+	}
+
+	//Most of a 128-tall chunk is air above the terrain or stone below the caves, so hug what was actually meshed.
+	m_renderBounds.mins = vertexes.empty() ? translucentVertexes[ 0 ].m_position : vertexes[ 0 ].m_position;
+	m_renderBounds.maxs = m_renderBounds.mins;
+	const std::vector< Vertex3D_PCT >* meshes[ 2 ] = { &vertexes, &translucentVertexes };
+	for ( const std::vector< Vertex3D_PCT >* mesh : meshes )
+	{
+		for ( const Vertex3D_PCT& vertex : *mesh )
+		{
+			const Vector3& position = vertex.m_position;
+			if ( position.x < m_renderBounds.mins.x ) m_renderBounds.mins.x = position.x;
+			if ( position.y < m_renderBounds.mins.y ) m_renderBounds.mins.y = position.y;
+			if ( position.z < m_renderBounds.mins.z ) m_renderBounds.mins.z = position.z;
+			if ( position.x > m_renderBounds.maxs.x ) m_renderBounds.maxs.x = position.x;
+			if ( position.y > m_renderBounds.maxs.y ) m_renderBounds.maxs.y = position.y;
+			if ( position.z > m_renderBounds.maxs.z ) m_renderBounds.maxs.z = position.z;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void Chunk::UpdateDirtySectionConnectivity()
+{
+	//Only sections touched since the last rebuild, so a dig re-floods 4096 blocks rather than the whole chunk.
+	for ( int sectionIndex = 0; sectionIndex < NUM_SECTIONS_PER_CHUNK; sectionIndex++ )
+	{
+		if ( ( m_dirtySectionConnectivityMask & BIT( sectionIndex ) ) == 0 )
+			continue;
+
+		const Block* sectionBlocks = &m_blocks[ sectionIndex * NUM_BLOCKS_PER_SECTION ];
+		m_sectionConnectivity[ sectionIndex ] = ComputeSectionConnectivity( sectionBlocks );
+
+		m_nonAirSectionMask &= ~BIT( sectionIndex );
+		for ( int blockIndex = 0; blockIndex < NUM_BLOCKS_PER_SECTION; blockIndex++ )
+		{
+			if ( sectionBlocks[ blockIndex ].GetBlockType() != AIR )
+			{
+				m_nonAirSectionMask |= BIT( sectionIndex );
+				break;
+			}
+		}
+	}
+
+	m_dirtySectionConnectivityMask = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+AABB3 Chunk::GetSectionBounds( int sectionIndex ) const
+{
+	WorldCoordsXY chunkMins = GetChunkMinsInWorldUnits();
+	float sectionBottomZ = (float)( sectionIndex * SECTION_HEIGHT_IN_BLOCKS );
+
+	return AABB3( WorldCoords( chunkMins.x, chunkMins.y, sectionBottomZ ),
+				  WorldCoords( chunkMins.x + CHUNK_X_LENGTH_IN_BLOCKS, chunkMins.y + CHUNK_Y_WIDTH_IN_BLOCKS, sectionBottomZ + SECTION_HEIGHT_IN_BLOCKS ) );
+}
+
+
 //--------------------------------------------------------------------------------------------------------------
 void Chunk::Render() const
 {
@@ -669,7 +491,23 @@ void Chunk::Render() const
 	if ( g_renderChunksWithVertexArrays ) 
 		RenderWithVertexArray();
 	else 
-		RenderWithVbo();
+		g_theRenderer->QueueArenaDraw( m_arenaAllocation, m_numVertexes ); //World submits every queued chunk together once it's done visiting them.
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void Chunk::RenderTranslucent() const
+{
+	if ( !m_isVisible ) 
+		return;
+
+	if ( g_renderChunksWithVertexArrays ) 
+	{
+		g_theRenderer->BindTexture( g_textureAtlas->GetAtlasTexture() );
+		g_theRenderer->DrawVertexArray_PCT( TheRenderer::VertexGroupingRule::AS_QUADS, m_translucentVertexes, m_translucentVertexes.size() );
+	}
+	else 
+		g_theRenderer->QueueArenaDraw( m_translucentArenaAllocation, m_numTranslucentVertexes );
 }
 
 
@@ -703,18 +541,28 @@ WorldCoordsXY Chunk::GetChunkMinsInWorldUnits() const
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::PopulateChunkVertexArray( std::vector< Vertex3D_PCT >& out_vertexArray )
+void Chunk::PopulateChunkVertexArray( std::vector< Vertex3D_PCT >& out_vertexArray, std::vector< Vertex3D_PCT >& out_translucentVertexArray )
 {
 	out_vertexArray.clear();
 	out_vertexArray.reserve( 10000 );
+	out_translucentVertexArray.clear();
 
 	for ( LocalBlockIndex blockIndex = 0; blockIndex < NUM_BLOCKS_PER_CHUNK; blockIndex++ )
 	{
 		Block& block = m_blocks[ blockIndex ];
-		if ( block.GetBlockType() != AIR ) //not visible.
+		if ( block.GetBlockType() == AIR ) //not visible.
+			continue;
+
+		if ( !BlockDefinition::IsTranslucent( block.GetBlockType() ) )
 		{
 			AddBlockToVertexArray( block, blockIndex, out_vertexArray );
+			continue;
 		}
+
+		unsigned int firstNewVertex = out_translucentVertexArray.size();
+		AddBlockToVertexArray( block, blockIndex, out_translucentVertexArray );
+		for ( unsigned int vertexIndex = firstNewVertex; vertexIndex < out_translucentVertexArray.size(); vertexIndex++ )
+			out_translucentVertexArray[ vertexIndex ].m_color.alphaOpacity = TRANSLUCENT_BLOCK_ALPHA;
 	}
 }
 
@@ -722,28 +570,19 @@ void Chunk::PopulateChunkVertexArray( std::vector< Vertex3D_PCT >& out_vertexArr
 //--------------------------------------------------------------------------------------------------------------
 bool Chunk::ShouldFaceRender(BlockFace face, LocalBlockIndex thisBlockIndex )
 {
-	BlockInfo thisBlock = BlockInfo( this, thisBlockIndex );
-	BlockInfo neighborBlock = thisBlock;
-	bool successInStepping = false;
+	BlockInfo neighborBlock = BlockInfo( this, thisBlockIndex );
 
 	//Detect if neighbor exists via BlockInfo stepping, if not, need to render.
-	switch ( face )
-	{
-		case BOTTOM: successInStepping = neighborBlock.StepDown(); break; //-z, down.
-		case TOP: successInStepping = neighborBlock.StepUp(); break; //+z, up.
-		case LEFT: successInStepping = neighborBlock.StepNorth(); break; //+y, left.
-		case RIGHT: successInStepping = neighborBlock.StepSouth(); break; //-y, right.
-		case FRONT: successInStepping = neighborBlock.StepWest(); break; //-x, south because looking down +x.
-		case BACK: successInStepping = neighborBlock.StepEast(); break; //+x, north.
-	}
-
-	if ( !successInStepping ) 
+	if ( !neighborBlock.StepTowardFace( face ) ) 
 		return true; //Typically should mean on neighborless chunk edge.
 
 	//If this is below the next check it will not render water right, as water on water will be told it should not render when it should.
 	BlockType myBlockType = m_blocks[ thisBlockIndex ].GetBlockType();
 	Block* blockData = neighborBlock.m_myChunk->GetBlockFromLocalBlockIndex( neighborBlock.m_myBlockIndex );
 	BlockType neighborBlockType = blockData->GetBlockType();
+	if ( ( myBlockType == neighborBlockType ) && BlockDefinition::IsTranslucent( myBlockType ) )
+		return false; //Water against water, else every inner face of a lake gets blended over the next.
+
 	if ( BlockDefinition::IsOpaque( neighborBlockType ) == false ) 
 		return true; //If neighbor is NOT opaque, e.g. air, need to render.
 
@@ -946,14 +785,6 @@ void Chunk::AddBlockToVertexArray( const Block& block, LocalBlockIndex blockInde
 }
 
 
-//--------------------------------------------------------------------------------------------------------------
-void Chunk::RenderWithVbo() const
-{
-	g_theRenderer->BindTexture( g_textureAtlas->GetAtlasTexture() );
-	g_theRenderer->DrawVbo_PCT( m_vboID, m_numVertexes, TheRenderer::AS_QUADS );
-}
-
-
 //--------------------------------------------------------------------------------------------------------------
 void Chunk::RenderWithVertexArray() const
 {
@@ -1068,25 +899,7 @@ WorldCoords Chunk::GetWorldCoordsFromLocalBlockIndex( LocalBlockIndex lbi ) cons
 
 
 //--------------------------------------------------------------------------------------------------------------
-void Chunk::SetSelectedFace( const Vector3& directionOppositeFace )
-{
-	if ( directionOppositeFace == WORLD_UP ) 
-		m_selectedFace = BOTTOM;
-	else if ( directionOppositeFace == WORLD_DOWN ) 
-		m_selectedFace = TOP;
-	else if ( directionOppositeFace == WORLD_LEFT ) 
-		m_selectedFace = RIGHT;
-	else if ( directionOppositeFace == WORLD_RIGHT ) 
-		m_selectedFace = LEFT;
-	else if ( directionOppositeFace == WORLD_FORWARD ) 
-		m_selectedFace = BACK;
-	else if ( directionOppositeFace == WORLD_BACKWARD ) 
-		m_selectedFace = FRONT;
-}
-
-
-//--------------------------------------------------------------------------------------------------------------
-Rgba Chunk::GetLightColorForLightLevel( int lightLevel ) const
+STATIC Rgba Chunk::GetLightColorForLightLevel( int lightLevel )
 {
 	Rgba lightColor;
 
@@ -1127,6 +940,142 @@ void Chunk::SetCurrentSkyLightLevel( int clampedNewLightLevel )
 }
 
 
+//--------------------------------------------------------------------------------------------------------------
+static int GetInChunkNeighborIndexes( LocalBlockIndex lbi, LocalBlockIndex* out_neighborIndexes, bool includeVerticalNeighbors = true )
+{
+	LocalBlockCoords lbc = GetLocalBlockCoordsFromLocalBlockIndex( lbi );
+	int numNeighbors = 0;
+
+	//Blocks across the chunk border are skipped, World's border exchange handles those once neighbors are linked.
+	if ( lbc.x < CHUNK_X_LENGTH_IN_BLOCKS - 1 )
+		out_neighborIndexes[ numNeighbors++ ] = lbi + 1;
+	if ( lbc.x > 0 )
+		out_neighborIndexes[ numNeighbors++ ] = lbi - 1;
+	if ( lbc.y < CHUNK_Y_WIDTH_IN_BLOCKS - 1 )
+		out_neighborIndexes[ numNeighbors++ ] = lbi + CHUNK_X_LENGTH_IN_BLOCKS;
+	if ( lbc.y > 0 )
+		out_neighborIndexes[ numNeighbors++ ] = lbi - CHUNK_X_LENGTH_IN_BLOCKS;
+
+	if ( includeVerticalNeighbors )
+	{
+		if ( lbc.z < CHUNK_Z_HEIGHT_IN_BLOCKS - 1 )
+			out_neighborIndexes[ numNeighbors++ ] = lbi + NUM_COLUMNS_PER_CHUNK;
+		if ( lbc.z > 0 )
+			out_neighborIndexes[ numNeighbors++ ] = lbi - NUM_COLUMNS_PER_CHUNK;
+	}
+
+	return numNeighbors;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void Chunk::InitializeLocalLighting() //Only touches m_blocks, so safe on a worker thread as long as the chunk isn't linked to neighbors yet.
+{
+	PROFILE_SCOPE( "Chunk::InitializeLocalLighting" );
+
+	std::deque< LocalBlockIndex > localDirtyBlocks;
+	LocalBlockIndex neighborIndexes[ 6 ];
+
+	//Pass 1: mark sky blocks.
+	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
+	{
+		for ( int blockHeight = CHUNK_Z_HEIGHT_IN_BLOCKS - 1; blockHeight >= 0; blockHeight-- )
+		{
+			Block& currentBlock = m_blocks[ columnIndex + ( blockHeight << BITS_PER_XY_LAYER ) ];
+			if ( currentBlock.IsOpaque() )
+				break; //Stop descent, no more sky blocks, nor is this one.
+
+			currentBlock.SetBlockToBeSky();
+			currentBlock.SetLightLevel( MAX_LIGHTING_LEVEL );
+		}
+	}
+
+	//Pass 2: let sky light bleed into non-sky XY-neighbors, same as World's version but without leaving the chunk.
+	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
+	{
+		for ( int blockHeight = CHUNK_Z_HEIGHT_IN_BLOCKS - 1; blockHeight >= 0; blockHeight-- )
+		{
+			LocalBlockIndex lbi = columnIndex + ( blockHeight << BITS_PER_XY_LAYER );
+			if ( m_blocks[ lbi ].IsOpaque() )
+				break;
+
+			int numNeighbors = GetInChunkNeighborIndexes( lbi, neighborIndexes, false );
+			for ( int neighborIndex = 0; neighborIndex < numNeighbors; neighborIndex++ )
+			{
+				Block& neighbor = m_blocks[ neighborIndexes[ neighborIndex ] ];
+				if ( !neighbor.IsSky() && !neighbor.IsLightingDirty() )
+				{
+					neighbor.SetLightingDirty();
+					localDirtyBlocks.push_back( neighborIndexes[ neighborIndex ] );
+				}
+			}
+		}
+	}
+
+	//Pass 3: handle blocks that are non-sky light sources.
+	for ( int blockIndex = 0; blockIndex < NUM_BLOCKS_PER_CHUNK; blockIndex++ )
+	{
+		Block& currentBlock = m_blocks[ blockIndex ];
+		bool isLightSource = ( BlockDefinition::GetLightLevel( currentBlock.GetBlockType() ) > 0 );
+
+		if ( !currentBlock.IsSky() && isLightSource && !currentBlock.IsLightingDirty() )
+		{
+			currentBlock.SetLightingDirty();
+			localDirtyBlocks.push_back( blockIndex );
+		}
+	}
+
+	//Propagate, mirroring World::UpdateLighting but treating everything past the border as unlit.
+	while ( !localDirtyBlocks.empty() )
+	{
+		LocalBlockIndex lbi = localDirtyBlocks.front();
+		localDirtyBlocks.pop_front();
+
+		Block& currentBlock = m_blocks[ lbi ];
+		currentBlock.SetLightingNotDirty();
+
+		int idealLight = GetIdealLocalLightForBlock( lbi );
+		if ( idealLight == currentBlock.GetLightLevel() )
+			continue;
+
+		currentBlock.SetLightLevel( idealLight );
+
+		int numNeighbors = GetInChunkNeighborIndexes( lbi, neighborIndexes );
+		for ( int neighborIndex = 0; neighborIndex < numNeighbors; neighborIndex++ )
+		{
+			Block& neighbor = m_blocks[ neighborIndexes[ neighborIndex ] ];
+			if ( !neighbor.IsSky() && !neighbor.IsLightingDirty() )
+			{
+				neighbor.SetLightingDirty();
+				localDirtyBlocks.push_back( neighborIndexes[ neighborIndex ] );
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+int Chunk::GetIdealLocalLightForBlock( LocalBlockIndex lbi ) const
+{
+	const Block& block = m_blocks[ lbi ];
+
+	BlockType currentBlockType = block.GetBlockType();
+	if ( BlockDefinition::IsOpaque( currentBlockType ) )
+		return BlockDefinition::GetLightLevel( currentBlockType );
+
+	int currentBlockLight = BlockDefinition::GetLightLevel( currentBlockType );
+	int skyFactor = block.IsSky() ? m_currentSkyLightLevel : 0;
+	int highestNeighborLight = 0;
+
+	LocalBlockIndex neighborIndexes[ 6 ];
+	int numNeighbors = GetInChunkNeighborIndexes( lbi, neighborIndexes );
+	for ( int neighborIndex = 0; neighborIndex < numNeighbors; neighborIndex++ )
+		highestNeighborLight = GetMax( highestNeighborLight, m_blocks[ neighborIndexes[ neighborIndex ] ].GetLightLevel() );
+
+	return GetMax( highestNeighborLight - 1, GetMax( skyFactor, currentBlockLight ) );
+}
+
+
 //--------------------------------------------------------------------------------------------------------------
 bool Chunk::IsBlockSolid( LocalBlockIndex lbi ) const
 {
@@ -1140,6 +1089,8 @@ void Chunk::BreakBlock( LocalBlockIndex lbi )
 {
 	m_blocks[ lbi ].SetBlockType( BlockType::AIR );
 	m_blocks[ lbi ].SetBlockToNotBeOpaque();
+	m_flowingFluidLevels.erase( lbi );
+	MarkSectionConnectivityDirty( lbi );
 	m_isVertexArrayDirty = true;
 }
 
@@ -1162,14 +1113,15 @@ void Chunk::PlaceBlock( LocalBlockIndex lbi, const Vector3& directionOppositeFac
 		else 
 			m_blocks[ lbi ].SetBlockToNotBeOpaque();
 
+		m_flowingFluidLevels.erase( lbi );
+		MarkSectionConnectivityDirty( lbi );
 		m_isVertexArrayDirty = true;
 		return;
 	}
 
-	SetSelectedFace( directionOppositeFace );
 	LocalBlockCoords hitBlockLbc = GetLocalBlockCoordsFromLocalBlockIndex( lbi );
 	LocalBlockCoords newBlockLbc = hitBlockLbc;
-	switch ( m_selectedFace )
+	switch ( GetBlockFaceFromDirectionOppositeFace( directionOppositeFace ) )
 	{
 		case BlockFace::BOTTOM:
 		{
@@ -1254,18 +1206,12 @@ void Chunk::PlaceBlock( LocalBlockIndex lbi, const Vector3& directionOppositeFac
 		out_blockPlaced->m_myBlockIndex = newBlockLbi;
 	}
 
+	m_flowingFluidLevels.erase( newBlockLbi );
+	MarkSectionConnectivityDirty( newBlockLbi );
 	m_isVertexArrayDirty = true;
 }
 
 
-//--------------------------------------------------------------------------------------------------------------
-void Chunk::HighlightBlock( LocalBlockIndex lbi, Vector3 directionOppositeFace )
-{
-	m_selectedBlock = lbi;
-	SetSelectedFace( directionOppositeFace );
-}
-
-
 //--------------------------------------------------------------------------------------------------------------
 Block* Chunk::GetBlockFromLocalBlockIndex( LocalBlockIndex m_myBlockIndex )
 {
@@ -2,18 +2,24 @@
 
 
 #include "Engine/Renderer/Vertexes.hpp"
+#include "Engine/Renderer/VertexArena.hpp"
 #include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include <vector>
+#include <unordered_map>
 
 
 #include "Game/GameCommon.hpp"
 #include "Game/Block.hpp"
+#include "Game/SectionConnectivity.hpp"
+#include "Game/BlockTickQueue.hpp"
 
 
 //-----------------------------------------------------------------------------
 class SpriteSheet;
 struct BlockInfo;
-#define BLOCK_UNHIGHLIGHTED (99999)
+struct Structure;
+class StructureRegistry;
 
 
 //-----------------------------------------------------------------------------
@@ -32,19 +38,30 @@ public:
 	~Chunk();
 
 	void PopulateChunkWithFlatStructure();
-	void PopulateChunkWithPerlinNoise();
+	void PopulateChunkWithPerlinNoise( StructureRegistry& structureRegistry );
 	void PopulateChunkWithRleString( const std::vector< unsigned char >& rleString );
 	void GetRleString( std::vector< unsigned char >& out_rleBuffer );
+	static void GenerateGroundHeightTile( Dimension dimension, const ChunkCoords& tileCoords, int out_groundHeights[ NUM_COLUMNS_PER_CHUNK ] ); //Tile generator for the shared ground height cache.
+	static int GetGroundHeightWithPerlinNoiseForColumn( Dimension dimension, GlobalColumnCoords globalColumnCoords ); //Cached, also used by structure placement.
+	static void GetGroundHeightTileWithPerlinNoise( Dimension dimension, const ChunkCoords& tileCoords, int out_groundHeights[ NUM_COLUMNS_PER_CHUNK ] ); //Cached, also used by LOD terrain.
 
 	void RebuildVertexArray();
 	void Render() const;
+	void RenderTranslucent() const; //Call after every chunk's Render, farthest chunk first.
 	inline void HideChunk() { m_isVisible = false; }
 	inline void ShowChunk() { m_isVisible = true; }
 	inline bool IsDirty() const { return m_isVertexArrayDirty; }
 	inline void MarkVertexArrayDirty() { m_isVertexArrayDirty = true; }
+	inline void MarkSectionsChanged( unsigned char sectionMask ) { m_dirtySectionConnectivityMask |= sectionMask; m_isVertexArrayDirty = true; } //After writing blocks directly, e.g. a WorldEdit.
+	inline const AABB3& GetRenderBounds() const { return m_renderBounds; } //Tight around the last rebuilt mesh, for frustum culling.
+	inline SectionConnectivity GetSectionConnectivity( int sectionIndex ) const { return m_sectionConnectivity[ sectionIndex ]; }
+	AABB3 GetSectionBounds( int sectionIndex ) const;
+	inline bool IsSectionAllAir( int sectionIndex ) const { return ( m_nonAirSectionMask & BIT( sectionIndex ) ) == 0; } //As of the last rebuild, never true before the first.
 
 	int GetCurrentSkyLightLevel() const { return m_currentSkyLightLevel; }
+	static Rgba GetLightColorForLightLevel( int lightLevel ); //Vertex tint, also used by LOD terrain.
 	void SetCurrentSkyLightLevel( int clampedNewLightLevel );
+	void InitializeLocalLighting(); //Intra-chunk pass only, World exchanges border light after linking neighbors.
 
 	ChunkCoords GetChunkCoords() const { return m_chunkPosition; }
 	WorldCoords GetChunkCenterInWorldUnits() const;
@@ -54,58 +71,84 @@ public:
 	WorldCoords GetWorldCoordsFromLocalBlockIndex( LocalBlockIndex lbi ) const;
 	inline Dimension Chunk::GetDimension() const { return m_chunkDimension; }
 
-	inline bool IsHighlighting() const { return ( m_selectedFace == NONE ) || ( m_selectedBlock < NUM_BLOCKS_PER_CHUNK ); }
-	void Unhighlight() { m_selectedBlock = BLOCK_UNHIGHLIGHTED; m_selectedFace = NONE; }
-	void HighlightBlock( LocalBlockIndex lbi, Vector3 directionOppositeFace );
 	Block* GetBlockFromLocalBlockIndex( LocalBlockIndex m_myBlockIndex );
 	Block* GetBlockFromLocalBlockCoords( const LocalBlockCoords& lbc );
 	void BreakBlock( LocalBlockIndex lbi );
 	void PlaceBlock( LocalBlockIndex lbi, const Vector3& directionOppositeFace, BlockType typeToPlace, BlockInfo* out_blockPlaced = nullptr );
 	bool IsBlockSolid( LocalBlockIndex lbi ) const;
 
+	//Only meaningful for a fluid block: 0 is a source, higher is flowing and that many blocks out from one. Placing or breaking resets it.
+	inline int GetFluidLevel( LocalBlockIndex lbi ) const;
+	inline void SetFluidLevel( LocalBlockIndex lbi, int fluidLevel );
+
 	Chunk* m_northNeighbor; //+x.
 	Chunk* m_eastNeighbor; //-y.
 	Chunk* m_westNeighbor; //+y.
 	Chunk* m_southNeighbor; //-x.
 
-	LocalBlockIndex m_selectedBlock;
-	BlockFace m_selectedFace;
+	unsigned int m_sectionVisitStamps[ NUM_SECTIONS_PER_CHUNK ]; //Scratch for World's section walk, compared against its per-frame stamp.
+	unsigned int m_chunkVisitStamp;
+
+	BlockTickQueue m_scheduledBlockTicks; //Pending fluid and falling block updates, run by World under a per-tick budget.
 
 private:
 
-	void RenderWithVbo() const;
 	void RenderWithVertexArray() const;
-	void PopulateChunkVertexArray( std::vector< Vertex3D_PCT >& out_vertexArray );
+	void PopulateChunkVertexArray( std::vector< Vertex3D_PCT >& out_vertexArray, std::vector< Vertex3D_PCT >& out_translucentVertexArray );
+	void UpdateRenderBounds( const std::vector< Vertex3D_PCT >& vertexes, const std::vector< Vertex3D_PCT >& translucentVertexes );
+	void UpdateDirtySectionConnectivity();
+	inline void MarkSectionConnectivityDirty( LocalBlockIndex lbi ) { m_dirtySectionConnectivityMask |= BIT( lbi >> BITS_PER_SECTION ); }
 	bool ShouldFaceRender( BlockFace face, LocalBlockIndex thisBlockIndex );
 	void AddBlockToVertexArray( const Block& block, LocalBlockIndex blockIndex, std::vector< Vertex3D_PCT >& out_vertexArray );
 
 	void RenderWithDrawAABB() const;
 	void RenderBlockWithDrawAABB( BlockType blockType, const WorldCoords& renderBoundsMins, const Vector3& blockSize = Vector3::ONE ) const;
 
-	Rgba GetLightColorForLightLevel( int lightLevel ) const;
+	int GetIdealLocalLightForBlock( LocalBlockIndex lbi ) const;
 	void PopulateColumnWithOverworldBlocksWithPerlinNoise( int columnIndex, int groundHeight );
 	void PopulateColumnWithNetherBlocksWithPerlinNoise( GlobalColumnCoords globalColumnCoords, int columnIndex, int groundHeight );
-	int GetMaxColumnGroundHeightForArea( const GlobalBlockCoords& areaMins, const GlobalBlockCoords& areaMaxs ) const;
-	void BuildVillage( GlobalBlockCoords villageWorldCenter );
-	void BuildVillageRoads( GlobalBlockCoords villageWorldMins, GlobalBlockCoords villageWorldMaxs, GlobalBlockCoords villageWorldCenter );
-	void BuildPortalShrine( GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs );
-	void BuildTreasureShrine( GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs );
-	void BuildClimbingTower( GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs );
+	static void GetGroundHeightPerlinParameters( Dimension dimension, float& out_gridCellSize, int& out_numOctaves, float& out_persistance );
+	static int ConvertPerlinValueToGroundHeight( Dimension dimension, float perlinValue );
 	int GetGroundHeightWithPerlinNoiseForColumn( GlobalColumnCoords globalColumnCoords ) const;
+	void GetGroundHeightsWithPerlinNoiseForAllColumns( int out_groundHeights[ NUM_COLUMNS_PER_CHUNK ] ) const; //Both go through the shared heightmap cache.
 	int GetCeilingHeightWithPerlinNoiseForColumn( GlobalColumnCoords globalColumnCoords ) const;
-	GlobalColumnCoords LookForVillageCenterWithPerlinNoiseAroundColumn( GlobalColumnCoords globalColumnCoords );
-	void BuildPond( GlobalBlockCoords pondWorldMins, GlobalBlockCoords pondWorldMaxs );
 
-	void SetSelectedFace( const Vector3& directionOppositeFace );
 	void SetBlockTypeIfLocal( GlobalBlockCoords blockGlobalMins, BlockType newType );
+	void StampStructure( const Structure& structure );
 
 	Block m_blocks[ NUM_BLOCKS_PER_CHUNK ];
-	unsigned int m_vboID;
+	VertexArenaAllocation m_arenaAllocation; //This chunk's slice of TheRenderer's shared vertex buffers.
+	VertexArenaAllocation m_translucentArenaAllocation;
 	std::vector< Vertex3D_PCT > m_vertexes; //ONLY stored into when the debug flag to use vertex arrays is on.
+	std::vector< Vertex3D_PCT > m_translucentVertexes; //Likewise.
 	ChunkCoords m_chunkPosition; //e.g. (1,0) means 1 chunk forward (+x) from origin.
 	bool m_isVertexArrayDirty; //Set upon dig/place.
 	int m_currentSkyLightLevel;
 	bool m_isVisible;
 	unsigned int m_numVertexes;
+	unsigned int m_numTranslucentVertexes;
+	AABB3 m_renderBounds; //Whole chunk column until the first rebuild, then only the meshed part.
+	SectionConnectivity m_sectionConnectivity[ NUM_SECTIONS_PER_CHUNK ]; //All-connected until first meshed, so unbuilt chunks never hide anything.
+	unsigned char m_dirtySectionConnectivityMask; //Bit per section, recomputed at the next rebuild.
+	unsigned char m_nonAirSectionMask; //Bit per section holding anything but air, refreshed alongside connectivity.
+	std::unordered_map< LocalBlockIndex, unsigned char > m_flowingFluidLevels; //Sparse, as nearly all fluid is generated sources. Not saved.
 	Dimension m_chunkDimension;
-};
\ No newline at end of file
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline int Chunk::GetFluidLevel( LocalBlockIndex lbi ) const
+{
+	std::unordered_map< LocalBlockIndex, unsigned char >::const_iterator found = m_flowingFluidLevels.find( lbi );
+	return ( found == m_flowingFluidLevels.end() ) ? 0 : found->second;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline void Chunk::SetFluidLevel( LocalBlockIndex lbi, int fluidLevel )
+{
+	if ( fluidLevel == 0 )
+		m_flowingFluidLevels.erase( lbi );
+	else
+		m_flowingFluidLevels[ lbi ] = (unsigned char)fluidLevel;
+}
@@ -0,0 +1,92 @@
+#include "Game/EntityBenchmark.hpp"
+
+
+#include "Engine/Audio/TheAudio.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/SpriteSheet.hpp"
+#include "Engine/String/StringUtils.hpp"
+#include "Engine/Time/Time.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/BlockDefinition.hpp"
+#include "Game/Chunk.hpp"
+#include "Game/EntitySystem.hpp"
+#include "Game/StructureRegistry.hpp"
+#include "Game/WorldBlockQuery.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool GetEntityBenchmarkCountFromCommandLine( const std::string& commandLine, int& out_numEntities )
+{
+	std::string numEntitiesString;
+	if ( !FindCommandLineOptionValue( commandLine, "entitybench", numEntitiesString ) )
+		return false;
+
+	out_numEntities = atoi( numEntitiesString.c_str() );
+	return ( out_numEntities > 0 );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void RunEntityBenchmark( int numEntities )
+{
+	g_theAudio = new AudioSystem();
+	g_textureAtlas = new SpriteSheet( 16, 16, 16, 16 );
+	BlockDefinition::InitializeBlockDefinitions();
+	LoadWorldInfoFile(); //Only adopts an existing save's seed, never writes one, so a benchmark can't pick a new world's seed.
+
+	//Generated straight into memory, never saved, so the run is repeatable for a given seed and leaves no save behind.
+	StructureRegistry structureRegistry;
+	std::map< ChunkCoords, Chunk* > activeChunks[ NUM_DIMENSIONS ];
+	for ( int chunkY = -ENTITY_BENCHMARK_CHUNK_RADIUS; chunkY <= ENTITY_BENCHMARK_CHUNK_RADIUS; chunkY++ )
+	{
+		for ( int chunkX = -ENTITY_BENCHMARK_CHUNK_RADIUS; chunkX <= ENTITY_BENCHMARK_CHUNK_RADIUS; chunkX++ )
+		{
+			Chunk* newChunk = new Chunk( ChunkCoords( chunkX, chunkY ), DIM_OVERWORLD );
+			newChunk->PopulateChunkWithPerlinNoise( structureRegistry );
+			activeChunks[ DIM_OVERWORLD ][ ChunkCoords( chunkX, chunkY ) ] = newChunk;
+		}
+	}
+
+	//A mix of every type, dropped from a few blocks above the ground so the first ticks exercise falling and landing.
+	srand( g_worldSeed );
+	EntitySystem entities;
+	const float spawnHalfWidth = (float)( ENTITY_BENCHMARK_CHUNK_RADIUS * CHUNK_X_LENGTH_IN_BLOCKS );
+	for ( int entityNumber = 0; entityNumber < numEntities; entityNumber++ )
+	{
+		float spawnX = GetRandomFloatInRange( -spawnHalfWidth, spawnHalfWidth );
+		float spawnY = GetRandomFloatInRange( -spawnHalfWidth, spawnHalfWidth );
+		int groundHeight = Chunk::GetGroundHeightWithPerlinNoiseForColumn( DIM_OVERWORLD, GlobalColumnCoords( floor( spawnX ), floor( spawnY ) ) );
+		float spawnZ = GetMin( (float)groundHeight + GetRandomFloatInRange( 2.f, 12.f ), (float)CHUNK_Z_HEIGHT_IN_BLOCKS - 2.f );
+
+		EntityType type = (EntityType)( entityNumber % NUM_ENTITY_TYPES );
+		Vector3 velocity = Vector3( GetRandomFloatInRange( -2.f, 2.f ), GetRandomFloatInRange( -2.f, 2.f ), 0.f );
+		entities.SpawnEntity( type, DIM_OVERWORLD, Vector3( spawnX, spawnY, spawnZ ), velocity, ( type == ENTITY_MOB ) ? AIR : SAND );
+	}
+
+	WorldBlockQuery blockQuery( activeChunks );
+	std::vector< LandedFallingBlock > landedFallingBlocks;
+	double totalTickSeconds = 0.0;
+	double maxTickSeconds = 0.0;
+	for ( int tickNumber = 0; tickNumber < ENTITY_BENCHMARK_NUM_TICKS; tickNumber++ )
+	{
+		double tickStartSeconds = GetCurrentTimeSeconds();
+		entities.Update( SIMULATION_SECONDS_PER_TICK, blockQuery, DIM_OVERWORLD, Vector3::ZERO, landedFallingBlocks );
+		double tickSeconds = GetCurrentTimeSeconds() - tickStartSeconds;
+
+		totalTickSeconds += tickSeconds;
+		maxTickSeconds = GetMax( maxTickSeconds, tickSeconds );
+		landedFallingBlocks.clear(); //Not placed, so the terrain stays the same from tick to tick.
+	}
+
+	ReportHeadlessResult( Stringf( "Entity benchmark with seed %u: %i spawned, %u left (%u awake) after %i ticks. Average %.3f ms per tick, worst %.3f ms.", g_worldSeed,
+					numEntities, entities.GetNumEntities(), entities.GetNumAwakeEntities(), ENTITY_BENCHMARK_NUM_TICKS,
+					( totalTickSeconds * 1000.0 ) / ENTITY_BENCHMARK_NUM_TICKS, maxTickSeconds * 1000.0 ) );
+
+	for ( std::pair< const ChunkCoords, Chunk* >& chunkPair : activeChunks[ DIM_OVERWORLD ] )
+		delete chunkPair.second;
+
+	delete g_textureAtlas;
+	g_textureAtlas = nullptr;
+	delete g_theAudio;
+	g_theAudio = nullptr;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+
+#include <string>
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Command line option "-entitybench=<n>": spawn n entities over freshly generated (unsaved) chunks, simulate
+//ENTITY_BENCHMARK_NUM_TICKS ticks, report the per-tick timings through ReportHeadlessResult, then exit without ever opening a window.
+bool GetEntityBenchmarkCountFromCommandLine( const std::string& commandLine, int& out_numEntities );
+void RunEntityBenchmark( int numEntities );
@@ -0,0 +1,395 @@
+#include "Game/EntitySystem.hpp"
+
+
+#include <algorithm>
+
+#include "Engine/Renderer/TheRenderer.hpp"
+#include "Engine/Time/Profiler.hpp"
+#include "Game/WorldBlockQuery.hpp"
+#include "Game/VoxelCollision.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+static const Vector3 ENTITY_HALF_EXTENTS[ NUM_ENTITY_TYPES ] =
+{
+	Vector3( .3f, .3f, .9f ), //ENTITY_MOB, player-sized.
+	Vector3( .125f, .125f, .125f ), //ENTITY_DROPPED_ITEM
+	Vector3( .49f, .49f, .49f ), //ENTITY_FALLING_BLOCK, just under a block so it slides down a one-wide shaft.
+};
+static const Rgba ENTITY_COLORS[ NUM_ENTITY_TYPES ] = { Rgba( 1.f, 0.f, 0.f ), Rgba( 1.f, 1.f, 0.f ), Rgba( .5f, .5f, .5f ) }; //Not Rgba::RED etc., which may not be constructed yet.
+
+
+//--------------------------------------------------------------------------------------------------------------
+static float GetWidestEntityHalfExtentXY()
+{
+	float widestHalfExtent = 0.f;
+	for ( const Vector3& halfExtents : ENTITY_HALF_EXTENTS )
+		widestHalfExtent = GetMaxFloat( widestHalfExtent, GetMaxFloat( halfExtents.x, halfExtents.y ) );
+	return widestHalfExtent;
+}
+static const float ENTITY_MAX_HALF_EXTENT_XY = GetWidestEntityHalfExtentXY(); //Same file as the table, so it's initialized after it.
+
+
+//--------------------------------------------------------------------------------------------------------------
+EntitySystem::EntitySystem()
+	: m_nextEntityID( 0 )
+	, m_numAwakeEntities( 0 )
+	, m_areChunkBucketsStale( false )
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC const Vector3& EntitySystem::GetHalfExtentsForType( EntityType type )
+{
+	return ENTITY_HALF_EXTENTS[ type ];
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+EntityID EntitySystem::SpawnEntity( EntityType type, Dimension dimension, const Vector3& position, const Vector3& velocity /*= Vector3::ZERO*/, BlockType carriedBlockType /*= AIR*/ )
+{
+	EntityID newEntityID = m_nextEntityID++;
+	m_indexForEntityID[ newEntityID ] = m_ids.size();
+
+	m_ids.push_back( newEntityID );
+	m_types.push_back( type );
+	m_dimensions.push_back( dimension );
+	m_positions.push_back( position );
+	m_positionsLastTick.push_back( position );
+	m_velocities.push_back( velocity );
+	m_carriedBlockTypes.push_back( carriedBlockType );
+	m_secondsAlive.push_back( 0.f );
+	m_isAwake.push_back( 0 ); //Until the next Update decides.
+
+	m_areChunkBucketsStale = true;
+	return newEntityID;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::DestroyEntity( EntityID entityID )
+{
+	std::unordered_map< EntityID, unsigned int >::const_iterator found = m_indexForEntityID.find( entityID );
+	if ( found == m_indexForEntityID.end() )
+		return; //Already gone, e.g. landed or expired.
+
+	RemoveEntityAtIndex( found->second );
+	m_areChunkBucketsStale = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::Clear()
+{
+	m_ids.clear();
+	m_types.clear();
+	m_dimensions.clear();
+	m_positions.clear();
+	m_positionsLastTick.clear();
+	m_velocities.clear();
+	m_carriedBlockTypes.clear();
+	m_secondsAlive.clear();
+	m_isAwake.clear();
+	m_indexForEntityID.clear();
+	m_entitiesByChunk.clear();
+	m_chunkBuckets.clear();
+	m_numAwakeEntities = 0;
+	m_areChunkBucketsStale = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::RemoveEntityAtIndex( unsigned int entityIndex )
+{
+	unsigned int lastIndex = m_ids.size() - 1;
+	m_indexForEntityID.erase( m_ids[ entityIndex ] );
+
+	if ( entityIndex != lastIndex )
+	{
+		m_ids[ entityIndex ] = m_ids[ lastIndex ];
+		m_types[ entityIndex ] = m_types[ lastIndex ];
+		m_dimensions[ entityIndex ] = m_dimensions[ lastIndex ];
+		m_positions[ entityIndex ] = m_positions[ lastIndex ];
+		m_positionsLastTick[ entityIndex ] = m_positionsLastTick[ lastIndex ];
+		m_velocities[ entityIndex ] = m_velocities[ lastIndex ];
+		m_carriedBlockTypes[ entityIndex ] = m_carriedBlockTypes[ lastIndex ];
+		m_secondsAlive[ entityIndex ] = m_secondsAlive[ lastIndex ];
+		m_isAwake[ entityIndex ] = m_isAwake[ lastIndex ];
+		m_indexForEntityID[ m_ids[ entityIndex ] ] = entityIndex;
+	}
+
+	m_ids.pop_back();
+	m_types.pop_back();
+	m_dimensions.pop_back();
+	m_positions.pop_back();
+	m_positionsLastTick.pop_back();
+	m_velocities.pop_back();
+	m_carriedBlockTypes.pop_back();
+	m_secondsAlive.pop_back();
+	m_isAwake.pop_back();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::RebuildChunkBuckets()
+{
+	unsigned int numEntities = m_ids.size();
+	if ( m_areChunkBucketsStale || ( m_entitiesByChunk.size() != numEntities ) )
+	{
+		m_entitiesByChunk.resize( numEntities );
+		for ( unsigned int entityIndex = 0; entityIndex < numEntities; entityIndex++ )
+			m_entitiesByChunk[ entityIndex ] = std::make_pair( GetChunkBucketKey( m_positions[ entityIndex ] ), entityIndex );
+		std::sort( m_entitiesByChunk.begin(), m_entitiesByChunk.end() );
+	}
+	else
+	{
+		//Same entities as last tick and few change chunk per tick, so re-key in place and insertion sort the near-sorted result.
+		for ( std::pair< unsigned long long, unsigned int >& keyedEntity : m_entitiesByChunk )
+			keyedEntity.first = GetChunkBucketKey( m_positions[ keyedEntity.second ] );
+
+		for ( unsigned int sortedIndex = 1; sortedIndex < numEntities; sortedIndex++ )
+		{
+			std::pair< unsigned long long, unsigned int > keyedEntity = m_entitiesByChunk[ sortedIndex ];
+			unsigned int insertIndex = sortedIndex;
+			for ( ; ( insertIndex > 0 ) && ( keyedEntity < m_entitiesByChunk[ insertIndex - 1 ] ); insertIndex-- )
+				m_entitiesByChunk[ insertIndex ] = m_entitiesByChunk[ insertIndex - 1 ];
+			m_entitiesByChunk[ insertIndex ] = keyedEntity;
+		}
+	}
+
+	m_chunkBuckets.clear();
+	for ( unsigned int sortedIndex = 0; sortedIndex < numEntities; )
+	{
+		unsigned long long chunkKey = m_entitiesByChunk[ sortedIndex ].first;
+		ChunkBucket bucket = { sortedIndex, 0 };
+		for ( ; ( sortedIndex < numEntities ) && ( m_entitiesByChunk[ sortedIndex ].first == chunkKey ); sortedIndex++ )
+			++bucket.m_numEntities;
+		m_chunkBuckets[ chunkKey ] = bucket;
+	}
+
+	m_areChunkBucketsStale = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::UpdateSleeping( WorldBlockQuery& blockQuery, Dimension activeDimension, const Vector3& playerPosition )
+{
+	ChunkCoords playerChunkCoords = GetChunkCoordsFromWorldCoordsXY( WorldCoordsXY( playerPosition.x, playerPosition.y ) );
+	m_numAwakeEntities = 0;
+
+	//Decided once per bucket, as all its entities share a chunk.
+	for ( const std::pair< const unsigned long long, ChunkBucket >& bucketPair : m_chunkBuckets )
+	{
+		ChunkCoords bucketChunkCoords = ChunkCoords( (int)( bucketPair.first >> 32 ), (int)( bucketPair.first & 0xFFFFFFFF ) );
+		bool isNearPlayer = ( abs( bucketChunkCoords.x - playerChunkCoords.x ) <= ENTITY_AWAKE_RADIUS_IN_CHUNKS )
+			&& ( abs( bucketChunkCoords.y - playerChunkCoords.y ) <= ENTITY_AWAKE_RADIUS_IN_CHUNKS );
+		bool isChunkLoaded = isNearPlayer && ( blockQuery.GetChunk( activeDimension, bucketChunkCoords ) != nullptr ); //Else they'd fall through it.
+
+		const ChunkBucket& bucket = bucketPair.second;
+		for ( unsigned int sortedIndex = bucket.m_firstSortedIndex; sortedIndex < bucket.m_firstSortedIndex + bucket.m_numEntities; sortedIndex++ )
+		{
+			unsigned int entityIndex = m_entitiesByChunk[ sortedIndex ].second;
+			m_isAwake[ entityIndex ] = ( isChunkLoaded && ( m_dimensions[ entityIndex ] == activeDimension ) ) ? 1 : 0;
+			m_numAwakeEntities += m_isAwake[ entityIndex ];
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::Update( float tickSeconds, WorldBlockQuery& blockQuery, Dimension activeDimension, const Vector3& playerPosition, std::vector< LandedFallingBlock >& out_landedFallingBlocks )
+{
+	PROFILE_SCOPE( "EntitySystem::Update" );
+
+	if ( m_areChunkBucketsStale )
+		RebuildChunkBuckets();
+
+	UpdateSleeping( blockQuery, activeDimension, playerPosition );
+
+	m_positionsLastTick = m_positions; //Same size, so this copies into the existing capacity.
+
+	//Integration is a straight pass over the flat arrays.
+	unsigned int numEntities = m_ids.size();
+	for ( unsigned int entityIndex = 0; entityIndex < numEntities; entityIndex++ )
+	{
+		if ( !m_isAwake[ entityIndex ] )
+			continue;
+
+		m_velocities[ entityIndex ].z += ENTITY_GRAVITY_FORCE * tickSeconds;
+		m_secondsAlive[ entityIndex ] += tickSeconds;
+	}
+
+	//Collision walks bucket by bucket, so consecutive sweeps read the same chunk and keep the query's cache warm.
+	SweptBoxResult sweepResult;
+	for ( const std::pair< unsigned long long, unsigned int >& keyedEntity : m_entitiesByChunk )
+	{
+		unsigned int entityIndex = keyedEntity.second;
+		if ( !m_isAwake[ entityIndex ] )
+			continue;
+
+		EntityType type = m_types[ entityIndex ];
+		Vector3& position = m_positions[ entityIndex ];
+		Vector3& velocity = m_velocities[ entityIndex ];
+
+		SweepBoxThroughSolidBlocks( blockQuery, m_dimensions[ entityIndex ], position, ENTITY_HALF_EXTENTS[ type ], velocity * tickSeconds, sweepResult );
+		position += sweepResult.m_allowedDisplacement;
+
+		if ( sweepResult.m_wasAxisBlocked[ 0 ] )
+			velocity.x = 0.f;
+		if ( sweepResult.m_wasAxisBlocked[ 1 ] )
+			velocity.y = 0.f;
+		if ( sweepResult.m_wasAxisBlocked[ 2 ] )
+		{
+			bool hasLanded = ( velocity.z < 0.f );
+			velocity.z = 0.f;
+
+			if ( hasLanded && ( type == ENTITY_FALLING_BLOCK ) )
+			{
+				LandedFallingBlock landedBlock;
+				landedBlock.m_dimension = m_dimensions[ entityIndex ];
+				landedBlock.m_blockCoords = GlobalBlockCoords( (int)floor( position.x ), (int)floor( position.y ), (int)floor( position.z ) );
+				landedBlock.m_blockType = m_carriedBlockTypes[ entityIndex ];
+				out_landedFallingBlocks.push_back( landedBlock );
+				m_entityIndexesToRemove.push_back( entityIndex );
+				continue;
+			}
+
+			if ( hasLanded )
+			{
+				velocity.x *= ENTITY_GROUND_FRICTION;
+				velocity.y *= ENTITY_GROUND_FRICTION;
+			}
+		}
+
+		if ( ( position.z < 0.f ) || ( ( type == ENTITY_DROPPED_ITEM ) && ( m_secondsAlive[ entityIndex ] > ENTITY_DROPPED_ITEM_LIFETIME_SECONDS ) ) )
+			m_entityIndexesToRemove.push_back( entityIndex );
+	}
+
+	if ( !m_entityIndexesToRemove.empty() )
+	{
+		//Highest first, so a swap-remove never moves an entity that's still waiting to be removed.
+		std::sort( m_entityIndexesToRemove.begin(), m_entityIndexesToRemove.end() );
+		for ( unsigned int removalIndex = m_entityIndexesToRemove.size(); removalIndex > 0; removalIndex-- )
+			RemoveEntityAtIndex( m_entityIndexesToRemove[ removalIndex - 1 ] );
+
+		m_entityIndexesToRemove.clear();
+		m_areChunkBucketsStale = true;
+	}
+
+	RebuildChunkBuckets(); //For this tick's positions, so queries between ticks are exact.
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::FindEntitiesInBox( Dimension dimension, const Vector3& boxMins, const Vector3& boxMaxs, std::vector< EntityID >& out_entityIDs ) const
+{
+	out_entityIDs.clear();
+
+	if ( m_areChunkBucketsStale ) //Spawned or destroyed since the last Update, so the buckets' indexes can't be trusted.
+	{
+		for ( unsigned int entityIndex = 0; entityIndex < m_ids.size(); entityIndex++ )
+		{
+			const Vector3& halfExtents = ENTITY_HALF_EXTENTS[ m_types[ entityIndex ] ];
+			const Vector3& position = m_positions[ entityIndex ];
+			if ( ( m_dimensions[ entityIndex ] == dimension )
+				&& ( position.x + halfExtents.x > boxMins.x ) && ( position.x - halfExtents.x < boxMaxs.x )
+				&& ( position.y + halfExtents.y > boxMins.y ) && ( position.y - halfExtents.y < boxMaxs.y )
+				&& ( position.z + halfExtents.z > boxMins.z ) && ( position.z - halfExtents.z < boxMaxs.z ) )
+				out_entityIDs.push_back( m_ids[ entityIndex ] );
+		}
+		return;
+	}
+
+	//Pad by the widest entity, since a box is bucketed by its center alone.
+	ChunkCoords minChunkCoords = GetChunkCoordsFromWorldCoordsXY( WorldCoordsXY( boxMins.x - ENTITY_MAX_HALF_EXTENT_XY, boxMins.y - ENTITY_MAX_HALF_EXTENT_XY ) );
+	ChunkCoords maxChunkCoords = GetChunkCoordsFromWorldCoordsXY( WorldCoordsXY( boxMaxs.x + ENTITY_MAX_HALF_EXTENT_XY, boxMaxs.y + ENTITY_MAX_HALF_EXTENT_XY ) );
+
+	for ( int chunkX = minChunkCoords.x; chunkX <= maxChunkCoords.x; chunkX++ )
+	{
+		for ( int chunkY = minChunkCoords.y; chunkY <= maxChunkCoords.y; chunkY++ )
+		{
+			unsigned long long chunkKey = ( (unsigned long long)(unsigned int)chunkX << 32 ) | (unsigned int)chunkY;
+			std::unordered_map< unsigned long long, ChunkBucket >::const_iterator found = m_chunkBuckets.find( chunkKey );
+			if ( found == m_chunkBuckets.end() )
+				continue;
+
+			const ChunkBucket& bucket = found->second;
+			for ( unsigned int sortedIndex = bucket.m_firstSortedIndex; sortedIndex < bucket.m_firstSortedIndex + bucket.m_numEntities; sortedIndex++ )
+			{
+				unsigned int entityIndex = m_entitiesByChunk[ sortedIndex ].second;
+				const Vector3& halfExtents = ENTITY_HALF_EXTENTS[ m_types[ entityIndex ] ];
+				const Vector3& position = m_positions[ entityIndex ];
+				if ( ( m_dimensions[ entityIndex ] == dimension )
+					&& ( position.x + halfExtents.x > boxMins.x ) && ( position.x - halfExtents.x < boxMaxs.x )
+					&& ( position.y + halfExtents.y > boxMins.y ) && ( position.y - halfExtents.y < boxMaxs.y )
+					&& ( position.z + halfExtents.z > boxMins.z ) && ( position.z - halfExtents.z < boxMaxs.z ) )
+					out_entityIDs.push_back( m_ids[ entityIndex ] );
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static void AppendShadedBox( const Vector3& mins, const Vector3& maxs, const Rgba& color, std::vector< Vertex3D_PCT >& out_vertexes )
+{
+	//Faces darken toward the bottom so the flat-colored boxes still read as solid. Each quad counter-clockwise from outside.
+	Rgba topColor = color;
+	Rgba sideColor = Rgba( (unsigned char)( color.red * .8f ), (unsigned char)( color.green * .8f ), (unsigned char)( color.blue * .8f ) );
+	Rgba bottomColor = Rgba( (unsigned char)( color.red * .6f ), (unsigned char)( color.green * .6f ), (unsigned char)( color.blue * .6f ) );
+
+	//Top (+z), bottom (-z).
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, mins.y, maxs.z ), topColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, mins.y, maxs.z ), topColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, maxs.y, maxs.z ), topColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, maxs.y, maxs.z ), topColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, mins.y, mins.z ), bottomColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, maxs.y, mins.z ), bottomColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, maxs.y, mins.z ), bottomColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, mins.y, mins.z ), bottomColor ) );
+
+	//+x, -x.
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, mins.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, maxs.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, maxs.y, maxs.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, mins.y, maxs.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, maxs.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, mins.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, mins.y, maxs.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, maxs.y, maxs.z ), sideColor ) );
+
+	//+y, -y.
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, maxs.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, maxs.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, maxs.y, maxs.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, maxs.y, maxs.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, mins.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, mins.y, mins.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( maxs.x, mins.y, maxs.z ), sideColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( Vector3( mins.x, mins.y, maxs.z ), sideColor ) );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void EntitySystem::Render( Dimension activeDimension, float fractionTowardThisTick ) const
+{
+	//One vertex array for every awake entity in view of the player, drawn in a single call.
+	m_renderVertexes.clear();
+	for ( unsigned int entityIndex = 0; entityIndex < m_ids.size(); entityIndex++ )
+	{
+		if ( !m_isAwake[ entityIndex ] || ( m_dimensions[ entityIndex ] != activeDimension ) )
+			continue;
+
+		const Vector3& halfExtents = ENTITY_HALF_EXTENTS[ m_types[ entityIndex ] ];
+		const Vector3& positionLastTick = m_positionsLastTick[ entityIndex ];
+		Vector3 renderPosition = positionLastTick + ( ( m_positions[ entityIndex ] - positionLastTick ) * fractionTowardThisTick );
+		AppendShadedBox( renderPosition - halfExtents, renderPosition + halfExtents, ENTITY_COLORS[ m_types[ entityIndex ] ], m_renderVertexes );
+	}
+
+	if ( m_renderVertexes.empty() )
+		return;
+
+	g_theRenderer->UnbindTexture();
+	g_theRenderer->DrawVertexArray_PCT( TheRenderer::VertexGroupingRule::AS_QUADS, m_renderVertexes, m_renderVertexes.size() );
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+
+#include <vector>
+#include <unordered_map>
+
+#include "Engine/Math/Vector3.hpp"
+#include "Engine/Renderer/Vertexes.hpp"
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+class WorldBlockQuery;
+
+
+//--------------------------------------------------------------------------------------------------------------
+enum EntityType : unsigned char { ENTITY_MOB, ENTITY_DROPPED_ITEM, ENTITY_FALLING_BLOCK, NUM_ENTITY_TYPES };
+typedef unsigned int EntityID;
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct LandedFallingBlock //Handed back to World to place, as only it can relight the blocks around.
+{
+	Dimension m_dimension;
+	GlobalBlockCoords m_blockCoords;
+	BlockType m_blockType;
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Mobs, dropped items and falling blocks, stored as parallel arrays so each pass over them streams only the fields it uses.
+//Every tick entities are bucketed by the chunk they're in: collision then runs bucket by bucket to keep block lookups local,
+//and the same buckets answer neighbor queries. Entities outside the awake radius, or whose chunk isn't loaded, sleep in place.
+class EntitySystem
+{
+public:
+
+	EntitySystem();
+
+	EntityID SpawnEntity( EntityType type, Dimension dimension, const Vector3& position, const Vector3& velocity = Vector3::ZERO, BlockType carriedBlockType = AIR );
+	void DestroyEntity( EntityID entityID );
+	void Clear();
+
+	void Update( float tickSeconds, WorldBlockQuery& blockQuery, Dimension activeDimension, const Vector3& playerPosition, std::vector< LandedFallingBlock >& out_landedFallingBlocks );
+	void Render( Dimension activeDimension, float fractionTowardThisTick ) const; //Blends each entity's last two ticks, as World does the player's.
+
+	void FindEntitiesInBox( Dimension dimension, const Vector3& boxMins, const Vector3& boxMaxs, std::vector< EntityID >& out_entityIDs ) const;
+
+	inline unsigned int GetNumEntities() const { return m_ids.size(); }
+	inline unsigned int GetNumAwakeEntities() const { return m_numAwakeEntities; }
+	static const Vector3& GetHalfExtentsForType( EntityType type );
+
+
+private:
+
+	struct ChunkBucket { unsigned int m_firstSortedIndex; unsigned int m_numEntities; };
+
+	void UpdateSleeping( WorldBlockQuery& blockQuery, Dimension activeDimension, const Vector3& playerPosition );
+	void RebuildChunkBuckets();
+	void RemoveEntityAtIndex( unsigned int entityIndex );
+	static inline unsigned long long GetChunkBucketKey( const Vector3& position );
+
+	//Structure of arrays, all indexed alike. Removal swaps the last entity into the hole.
+	std::vector< EntityID > m_ids;
+	std::vector< EntityType > m_types;
+	std::vector< Dimension > m_dimensions;
+	std::vector< Vector3 > m_positions; //Box centers.
+	std::vector< Vector3 > m_positionsLastTick; //Only read by Render.
+	std::vector< Vector3 > m_velocities;
+	std::vector< BlockType > m_carriedBlockTypes; //What a falling block places or a dropped item holds.
+	std::vector< float > m_secondsAlive;
+	std::vector< unsigned char > m_isAwake; //Not vector< bool >, whose proxies defeat the point of flat arrays.
+
+	std::unordered_map< EntityID, unsigned int > m_indexForEntityID;
+	EntityID m_nextEntityID;
+	unsigned int m_numAwakeEntities;
+
+	std::vector< std::pair< unsigned long long, unsigned int > > m_entitiesByChunk; //Chunk key and entity index, sorted by key.
+	std::unordered_map< unsigned long long, ChunkBucket > m_chunkBuckets; //Each occupied chunk's run in m_entitiesByChunk.
+	bool m_areChunkBucketsStale; //Spawns and removals shift indexes, so the buckets need rebuilding before they're walked.
+	std::vector< unsigned int > m_entityIndexesToRemove;
+	mutable std::vector< Vertex3D_PCT > m_renderVertexes; //Kept to reuse its capacity frame to frame.
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline unsigned long long EntitySystem::GetChunkBucketKey( const Vector3& position )
+{
+	ChunkCoords cc = GetChunkCoordsFromWorldCoordsXY( WorldCoordsXY( position.x, position.y ) );
+	return ( (unsigned long long)(unsigned int)cc.x << 32 ) | (unsigned int)cc.y;
+}
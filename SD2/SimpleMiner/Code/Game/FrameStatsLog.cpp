@@ -0,0 +1,77 @@
+#include "Game/FrameStatsLog.hpp"
+
+
+#include "Game/GameCommon.hpp"
+#include "Engine/Renderer/TheRenderer.hpp"
+#include "Engine/Error/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool FrameStatsLog::Open( const std::string& filePath )
+{
+	Close();
+
+	errno_t err = fopen_s( &m_file, filePath.c_str(), "w" );
+	if ( err != 0 || m_file == nullptr )
+	{
+		DebuggerPrintf( "FrameStatsLog failed to open %s.\n", filePath.c_str() );
+		m_file = nullptr;
+		return false;
+	}
+
+	const std::string jsonExtension = ".json";
+	m_isJson = ( filePath.size() >= jsonExtension.size() ) && ( filePath.compare( filePath.size() - jsonExtension.size(), jsonExtension.size(), jsonExtension ) == 0 );
+	m_filePath = filePath;
+	m_numFramesWritten = 0;
+
+	if ( m_isJson )
+		fprintf( m_file, "[\n" );
+	else
+		fprintf( m_file, "frame,frameMs,drawCalls,vertexes,vboBytesUploaded,buffersCreated,buffersDestroyed,textureBinds,stateChanges,stateChangesSkipped,"
+						 "chunksRendered,chunksCulled,chunksOccluded,chunksMeshed,chunksActivated,chunksFlushed,lightingNodesProcessed\n" );
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void FrameStatsLog::Close()
+{
+	if ( m_file == nullptr )
+		return;
+
+	if ( m_isJson )
+		fprintf( m_file, "\n]\n" );
+
+	fclose( m_file );
+	m_file = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void FrameStatsLog::WriteFrame( float frameSeconds, const RenderFrameStats& renderStats )
+{
+	if ( m_file == nullptr )
+		return;
+
+	float frameMs = frameSeconds * 1000.f;
+
+	if ( m_isJson )
+	{
+		fprintf( m_file, "%s\t{ \"frame\": %u, \"frameMs\": %.3f, \"drawCalls\": %u, \"vertexes\": %u, \"vboBytesUploaded\": %u, \"buffersCreated\": %u, \"buffersDestroyed\": %u, "
+						 "\"textureBinds\": %u, \"stateChanges\": %u, \"stateChangesSkipped\": %u, "
+						 "\"chunksRendered\": %i, \"chunksCulled\": %i, \"chunksOccluded\": %i, \"chunksMeshed\": %i, \"chunksActivated\": %i, \"chunksFlushed\": %i, \"lightingNodesProcessed\": %i }",
+				 ( m_numFramesWritten > 0 ) ? ",\n" : "",
+				 m_numFramesWritten, frameMs, renderStats.m_numDrawCalls, renderStats.m_numVertexesSubmitted, renderStats.m_numVboBytesUploaded, renderStats.m_numBuffersCreated, renderStats.m_numBuffersDestroyed,
+				 renderStats.m_numTextureBinds, renderStats.m_numStateChanges, renderStats.m_numStateChangesSkipped,
+				 g_chunksRendered, g_chunksCulled, g_chunksOccluded, g_chunksMeshed, g_chunksActivated, g_chunksFlushed, g_lightingNodesProcessed );
+	}
+	else
+	{
+		fprintf( m_file, "%u,%.3f,%u,%u,%u,%u,%u,%u,%u,%u,%i,%i,%i,%i,%i,%i,%i\n",
+				 m_numFramesWritten, frameMs, renderStats.m_numDrawCalls, renderStats.m_numVertexesSubmitted, renderStats.m_numVboBytesUploaded, renderStats.m_numBuffersCreated, renderStats.m_numBuffersDestroyed,
+				 renderStats.m_numTextureBinds, renderStats.m_numStateChanges, renderStats.m_numStateChangesSkipped,
+				 g_chunksRendered, g_chunksCulled, g_chunksOccluded, g_chunksMeshed, g_chunksActivated, g_chunksFlushed, g_lightingNodesProcessed );
+	}
+
+	++m_numFramesWritten;
+}
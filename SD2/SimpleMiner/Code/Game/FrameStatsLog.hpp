@@ -0,0 +1,36 @@
+#pragma once
+
+
+#include <stdio.h>
+#include <string>
+
+
+//-----------------------------------------------------------------------------
+struct RenderFrameStats;
+
+
+//-----------------------------------------------------------------------------
+//Streams one row of per-frame counters to a file while open, for lining frame time spikes up with what caused them offline.
+//A path ending in .json gets a JSON array of one object per frame, anything else gets CSV with a header row.
+class FrameStatsLog
+{
+public:
+
+	FrameStatsLog() : m_file( nullptr ), m_isJson( false ), m_numFramesWritten( 0 ) {}
+	~FrameStatsLog() { Close(); }
+
+	bool Open( const std::string& filePath ); //Truncates any file already there.
+	void Close();
+	inline bool IsOpen() const { return m_file != nullptr; }
+	inline const std::string& GetFilePath() const { return m_filePath; }
+
+	void WriteFrame( float frameSeconds, const RenderFrameStats& renderStats ); //World counters come from GameCommon's globals.
+
+
+private:
+
+	FILE* m_file;
+	std::string m_filePath;
+	bool m_isJson;
+	unsigned int m_numFramesWritten;
+};
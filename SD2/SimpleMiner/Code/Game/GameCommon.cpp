@@ -1,8 +1,11 @@
 #include "Game/GameCommon.hpp"
 
+#include <stdio.h>
 #include "Game/Chunk.hpp"
 #include "Engine/Renderer/TheRenderer.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
+#include "Engine/FileUtils/FileUtils.hpp"
+#include "Engine/Error/ErrorWarningAssert.hpp"
 
 //--------------------------------------------------------------------------------------------------------------
 //Externed Variables' Definitions
@@ -22,7 +25,17 @@ bool g_renderSkyBlocksAsDebugPoints = false; //If you'd like to test debug point
 bool g_colorizeLightLevels = false; //See GetLightColorForLightLevel for values.
 bool g_useNightLightLevel = false;
 int g_chunksRendered = 0;
+int g_chunksCulled = 0;
+bool g_useOcclusionCulling = true;
+int g_chunksOccluded = 0;
+bool g_renderLodTerrain = true;
+int g_lodTilesRendered = 0;
+int g_chunksMeshed = 0;
+int g_chunksActivated = 0;
+int g_chunksFlushed = 0;
+int g_lightingNodesProcessed = 0;
 bool g_generateVillages = true;
+unsigned int g_worldSeed = 0;
 
 CameraMode g_currentCameraMode = FIRST_PERSON;
 MovementMode g_currentMovementMode = NOCLIP;
@@ -38,7 +51,12 @@ char KEY_TO_TOGGLE_PLAYER_COLLIDER = 'B';
 char KEY_TO_TOGGLE_MOVEMENT_MODE = 'P';
 char KEY_TO_TOGGLE_VBO_AND_VA = VK_F8;
 char KEY_TO_TOGGLE_CULLING = VK_F9;
+char KEY_TO_TOGGLE_OCCLUSION_CULLING = 'O';
+char KEY_TO_TOGGLE_LOD_TERRAIN = 'L';
+char KEY_TO_TOGGLE_FRAME_STATS_LOG = 'K';
+char KEY_TO_EXPORT_PROFILER_TRACE = 'T';
 char KEY_TO_TOGGLE_DIMENSION = 'N'; //N for Nether!
+char KEY_TO_DETONATE_AT_SELECTION = 'E'; //Exercises WorldEdit's bulk commit.
 
 const SpriteSheet* g_textureAtlas;
 
@@ -145,4 +163,99 @@ const char* GetDimensionAsString(Dimension dimension)
 		case DIM_NETHER: return "Nether";
 		default: return "UnnamedDimension";
 	}
-}
\ No newline at end of file
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+BlockFace GetBlockFaceFromDirectionOppositeFace( const Vector3& directionOppositeFace )
+{
+	if ( directionOppositeFace == WORLD_UP ) 
+		return BOTTOM;
+	else if ( directionOppositeFace == WORLD_DOWN ) 
+		return TOP;
+	else if ( directionOppositeFace == WORLD_LEFT ) 
+		return RIGHT;
+	else if ( directionOppositeFace == WORLD_RIGHT ) 
+		return LEFT;
+	else if ( directionOppositeFace == WORLD_FORWARD ) 
+		return BACK;
+	else if ( directionOppositeFace == WORLD_BACKWARD ) 
+		return FRONT;
+
+	return NONE;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static void AppendUintToBuffer( unsigned int value, std::vector< unsigned char >& out_buffer )
+{
+	for ( int byteIndex = 0; byteIndex < 4; byteIndex++ )
+		out_buffer.push_back( (unsigned char)( ( value >> ( byteIndex * 8 ) ) & 0xFF ) );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static unsigned int ReadUintFromBuffer( const std::vector< unsigned char >& buffer, int startIndex )
+{
+	unsigned int value = 0;
+	for ( int byteIndex = 0; byteIndex < 4; byteIndex++ )
+		value |= ( (unsigned int)buffer[ startIndex + byteIndex ] ) << ( byteIndex * 8 );
+	return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool LoadWorldInfoFile()
+{
+	std::vector< unsigned char > worldInfoBuffer;
+	bool fileOperationSuccess = LoadBinaryFileIntoBuffer( WORLD_INFO_FILE_PATH, worldInfoBuffer );
+	if ( !fileOperationSuccess || ( worldInfoBuffer.size() < 8 ) )
+		return false;
+
+	unsigned int savedGeneratorVersion = ReadUintFromBuffer( worldInfoBuffer, 0 );
+	unsigned int savedSeed = ReadUintFromBuffer( worldInfoBuffer, 4 );
+
+	if ( savedSeed != g_worldSeed )
+		DebuggerPrintf( "World save uses seed %u, ignoring requested seed %u.\n", savedSeed, g_worldSeed );
+	g_worldSeed = savedSeed; //Saved chunks only line up with new ones generated under the same seed.
+
+	if ( savedGeneratorVersion != WORLD_GENERATOR_VERSION ) //Saved chunks keep their blocks, but new chunks next to them may not line up.
+		DebuggerPrintf( "World save is from generator version %u, current is %u; expect seams at saved chunk borders.\n", savedGeneratorVersion, WORLD_GENERATOR_VERSION );
+
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void LoadOrCreateWorldInfoFile()
+{
+	if ( !LoadWorldInfoFile() && !g_disableSaving )
+		SaveWorldInfoFile(); //New world, so record the seed it starts with before any chunk gets saved under it.
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void SaveWorldInfoFile()
+{
+	std::vector< unsigned char > worldInfoBuffer;
+	AppendUintToBuffer( WORLD_GENERATOR_VERSION, worldInfoBuffer );
+	AppendUintToBuffer( g_worldSeed, worldInfoBuffer );
+	SaveBufferToBinaryFile( WORLD_INFO_FILE_PATH, worldInfoBuffer );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void ReportHeadlessResult( const std::string& resultText )
+{
+	DebuggerPrintf( "%s\n", resultText.c_str() );
+	printf( "%s\n", resultText.c_str() );
+	fflush( stdout ); //Else it can sit buffered until exit, or be lost if the run crashes.
+
+	FILE* file = nullptr;
+	errno_t err = fopen_s( &file, HEADLESS_RESULTS_FILE_PATH, "a" );
+	if ( err != 0 || file == nullptr )
+		return;
+
+	fprintf( file, "%s\n", resultText.c_str() );
+	fclose( file );
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 #include "Engine/Renderer/Vertexes.hpp"
 #include "Engine/Math/Vector2.hpp"
@@ -51,7 +52,17 @@ extern bool g_renderSkyBlocksAsDebugPoints; //If you'd like to test debug points
 extern bool g_colorizeLightLevels; //See GetLightColorForLightLevel for values.
 extern bool g_useNightLightLevel;
 extern int g_chunksRendered;
+extern int g_chunksCulled;
+extern bool g_useOcclusionCulling;
+extern int g_chunksOccluded;
+extern bool g_renderLodTerrain;
+extern int g_lodTilesRendered;
+extern int g_chunksMeshed; //Per frame, like the counts above. See also TheRenderer::GetFrameStats.
+extern int g_chunksActivated;
+extern int g_chunksFlushed;
+extern int g_lightingNodesProcessed;
 extern bool g_generateVillages;
+extern unsigned int g_worldSeed; //0 is the original unseeded world. Must be settled before any chunk generates, see LoadOrCreateWorldInfoFile.
 
 //Toggling back and forth WILL cause some chunks to become and STAY dirty until updated (usually by player raycast dirtying VAO), hence it's just for debug.
 extern char KEY_TO_TOGGLE_DEBUG_INFO;
@@ -65,7 +76,12 @@ extern char KEY_TO_TOGGLE_SKY_DEBUG;
 extern char KEY_TO_TOGGLE_MOVEMENT_MODE;
 extern char KEY_TO_TOGGLE_VBO_AND_VA;
 extern char KEY_TO_TOGGLE_CULLING;
+extern char KEY_TO_TOGGLE_OCCLUSION_CULLING;
+extern char KEY_TO_TOGGLE_LOD_TERRAIN;
+extern char KEY_TO_TOGGLE_FRAME_STATS_LOG;
+extern char KEY_TO_EXPORT_PROFILER_TRACE;
 extern char KEY_TO_TOGGLE_DIMENSION;
+extern char KEY_TO_DETONATE_AT_SELECTION;
 
 //Old Debug Render Commands (use Engine/Rendering/RenderCommand now).
 extern std::vector< Vertex3D_PCT > g_debugPoints;
@@ -77,7 +93,7 @@ void DrawDebugPoints( float pointSize, bool enableDepthTesting );
 
 static const int VILLAGE_RADIUS_Y_BLOCKS = 9; //Doesn't include center.
 static const int VILLAGE_RADIUS_X_BLOCKS = 9; //Doesn't include center.
-static const int VILLAGE_NUM_CHUNKS_TO_LOOK_FOR_VILLAGE = 5;
+static const int VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS = 64; //Villages are found and built once per cell this wide, see StructureRegistry.
 static const float VILLAGE_PERLIN_GRID_CELL_SIZE = 200.f;
 static const int VILLAGE_PERLIN_GRID_NUM_OCTAVES = 1;
 static const float VILLAGE_PERLIN_AMPLITUDE = 1.f;
@@ -121,8 +137,13 @@ static const char KEY_TO_MOVE_RIGHT = 'D';
 static const char KEY_TO_MOVE_UP = VK_SPACE;
 static const char KEY_TO_MOVE_DOWN = 'X'; //Be careful, also mutes BGM from Main_Win32.
 
+static const float SIMULATION_TICKS_PER_SECOND = 60.f;
+static const float SIMULATION_SECONDS_PER_TICK = 1.f / SIMULATION_TICKS_PER_SECOND;
+static const int SIMULATION_MAX_CATCH_UP_TICKS_PER_FRAME = 5; //Past this a hitch's remaining time is dropped, not simulated.
+
 static const int RAYCAST_NUM_STEPS = 1000; //For step and sample.
 static const float LENGTH_OF_SELECTION_RAYCAST = 8.f; //World units.
+static const unsigned int RAYCAST_BATCH_MIN_RAYS_PER_WORKER = 64; //World::RaycastBatch won't split a batch finer than this across threads.
 
 enum CameraMode : unsigned int { FIRST_PERSON = 0, FROM_BEHIND, FIXED_SPECTATOR, FREE_SPECTATOR, NUM_CAMERA_MODES };
 extern CameraMode g_currentCameraMode;
@@ -130,6 +151,15 @@ extern CameraMode g_currentCameraMode;
 enum MovementMode : unsigned int { WALKING = 0, FLYING, NOCLIP, NUM_MOVEMENT_MODES };
 extern MovementMode g_currentMovementMode;
 
+//-----------------------------------------------------------------------------
+//Entities
+static const int ENTITY_AWAKE_RADIUS_IN_CHUNKS = 6; //Chebyshev distance from the player's chunk, beyond which entities sleep in place.
+static const float ENTITY_GRAVITY_FORCE = PLAYER_GRAVITY_FORCE;
+static const float ENTITY_GROUND_FRICTION = .8f; //Horizontal velocity kept per tick on the ground.
+static const float ENTITY_DROPPED_ITEM_LIFETIME_SECONDS = 300.f;
+static const int ENTITY_BENCHMARK_CHUNK_RADIUS = 4; //Of the chunks generated around the origin for -entitybench.
+static const int ENTITY_BENCHMARK_NUM_TICKS = 600;
+
 //-----------------------------------------------------------------------------
 //Audio
 typedef unsigned int SoundID;
@@ -147,6 +177,7 @@ static const int GLOWSTONE_LIGHT_LEVEL = GetMax( 0, ( ( 3 * MAX_LIGHTING_LEVEL )
 
 extern const SpriteSheet* g_textureAtlas;
 static const int NUMBER_DIG_DAMAGE_FRAMES = 10;
+static const unsigned char TRANSLUCENT_BLOCK_ALPHA = 160; //Vertex alpha for BlockDefinition::IsTranslucent blocks, e.g. water.
 
 //-----------------------------------------------------------------------------
 //Chunk and block and dimension initialization.
@@ -158,8 +189,22 @@ enum BlockType : unsigned char {
 	NUM_BLOCK_TYPES };
 enum BlockFace { NONE = -1, BOTTOM = 0, TOP, LEFT, RIGHT, FRONT, BACK, NUM_FACES };
 
+static const unsigned int BLOCK_TICKS_BUDGET_PER_TICK = 256; //Scheduled block updates run per simulation tick, the rest wait, so floods slow down instead of frames.
+static const unsigned int BLOCK_TICK_DELAY_WATER = 5; //Simulation ticks between a fluid block changing and it spreading.
+static const unsigned int BLOCK_TICK_DELAY_LAVA = 30;
+static const unsigned int BLOCK_TICK_DELAY_FALLING = 2; //Before unsupported sand or gravel starts to fall.
+static const int FLUID_MAX_LEVEL_WATER = 7; //Blocks a flow reaches across flat ground from its source.
+static const int FLUID_MAX_LEVEL_LAVA = 3;
+static const int RANDOM_TICKS_PER_SECTION_PER_TICK = 1; //Random blocks updated per non-air chunk section each simulation tick, for ambient changes like grass spreading.
+static const int DETONATION_RADIUS_IN_BLOCKS = 4; //Of the crater KEY_TO_DETONATE_AT_SELECTION blasts, about a TNT's.
+static const int GRASS_SPREAD_MIN_LIGHT_LEVEL = ( MAX_LIGHTING_LEVEL / 2 ) + 2; //Of the block above the dirt being spread onto, 9 for max 15.
+
 static const int INITIAL_ACTIVE_RADIUS = 128; //World units.
 static const int INITIAL_FLUSH_RADIUS = 144;
+static const float LOD_HORIZON_RADIUS = 512.f; //World units. LodTerrain fills in past the active radius out to here.
+static const float LOD_LEVEL_2_START_DISTANCE = 256.f; //2x2-block cells inside this, 4x4 beyond.
+static const float LOD_SKIRT_DEPTH_IN_BLOCKS = 16.f;
+static const unsigned int LOD_TILES_TO_BUILD_PER_FRAME = 16;
 
 static const int CHUNK_BITS_X = 4;
 static const int CHUNK_BITS_Y = 4;
@@ -172,6 +217,12 @@ static const int NUM_BLOCKS_PER_CHUNK = NUM_COLUMNS_PER_CHUNK * CHUNK_Z_HEIGHT_I
 static const int BITS_PER_XY_LAYER = CHUNK_BITS_X + CHUNK_BITS_Y;
 static const int LOCAL_X_BITMASK = CHUNK_X_LENGTH_IN_BLOCKS - 1; //Lowest chunk_x_length-1 bits.
 static const int LOCAL_Y_BITMASK = CHUNK_Y_WIDTH_IN_BLOCKS - 1;
+static const int LOCAL_Y_BITMASK_IN_INDEX = LOCAL_Y_BITMASK << CHUNK_BITS_X; //Pre-shifted, to test a LocalBlockIndex without unpacking it.
+static const int SECTION_BITS_Z = 4; //Sections are 16^3, stacked along z, for occlusion culling.
+static const int SECTION_HEIGHT_IN_BLOCKS = BIT( SECTION_BITS_Z );
+static const int NUM_SECTIONS_PER_CHUNK = BIT( CHUNK_BITS_Z - SECTION_BITS_Z );
+static const int NUM_BLOCKS_PER_SECTION = NUM_COLUMNS_PER_CHUNK * SECTION_HEIGHT_IN_BLOCKS;
+static const int BITS_PER_SECTION = BITS_PER_XY_LAYER + SECTION_BITS_Z; //LocalBlockIndex >> this gives its section.
 
 enum Dimension { DIM_OVERWORLD, DIM_NETHER, NUM_DIMENSIONS };
 
@@ -180,12 +231,19 @@ static const int GROUND_HEIGHT_PERLIN_NUM_OCTAVES = 5;
 static const float GROUND_HEIGHT_PERLIN_PERSISTANCE_PERCENTAGE = .60f;
 static const float GROUND_HEIGHT_PERLIN_AMPLITUDE = 50;
 static const int GROUND_HEIGHT_MINIMUM = 64;
+static const unsigned int GROUND_HEIGHT_CACHE_MAX_TILES = 8192; //Chunk-sized tiles, ~1KB each. Covers the LOD horizon plus both dimensions' active radii and village search.
 static const float CEILING_HEIGHT_PERLIN_GRID_CELL_SIZE = 200.f;
 static const int CEILING_HEIGHT_PERLIN_NUM_OCTAVES = 3;
 static const float CEILING_HEIGHT_PERLIN_PERSISTANCE_PERCENTAGE = .75f;
 static const int CEILING_HEIGHT_PERLIN_AMPLITUDE = 50;
 static const int CEILING_HEIGHT_OFFSET = 100;
 
+static const unsigned int WORLD_GENERATOR_VERSION = 2; //Bump whenever generation changes so old saves can tell. 1: per-chunk village search, 2: StructureRegistry.
+static const char* WORLD_INFO_FILE_PATH = "Data/Saves/World.dat"; //Generator version then seed, each as 4 little-endian bytes.
+static const char* PROFILER_TRACE_FILE_PATH = "Data/ProfilerTrace.json"; //Open in chrome://tracing.
+static const char* FRAME_STATS_LOG_FILE_PATH = "Data/FrameStats.csv"; //End it in .json for JSON instead, see FrameStatsLog.
+static const char* HEADLESS_RESULTS_FILE_PATH = "Data/HeadlessResults.txt"; //Appended to by -pregen and -entitybench runs.
+
 static const int NUM_DIRT_LAYERS = 6; //Between grass and stone, not including the grass layer.
 static const int SEA_LEVEL_HEIGHT_LIMIT = CHUNK_Z_HEIGHT_IN_BLOCKS / 2; //preserves z=64 for a max z=128.
 static const int NETHER_LAVA_HEIGHT_LIMIT = CHUNK_Z_HEIGHT_IN_BLOCKS / 4; //Not speed-critical divisions here.
@@ -264,6 +322,11 @@ inline LocalBlockIndex GetLocalBlockIndexFromLocalBlockCoords( const LocalBlockC
 //Primarily for use from the VS debugger watch window, hence no inline.
 ChunkCoords GetChunkCoordsFromWorldCoordsXY( const WorldCoordsXY& wc ); //Needed by both World and Chunk classes.
 const char* GetDimensionAsString( Dimension dimension );
+BlockFace GetBlockFaceFromDirectionOppositeFace( const Vector3& directionOppositeFace ); //i.e. from a surface normal, NONE if not axis-aligned.
+bool LoadWorldInfoFile(); //Adopts a saved world's seed over g_worldSeed. False, and nothing written, if there's no save.
+void LoadOrCreateWorldInfoFile(); //As above, else saves g_worldSeed as the new world's.
+void ReportHeadlessResult( const std::string& resultText ); //To stdout and HEADLESS_RESULTS_FILE_PATH too, as a windowless run has no debugger output.
+void SaveWorldInfoFile();
 LocalBlockCoords GetLocalBlockCoordsFromLocalBlockIndexNoBitMath( LocalBlockIndex lbi );
 LocalBlockIndex GetLocalBlockIndexFromLocalBlockCoordsNoBitMath( const LocalBlockCoords& lbc );
 GlobalBlockCoords GetGlobalBlockCoordsFromChunkAndLocalBlockIndex( const Chunk* chunkOfBlock, LocalBlockIndex blockIndexInChunk );
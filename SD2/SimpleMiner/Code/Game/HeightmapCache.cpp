@@ -0,0 +1,93 @@
+#include "Game/HeightmapCache.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+HeightmapCache::HeightmapCache( HeightmapTileGenerator tileGenerator, unsigned int maxNumTiles )
+	: m_tileGenerator( tileGenerator )
+	, m_maxNumTiles( maxNumTiles )
+	, m_numTilesGenerated( 0 )
+{
+	ASSERT_OR_DIE( m_tileGenerator != nullptr, "HeightmapCache Given Null Tile Generator" );
+	ASSERT_OR_DIE( m_maxNumTiles > 0, "HeightmapCache Given Zero Capacity" );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+int HeightmapCache::GetColumnHeight( Dimension dimension, const GlobalColumnCoords& globalColumnCoords )
+{
+	ChunkCoords tileCoords = GetChunkCoordsFromWorldCoordsXY( globalColumnCoords );
+
+	int localX = (int)floor( globalColumnCoords.x ) - ( tileCoords.x * CHUNK_X_LENGTH_IN_BLOCKS );
+	int localY = (int)floor( globalColumnCoords.y ) - ( tileCoords.y * CHUNK_Y_WIDTH_IN_BLOCKS );
+	ChunkColumnIndex columnIndex = localX | ( localY << CHUNK_BITS_X );
+
+	std::unique_lock< std::mutex > tilesLock( m_tilesMutex );
+	return FindOrGenerateTile( TileKey( dimension, tileCoords ), tilesLock )->m_columnHeights[ columnIndex ];
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void HeightmapCache::GetTileHeights( Dimension dimension, const ChunkCoords& tileCoords, int out_columnHeights[ NUM_COLUMNS_PER_CHUNK ] )
+{
+	std::unique_lock< std::mutex > tilesLock( m_tilesMutex );
+	const HeightmapTile* tile = FindOrGenerateTile( TileKey( dimension, tileCoords ), tilesLock );
+
+	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
+		out_columnHeights[ columnIndex ] = tile->m_columnHeights[ columnIndex ];
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+const HeightmapCache::HeightmapTile* HeightmapCache::FindOrGenerateTile( const TileKey& key, std::unique_lock< std::mutex >& tilesLock )
+{
+	const HeightmapTile* cachedTile = FindTileAndMarkUsed( key );
+	if ( cachedTile != nullptr )
+		return cachedTile;
+
+	//Generate without the lock so other threads' hits aren't stuck behind the noise evaluation.
+	tilesLock.unlock();
+	int generatedHeights[ NUM_COLUMNS_PER_CHUNK ];
+	m_tileGenerator( key.first, key.second, generatedHeights );
+	tilesLock.lock();
+
+	return InsertTileAndEvictOldest( key, generatedHeights );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+const HeightmapCache::HeightmapTile* HeightmapCache::FindTileAndMarkUsed( const TileKey& key )
+{
+	std::map< TileKey, HeightmapTile >::iterator found = m_tiles.find( key );
+	if ( found == m_tiles.end() )
+		return nullptr;
+
+	m_leastRecentlyUsedOrder.splice( m_leastRecentlyUsedOrder.begin(), m_leastRecentlyUsedOrder, found->second.m_lruPosition );
+	return &found->second;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+const HeightmapCache::HeightmapTile* HeightmapCache::InsertTileAndEvictOldest( const TileKey& key, const int columnHeights[ NUM_COLUMNS_PER_CHUNK ] )
+{
+	++m_numTilesGenerated;
+
+	//Another thread may have generated the same tile while we were unlocked, in which case the results are identical anyway.
+	const HeightmapTile* racedTile = FindTileAndMarkUsed( key );
+	if ( racedTile != nullptr )
+		return racedTile;
+
+	while ( m_tiles.size() >= m_maxNumTiles )
+	{
+		m_tiles.erase( m_leastRecentlyUsedOrder.back() );
+		m_leastRecentlyUsedOrder.pop_back();
+	}
+
+	HeightmapTile& newTile = m_tiles[ key ];
+	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
+		newTile.m_columnHeights[ columnIndex ] = columnHeights[ columnIndex ];
+
+	m_leastRecentlyUsedOrder.push_front( key );
+	newTile.m_lruPosition = m_leastRecentlyUsedOrder.begin();
+
+	return &newTile;
+}
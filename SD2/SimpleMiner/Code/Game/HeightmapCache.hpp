@@ -0,0 +1,52 @@
+#pragma once
+
+
+#include <map>
+#include <list>
+#include <mutex>
+
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Fills all of a tile's column heights at once, row-major by ChunkColumnIndex. Must be safe to call from any thread.
+typedef void ( *HeightmapTileGenerator )( Dimension dimension, const ChunkCoords& tileCoords, int out_columnHeights[ NUM_COLUMNS_PER_CHUNK ] );
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Thread-safe LRU cache of chunk-sized heightmap tiles, so terrain and structure generation
+//only evaluates the noise once per column no matter how many chunks or structures ask for it.
+class HeightmapCache
+{
+public:
+
+	HeightmapCache( HeightmapTileGenerator tileGenerator, unsigned int maxNumTiles );
+
+	int GetColumnHeight( Dimension dimension, const GlobalColumnCoords& globalColumnCoords );
+	void GetTileHeights( Dimension dimension, const ChunkCoords& tileCoords, int out_columnHeights[ NUM_COLUMNS_PER_CHUNK ] );
+
+	unsigned int GetNumTilesGenerated() const { return m_numTilesGenerated; }
+
+
+private:
+
+	typedef std::pair< Dimension, ChunkCoords > TileKey;
+	struct HeightmapTile
+	{
+		int m_columnHeights[ NUM_COLUMNS_PER_CHUNK ];
+		std::list< TileKey >::iterator m_lruPosition;
+	};
+
+	//Both expect m_tilesMutex to already be held.
+	const HeightmapTile* FindTileAndMarkUsed( const TileKey& key );
+	const HeightmapTile* InsertTileAndEvictOldest( const TileKey& key, const int columnHeights[ NUM_COLUMNS_PER_CHUNK ] );
+
+	const HeightmapTile* FindOrGenerateTile( const TileKey& key, std::unique_lock< std::mutex >& tilesLock );
+
+	HeightmapTileGenerator m_tileGenerator;
+	unsigned int m_maxNumTiles;
+	unsigned int m_numTilesGenerated; //Includes regenerations after eviction, handy for checking the hit rate.
+	std::map< TileKey, HeightmapTile > m_tiles;
+	std::list< TileKey > m_leastRecentlyUsedOrder; //Front is most recent.
+	std::mutex m_tilesMutex;
+};
@@ -0,0 +1,275 @@
+#include "Game/LodTerrain.hpp"
+
+
+#include <algorithm>
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Renderer/TheRenderer.hpp"
+#include "Game/BlockDefinition.hpp"
+#include "Game/Chunk.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+LodTerrain::LodTerrain()
+	: m_tilesDimension( DIM_OVERWORLD )
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+LodTerrain::~LodTerrain()
+{
+	FreeAllTiles();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC int LodTerrain::GetDesiredLodLevel( float distanceToTileCenter )
+{
+	return ( distanceToTileCenter < LOD_LEVEL_2_START_DISTANCE ) ? 1 : 2;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC float LodTerrain::GetDistanceToTileCenter( const WorldCoords& playerPosition, const ChunkCoords& tileCoords )
+{
+	float tileCenterX = ( tileCoords.x + .5f ) * CHUNK_X_LENGTH_IN_BLOCKS;
+	float tileCenterY = ( tileCoords.y + .5f ) * CHUNK_Y_WIDTH_IN_BLOCKS;
+	return WorldCoordsXY( tileCenterX - playerPosition.x, tileCenterY - playerPosition.y ).CalcLength();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC bool LodTerrain::DoesChunkCoverTile( const std::map< ChunkCoords, Chunk* >& activeChunks, const ChunkCoords& tileCoords )
+{
+	std::map< ChunkCoords, Chunk* >::const_iterator chunkIter = activeChunks.find( tileCoords );
+	return ( chunkIter != activeChunks.end() ) && !chunkIter->second->IsDirty(); //Keep the tile until the chunk has a mesh to replace it.
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void LodTerrain::Update( Dimension activeDimension, int skyLightLevel, const WorldCoords& playerPosition, const std::map< ChunkCoords, Chunk* >& activeChunks )
+{
+	if ( g_theRenderer == nullptr )
+		return;
+
+	if ( activeDimension != m_tilesDimension )
+	{
+		FreeAllTiles();
+		m_tilesDimension = activeDimension;
+	}
+
+	if ( ( activeDimension != DIM_OVERWORLD ) || !g_renderLodTerrain )
+	{
+		FreeAllTiles(); //The nether's ceiling hides any horizon anyway.
+		return;
+	}
+
+	//Drop tiles now past the horizon or under a real chunk.
+	for ( std::map< ChunkCoords, LodTile >::iterator tileIter = m_tiles.begin(); tileIter != m_tiles.end(); )
+	{
+		if ( ( GetDistanceToTileCenter( playerPosition, tileIter->first ) > LOD_HORIZON_RADIUS ) || DoesChunkCoverTile( activeChunks, tileIter->first ) )
+		{
+			FreeTile( tileIter->second );
+			tileIter = m_tiles.erase( tileIter );
+		}
+		else ++tileIter;
+	}
+
+	//Gather tiles missing, at the wrong LOD or lit for another sky level, then build only the nearest few this frame.
+	std::vector< std::pair< float, ChunkCoords > > tilesToBuild;
+	ChunkCoords playerChunkCoords = GetChunkCoordsFromWorldCoordsXY( WorldCoordsXY( playerPosition.x, playerPosition.y ) );
+	const int horizonRadiusInChunks = ( (int)LOD_HORIZON_RADIUS / CHUNK_X_LENGTH_IN_BLOCKS ) + 1;
+	for ( int offsetY = -horizonRadiusInChunks; offsetY <= horizonRadiusInChunks; offsetY++ )
+	{
+		for ( int offsetX = -horizonRadiusInChunks; offsetX <= horizonRadiusInChunks; offsetX++ )
+		{
+			ChunkCoords tileCoords = ChunkCoords( playerChunkCoords.x + offsetX, playerChunkCoords.y + offsetY );
+			float distanceToTileCenter = GetDistanceToTileCenter( playerPosition, tileCoords );
+			if ( distanceToTileCenter > LOD_HORIZON_RADIUS )
+				continue;
+
+			if ( DoesChunkCoverTile( activeChunks, tileCoords ) )
+				continue;
+
+			std::map< ChunkCoords, LodTile >::const_iterator tileIter = m_tiles.find( tileCoords );
+			if ( ( tileIter == m_tiles.end() ) || ( tileIter->second.m_lodLevel != GetDesiredLodLevel( distanceToTileCenter ) ) || ( tileIter->second.m_skyLightLevel != skyLightLevel ) )
+				tilesToBuild.push_back( std::pair< float, ChunkCoords >( distanceToTileCenter, tileCoords ) );
+		}
+	}
+
+	unsigned int numTilesToBuild = GetMin( (unsigned int)tilesToBuild.size(), LOD_TILES_TO_BUILD_PER_FRAME );
+	std::partial_sort( tilesToBuild.begin(), tilesToBuild.begin() + numTilesToBuild, tilesToBuild.end(),
+		[]( const std::pair< float, ChunkCoords >& lhs, const std::pair< float, ChunkCoords >& rhs ) { return lhs.first < rhs.first; } );
+
+	for ( unsigned int buildIndex = 0; buildIndex < numTilesToBuild; buildIndex++ )
+		BuildTile( tilesToBuild[ buildIndex ].second, GetDesiredLodLevel( tilesToBuild[ buildIndex ].first ), skyLightLevel );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static void AddLodFace( BlockFace face, const AABB3& bounds, const AABB2& texCoords, const Rgba& lightColor, std::vector< Vertex3D_PCT >& out_vertexes )
+{
+	//Same corner order and winding as Chunk::AddBlockToVertexArray's faces.
+	Vector3 corners[ 4 ];
+	switch ( face )
+	{
+		case TOP:
+			corners[ 0 ] = Vector3( bounds.mins.x, bounds.maxs.y, bounds.maxs.z );
+			corners[ 1 ] = Vector3( bounds.mins.x, bounds.mins.y, bounds.maxs.z );
+			corners[ 2 ] = Vector3( bounds.maxs.x, bounds.mins.y, bounds.maxs.z );
+			corners[ 3 ] = Vector3( bounds.maxs.x, bounds.maxs.y, bounds.maxs.z );
+			break;
+		case LEFT: //+y.
+			corners[ 0 ] = Vector3( bounds.maxs.x, bounds.maxs.y, bounds.mins.z );
+			corners[ 1 ] = Vector3( bounds.mins.x, bounds.maxs.y, bounds.mins.z );
+			corners[ 2 ] = Vector3( bounds.mins.x, bounds.maxs.y, bounds.maxs.z );
+			corners[ 3 ] = Vector3( bounds.maxs.x, bounds.maxs.y, bounds.maxs.z );
+			break;
+		case RIGHT: //-y.
+			corners[ 0 ] = Vector3( bounds.mins.x, bounds.mins.y, bounds.mins.z );
+			corners[ 1 ] = Vector3( bounds.maxs.x, bounds.mins.y, bounds.mins.z );
+			corners[ 2 ] = Vector3( bounds.maxs.x, bounds.mins.y, bounds.maxs.z );
+			corners[ 3 ] = Vector3( bounds.mins.x, bounds.mins.y, bounds.maxs.z );
+			break;
+		case FRONT: //-x.
+			corners[ 0 ] = Vector3( bounds.mins.x, bounds.maxs.y, bounds.mins.z );
+			corners[ 1 ] = Vector3( bounds.mins.x, bounds.mins.y, bounds.mins.z );
+			corners[ 2 ] = Vector3( bounds.mins.x, bounds.mins.y, bounds.maxs.z );
+			corners[ 3 ] = Vector3( bounds.mins.x, bounds.maxs.y, bounds.maxs.z );
+			break;
+		case BACK: //+x.
+			corners[ 0 ] = Vector3( bounds.maxs.x, bounds.mins.y, bounds.mins.z );
+			corners[ 1 ] = Vector3( bounds.maxs.x, bounds.maxs.y, bounds.mins.z );
+			corners[ 2 ] = Vector3( bounds.maxs.x, bounds.maxs.y, bounds.maxs.z );
+			corners[ 3 ] = Vector3( bounds.maxs.x, bounds.mins.y, bounds.maxs.z );
+			break;
+		default: return; //Nothing ever looks at a heightmap's underside.
+	}
+
+	out_vertexes.push_back( Vertex3D_PCT( corners[ 0 ], Vector2( texCoords.mins.x, texCoords.maxs.y ), lightColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( corners[ 1 ], Vector2( texCoords.maxs.x, texCoords.maxs.y ), lightColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( corners[ 2 ], Vector2( texCoords.maxs.x, texCoords.mins.y ), lightColor ) );
+	out_vertexes.push_back( Vertex3D_PCT( corners[ 3 ], Vector2( texCoords.mins.x, texCoords.mins.y ), lightColor ) );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void LodTerrain::BuildTile( const ChunkCoords& tileCoords, int lodLevel, int skyLightLevel )
+{
+	int groundHeights[ NUM_COLUMNS_PER_CHUNK ];
+	Chunk::GetGroundHeightTileWithPerlinNoise( m_tilesDimension, tileCoords, groundHeights );
+
+	//Each cell stands at its tallest column, and takes the surface block that column would get from generation.
+	const int cellSizeInBlocks = BIT( lodLevel );
+	const int cellsPerSide = CHUNK_X_LENGTH_IN_BLOCKS / cellSizeInBlocks;
+	int cellTopZ[ CHUNK_Y_WIDTH_IN_BLOCKS ][ CHUNK_X_LENGTH_IN_BLOCKS ];
+	BlockType cellSurfaceType[ CHUNK_Y_WIDTH_IN_BLOCKS ][ CHUNK_X_LENGTH_IN_BLOCKS ];
+	for ( int cellY = 0; cellY < cellsPerSide; cellY++ )
+	{
+		for ( int cellX = 0; cellX < cellsPerSide; cellX++ )
+		{
+			int maxGroundHeight = 0;
+			for ( int columnY = cellY * cellSizeInBlocks; columnY < ( cellY + 1 ) * cellSizeInBlocks; columnY++ )
+				for ( int columnX = cellX * cellSizeInBlocks; columnX < ( cellX + 1 ) * cellSizeInBlocks; columnX++ )
+					maxGroundHeight = GetMax( maxGroundHeight, groundHeights[ columnX | ( columnY << CHUNK_BITS_X ) ] );
+
+			if ( maxGroundHeight + 1 < SEA_LEVEL_HEIGHT_LIMIT )
+			{
+				cellTopZ[ cellY ][ cellX ] = SEA_LEVEL_HEIGHT_LIMIT;
+				cellSurfaceType[ cellY ][ cellX ] = WATER;
+			}
+			else
+			{
+				cellTopZ[ cellY ][ cellX ] = maxGroundHeight + 1;
+				cellSurfaceType[ cellY ][ cellX ] = ( maxGroundHeight <= SEA_LEVEL_HEIGHT_LIMIT ) ? SAND : GRASS;
+			}
+		}
+	}
+
+	WorldCoordsXY tileMins = WorldCoordsXY( (float)( tileCoords.x * CHUNK_X_LENGTH_IN_BLOCKS ), (float)( tileCoords.y * CHUNK_Y_WIDTH_IN_BLOCKS ) );
+	std::vector< Vertex3D_PCT > vertexes;
+	LodTile tile;
+	tile.m_lodLevel = lodLevel;
+	tile.m_skyLightLevel = skyLightLevel;
+	Rgba lightColor = Chunk::GetLightColorForLightLevel( skyLightLevel ); //Only the open surface is drawn, so sky light is all that reaches it.
+	tile.m_bounds = AABB3( Vector3( tileMins.x, tileMins.y, (float)CHUNK_Z_HEIGHT_IN_BLOCKS ), Vector3( tileMins.x + CHUNK_X_LENGTH_IN_BLOCKS, tileMins.y + CHUNK_Y_WIDTH_IN_BLOCKS, 0.f ) );
+
+	for ( int cellY = 0; cellY < cellsPerSide; cellY++ )
+	{
+		for ( int cellX = 0; cellX < cellsPerSide; cellX++ )
+		{
+			float topZ = (float)cellTopZ[ cellY ][ cellX ];
+			const BlockDefinition& surfaceDefinition = BlockDefinition::s_blockDefinitionRegistry[ cellSurfaceType[ cellY ][ cellX ] ];
+			AABB3 cellBounds = AABB3( Vector3( tileMins.x + ( cellX * cellSizeInBlocks ), tileMins.y + ( cellY * cellSizeInBlocks ), topZ ),
+									  Vector3( tileMins.x + ( ( cellX + 1 ) * cellSizeInBlocks ), tileMins.y + ( ( cellY + 1 ) * cellSizeInBlocks ), topZ ) );
+
+			AddLodFace( TOP, cellBounds, surfaceDefinition.m_texCoordsTop, lightColor, vertexes );
+			tile.m_bounds.mins.z = GetMinFloat( tile.m_bounds.mins.z, topZ - LOD_SKIRT_DEPTH_IN_BLOCKS );
+			tile.m_bounds.maxs.z = GetMaxFloat( tile.m_bounds.maxs.z, topZ );
+
+			//Interior steps only get drawn once, by the taller cell, down to the shorter one.
+			//Border cells skirt down instead, since the tile beside may be lower, coarser, or a chunk.
+			const int neighborOffsets[ 4 ][ 2 ] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+			const BlockFace faceTowardNeighbor[ 4 ] = { BACK, FRONT, LEFT, RIGHT };
+			for ( int neighborIndex = 0; neighborIndex < 4; neighborIndex++ )
+			{
+				int neighborX = cellX + neighborOffsets[ neighborIndex ][ 0 ];
+				int neighborY = cellY + neighborOffsets[ neighborIndex ][ 1 ];
+				bool isOnTileBorder = ( neighborX < 0 ) || ( neighborX >= cellsPerSide ) || ( neighborY < 0 ) || ( neighborY >= cellsPerSide );
+
+				float wallBottomZ = isOnTileBorder ? ( topZ - LOD_SKIRT_DEPTH_IN_BLOCKS ) : (float)cellTopZ[ neighborY ][ neighborX ];
+				if ( wallBottomZ >= topZ )
+					continue;
+
+				AABB3 wallBounds = cellBounds;
+				wallBounds.mins.z = wallBottomZ;
+				AddLodFace( faceTowardNeighbor[ neighborIndex ], wallBounds, surfaceDefinition.m_texCoordsSides, lightColor, vertexes );
+			}
+		}
+	}
+
+	std::map< ChunkCoords, LodTile >::iterator oldTileIter = m_tiles.find( tileCoords );
+	if ( oldTileIter != m_tiles.end() )
+	{
+		tile.m_arenaAllocation = oldTileIter->second.m_arenaAllocation; //Reused in place if the new mesh fits.
+		m_tiles.erase( oldTileIter );
+	}
+
+	tile.m_numVertexes = vertexes.size();
+	g_theRenderer->UpdateArenaVertexes( tile.m_arenaAllocation, vertexes.data(), tile.m_numVertexes );
+	m_tiles[ tileCoords ] = tile;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void LodTerrain::QueueVisibleTiles( const Frustum& viewFrustum ) const
+{
+	g_lodTilesRendered = 0;
+
+	for ( const std::pair< ChunkCoords, LodTile >& tilePair : m_tiles )
+	{
+		const LodTile& tile = tilePair.second;
+		if ( g_useCulling && !viewFrustum.DoesOverlapAABB( tile.m_bounds ) )
+			continue;
+
+		g_theRenderer->QueueArenaDraw( tile.m_arenaAllocation, tile.m_numVertexes );
+		++g_lodTilesRendered;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void LodTerrain::FreeTile( LodTile& tile )
+{
+	if ( g_theRenderer != nullptr )
+		g_theRenderer->FreeArenaVertexes( tile.m_arenaAllocation );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void LodTerrain::FreeAllTiles()
+{
+	for ( std::pair< const ChunkCoords, LodTile >& tilePair : m_tiles )
+		FreeTile( tilePair.second );
+	m_tiles.clear();
+}
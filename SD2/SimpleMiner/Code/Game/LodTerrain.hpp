@@ -0,0 +1,56 @@
+#pragma once
+
+
+#include <map>
+#include <vector>
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Renderer/VertexArena.hpp"
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+class Chunk;
+class Frustum;
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct LodTile
+{
+	int m_lodLevel; //Cells are BIT( m_lodLevel ) blocks across.
+	int m_skyLightLevel; //Baked into the vertex colors, so a change in it means a rebuild.
+	VertexArenaAllocation m_arenaAllocation;
+	unsigned int m_numVertexes;
+	AABB3 m_bounds;
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Coarse top-surface meshes for every chunk-sized tile out to LOD_HORIZON_RADIUS that has no meshed chunk of its own.
+//Built straight from the shared heightmap cache, so no block data is ever generated for them.
+//Each tile's border drops a skirt, hiding the cracks against neighbors of another LOD or against real chunks.
+class LodTerrain
+{
+public:
+
+	LodTerrain();
+	~LodTerrain();
+
+	void Update( Dimension activeDimension, int skyLightLevel, const WorldCoords& playerPosition, const std::map< ChunkCoords, Chunk* >& activeChunks );
+	void QueueVisibleTiles( const Frustum& viewFrustum ) const; //Into TheRenderer's arena queue, alongside the chunks.
+	inline int GetNumTiles() const { return (int)m_tiles.size(); }
+
+
+private:
+
+	static int GetDesiredLodLevel( float distanceToTileCenter );
+	static float GetDistanceToTileCenter( const WorldCoords& playerPosition, const ChunkCoords& tileCoords );
+	static bool DoesChunkCoverTile( const std::map< ChunkCoords, Chunk* >& activeChunks, const ChunkCoords& tileCoords );
+
+	void BuildTile( const ChunkCoords& tileCoords, int lodLevel, int skyLightLevel );
+	void FreeTile( LodTile& tile );
+	void FreeAllTiles();
+
+	Dimension m_tilesDimension;
+	std::map< ChunkCoords, LodTile > m_tiles;
+};
@@ -14,9 +14,13 @@
 #include "Engine/Input/TheInput.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Time/Time.hpp"
+#include "Engine/Time/Profiler.hpp"
+#include "Engine/String/StringUtils.hpp"
 #include "Game/TheApp.hpp"
 #include "Game/TheGame.hpp"
 #include "Game/GameCommon.hpp"
+#include "Game/WorldPregenerator.hpp"
+#include "Game/EntityBenchmark.hpp"
 
 //-----------------------------------------------------------------------------------------------
 #define UNUSED(x) (void)(x);
@@ -38,6 +42,7 @@ bool g_isQuitting = false;
 HWND g_hWnd = nullptr;
 HDC g_displayDeviceContext = nullptr;
 HGLRC g_openGLRenderingContext = nullptr;
+int g_framesUntilProfilerTraceExport = -1; //Only counts down if given -trace on the command line.
 
 
 //-----------------------------------------------------------------------------------------------
@@ -195,6 +200,7 @@ void RunMessagePump( )
 //-----------------------------------------------------------------------------------------------
 void Update( float deltaSeconds )
 {
+	PROFILE_SCOPE( "Main_Win32::Update" );
 	g_theGame->Update( deltaSeconds ); //Can pass in 0 to freeze, or others to rewind/slow/etc.
 }
 
@@ -202,7 +208,9 @@ void Update( float deltaSeconds )
 //-----------------------------------------------------------------------------------------------
 void Render()
 {
+	PROFILE_SCOPE( "Main_Win32::Render" ); //Time outside the nested TheGame::Render zone is SwapBuffers.
 	g_theGame->Render();
+
 	SwapBuffers( g_displayDeviceContext );
 }
 
@@ -238,6 +246,10 @@ void RunFrame()
 		g_theAudio->StopChannel( g_bgMusicChannel );
 
 	Render();
+
+	ProfilerEndFrame();
+	if ( g_framesUntilProfilerTraceExport > 0 && --g_framesUntilProfilerTraceExport == 0 )
+		ExportProfilerCaptureToChromeTrace( PROFILER_TRACE_FILE_PATH );
 }
 
 
@@ -265,7 +277,7 @@ void Initialize( HINSTANCE applicationInstanceHandle )
 	g_theInput->OnGainedFocus();
 
 	g_theRenderer = new TheRenderer();
-	g_theRenderCommands = new std::list< RenderCommand* >();
+	g_theRenderCommands = new RenderCommandPool();
 }
 
 
@@ -287,10 +299,40 @@ void Shutdown( )
 }
 
 
+//-----------------------------------------------------------------------------------------------
+//"-trace=<n>" exports a profiler capture to PROFILER_TRACE_FILE_PATH after n frames, as the export hotkey would.
+static bool GetProfilerTraceFrameCountFromCommandLine( const std::string& commandLine, int& out_numFrames )
+{
+	std::string numFramesString;
+	if ( !FindCommandLineOptionValue( commandLine, "trace", numFramesString ) )
+		return false;
+
+	out_numFrames = atoi( numFramesString.c_str() );
+	return ( out_numFrames > 0 );
+}
+
+
 //-----------------------------------------------------------------------------------------------
 int WINAPI WinMain( HINSTANCE applicationInstanceHandle, HINSTANCE, LPSTR commandLineString, int )
 {
-	UNUSED( commandLineString );
+	ApplyWorldSeedFromCommandLine( commandLineString );
+
+	int pregenerationRadiusInChunks;
+	if ( GetPregenerationRadiusFromCommandLine( commandLineString, pregenerationRadiusInChunks ) )
+	{
+		PregenerateWorld( pregenerationRadiusInChunks ); //Headless, e.g. to warm a spawn area ahead of time.
+		return 0;
+	}
+
+	int numBenchmarkEntities;
+	if ( GetEntityBenchmarkCountFromCommandLine( commandLineString, numBenchmarkEntities ) )
+	{
+		RunEntityBenchmark( numBenchmarkEntities ); //Headless, for timing entity simulation without rendering in the way.
+		return 0;
+	}
+
+	GetProfilerTraceFrameCountFromCommandLine( commandLineString, g_framesUntilProfilerTraceExport );
+
 	Initialize( applicationInstanceHandle );
 
 	while ( !g_isQuitting )
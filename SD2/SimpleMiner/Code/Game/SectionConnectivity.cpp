@@ -0,0 +1,128 @@
+#include "Game/SectionConnectivity.hpp"
+
+
+#include <bitset>
+#include "Game/Block.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+static int GetFacePairBitIndex( int faceA, int faceB )
+{
+	if ( faceA > faceB )
+	{
+		int swapTemp = faceA;
+		faceA = faceB;
+		faceB = swapTemp;
+	}
+
+	//Row faceA starts after the ( 5 + 4 + ... ) pairs of the rows before it.
+	return ( ( faceA * ( 11 - faceA ) ) / 2 ) + ( faceB - faceA - 1 );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static unsigned char GetFacesTouchedByBlock( int x, int y, int z )
+{
+	unsigned char facesTouched = 0;
+
+	if ( x == CHUNK_X_LENGTH_IN_BLOCKS - 1 ) facesTouched |= BIT( SECTION_NORTH );
+	if ( x == 0 ) facesTouched |= BIT( SECTION_SOUTH );
+	if ( y == CHUNK_Y_WIDTH_IN_BLOCKS - 1 ) facesTouched |= BIT( SECTION_WEST );
+	if ( y == 0 ) facesTouched |= BIT( SECTION_EAST );
+	if ( z == SECTION_HEIGHT_IN_BLOCKS - 1 ) facesTouched |= BIT( SECTION_UP );
+	if ( z == 0 ) facesTouched |= BIT( SECTION_DOWN );
+
+	return facesTouched;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+SectionConnectivity ComputeSectionConnectivity( const Block* sectionBlocks )
+{
+	int numOpaqueBlocks = 0;
+	for ( int blockIndex = 0; blockIndex < NUM_BLOCKS_PER_SECTION; blockIndex++ )
+		if ( sectionBlocks[ blockIndex ].IsOpaque() )
+			++numOpaqueBlocks;
+
+	//Skip the flood fill for the common all-air and all-rock sections.
+	if ( numOpaqueBlocks == 0 )
+		return SECTION_ALL_FACES_CONNECTED;
+	if ( numOpaqueBlocks == NUM_BLOCKS_PER_SECTION )
+		return SECTION_NO_FACES_CONNECTED;
+
+	SectionConnectivity connectivity = SECTION_NO_FACES_CONNECTED;
+	std::bitset< NUM_BLOCKS_PER_SECTION > visitedBlocks;
+	unsigned short floodStack[ NUM_BLOCKS_PER_SECTION ]; //Each block is pushed at most once.
+
+	for ( int seedIndex = 0; seedIndex < NUM_BLOCKS_PER_SECTION; seedIndex++ )
+	{
+		if ( visitedBlocks[ seedIndex ] || sectionBlocks[ seedIndex ].IsOpaque() )
+			continue;
+
+		//Flood one pocket of non-opaque blocks, noting every section face it reaches.
+		unsigned char facesReached = 0;
+		int stackSize = 0;
+		floodStack[ stackSize++ ] = (unsigned short)seedIndex;
+		visitedBlocks.set( seedIndex );
+
+		while ( stackSize > 0 )
+		{
+			int blockIndex = floodStack[ --stackSize ];
+			int x = blockIndex & LOCAL_X_BITMASK;
+			int y = ( blockIndex >> CHUNK_BITS_X ) & LOCAL_Y_BITMASK;
+			int z = blockIndex >> BITS_PER_XY_LAYER;
+
+			facesReached |= GetFacesTouchedByBlock( x, y, z );
+
+			int neighborIndices[ NUM_SECTION_FACES ];
+			int numNeighbors = 0;
+			if ( x < CHUNK_X_LENGTH_IN_BLOCKS - 1 ) neighborIndices[ numNeighbors++ ] = blockIndex + 1;
+			if ( x > 0 ) neighborIndices[ numNeighbors++ ] = blockIndex - 1;
+			if ( y < CHUNK_Y_WIDTH_IN_BLOCKS - 1 ) neighborIndices[ numNeighbors++ ] = blockIndex + CHUNK_X_LENGTH_IN_BLOCKS;
+			if ( y > 0 ) neighborIndices[ numNeighbors++ ] = blockIndex - CHUNK_X_LENGTH_IN_BLOCKS;
+			if ( z < SECTION_HEIGHT_IN_BLOCKS - 1 ) neighborIndices[ numNeighbors++ ] = blockIndex + NUM_COLUMNS_PER_CHUNK;
+			if ( z > 0 ) neighborIndices[ numNeighbors++ ] = blockIndex - NUM_COLUMNS_PER_CHUNK;
+
+			for ( int neighborNumber = 0; neighborNumber < numNeighbors; neighborNumber++ )
+			{
+				int neighborIndex = neighborIndices[ neighborNumber ];
+				if ( visitedBlocks[ neighborIndex ] || sectionBlocks[ neighborIndex ].IsOpaque() )
+					continue;
+
+				visitedBlocks.set( neighborIndex );
+				floodStack[ stackSize++ ] = (unsigned short)neighborIndex;
+			}
+		}
+
+		for ( int faceA = 0; faceA < NUM_SECTION_FACES; faceA++ )
+		{
+			if ( ( facesReached & BIT( faceA ) ) == 0 )
+				continue;
+			for ( int faceB = faceA + 1; faceB < NUM_SECTION_FACES; faceB++ )
+				if ( ( facesReached & BIT( faceB ) ) != 0 )
+					connectivity |= BIT( GetFacePairBitIndex( faceA, faceB ) );
+		}
+
+		if ( connectivity == SECTION_ALL_FACES_CONNECTED )
+			break;
+	}
+
+	return connectivity;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool AreSectionFacesConnected( SectionConnectivity connectivity, SectionFace entryFace, SectionFace exitFace )
+{
+	if ( entryFace == exitFace )
+		return true; //Going back out the way we came never needs to cross the section.
+
+	return ( connectivity & BIT( GetFacePairBitIndex( entryFace, exitFace ) ) ) != 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+SectionFace GetOppositeSectionFace( SectionFace face )
+{
+	return (SectionFace)( face ^ 1 ); //Faces are laid out in opposing pairs.
+}
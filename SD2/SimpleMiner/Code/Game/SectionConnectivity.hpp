@@ -0,0 +1,24 @@
+#pragma once
+
+
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+class Block;
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Chunks are split into 16^3 sections along z. For each we keep which pairs of its six faces can see each other
+//through non-opaque blocks, so World can walk outward from the camera and skip whatever is sealed off behind rock.
+enum SectionFace { SECTION_NORTH = 0, SECTION_SOUTH, SECTION_WEST, SECTION_EAST, SECTION_UP, SECTION_DOWN, NUM_SECTION_FACES }; //+x, -x, +y, -y, +z, -z.
+
+typedef unsigned short SectionConnectivity; //One bit per unordered pair of faces, 15 in all.
+static const SectionConnectivity SECTION_ALL_FACES_CONNECTED = ( 1 << 15 ) - 1;
+static const SectionConnectivity SECTION_NO_FACES_CONNECTED = 0;
+
+
+//--------------------------------------------------------------------------------------------------------------
+SectionConnectivity ComputeSectionConnectivity( const Block* sectionBlocks ); //Expects the NUM_BLOCKS_PER_SECTION blocks of one section, z-major like Chunk::m_blocks.
+bool AreSectionFacesConnected( SectionConnectivity connectivity, SectionFace entryFace, SectionFace exitFace );
+SectionFace GetOppositeSectionFace( SectionFace face );
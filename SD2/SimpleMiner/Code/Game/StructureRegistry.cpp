@@ -0,0 +1,491 @@
+#include "Game/StructureRegistry.hpp"
+
+
+#include "Engine/Math/Noise.hpp"
+#include "Game/Chunk.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool Structure::OverlapsChunk( const ChunkCoords& chunkCoords ) const
+{
+	int chunkMinX = chunkCoords.x * CHUNK_X_LENGTH_IN_BLOCKS;
+	int chunkMinY = chunkCoords.y * CHUNK_Y_WIDTH_IN_BLOCKS;
+	int chunkMaxX = chunkMinX + CHUNK_X_LENGTH_IN_BLOCKS - 1;
+	int chunkMaxY = chunkMinY + CHUNK_Y_WIDTH_IN_BLOCKS - 1;
+
+	if ( m_boundsMaxs.x < chunkMinX || m_boundsMins.x > chunkMaxX )
+		return false;
+	if ( m_boundsMaxs.y < chunkMinY || m_boundsMins.y > chunkMaxY )
+		return false;
+
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void StructureRegistry::GetStructuresOverlappingChunk( Dimension dimension, const ChunkCoords& chunkCoords, std::vector< const Structure* >& out_structures )
+{
+	//A village can reach its radius past the cell holding its center, so widen the chunk by that much to find candidate cells.
+	int searchMinX = ( chunkCoords.x * CHUNK_X_LENGTH_IN_BLOCKS ) - VILLAGE_RADIUS_X_BLOCKS;
+	int searchMinY = ( chunkCoords.y * CHUNK_Y_WIDTH_IN_BLOCKS ) - VILLAGE_RADIUS_Y_BLOCKS;
+	int searchMaxX = ( chunkCoords.x * CHUNK_X_LENGTH_IN_BLOCKS ) + CHUNK_X_LENGTH_IN_BLOCKS - 1 + VILLAGE_RADIUS_X_BLOCKS;
+	int searchMaxY = ( chunkCoords.y * CHUNK_Y_WIDTH_IN_BLOCKS ) + CHUNK_Y_WIDTH_IN_BLOCKS - 1 + VILLAGE_RADIUS_Y_BLOCKS;
+
+	StructureCellCoords cellMins = GetCellCoordsForGlobalColumn( searchMinX, searchMinY );
+	StructureCellCoords cellMaxs = GetCellCoordsForGlobalColumn( searchMaxX, searchMaxY );
+
+	for ( int cellY = cellMins.y; cellY <= cellMaxs.y; cellY++ )
+	{
+		for ( int cellX = cellMins.x; cellX <= cellMaxs.x; cellX++ )
+		{
+			StructureCellCoords cellCoords = StructureCellCoords( cellX, cellY );
+			if ( AppendStructuresOverlappingChunkFromCell( dimension, cellCoords, chunkCoords, nullptr, out_structures ) )
+				continue;
+
+			StructureCell newCell;
+			PlaceStructuresInCell( dimension, cellCoords, newCell ); //The slow part, so it's kept outside the lock.
+			AppendStructuresOverlappingChunkFromCell( dimension, cellCoords, chunkCoords, &newCell, out_structures );
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void StructureRegistry::ForgetCellsBeyondRadius( Dimension dimension, const WorldCoordsXY& center, float radius )
+{
+	const float halfCellSize = VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS * .5f;
+
+	std::lock_guard< std::mutex > cellsLock( m_cellsMutex );
+
+	std::map< StructureCellCoords, StructureCell >& cellsInDimension = m_cells[ dimension ];
+	for ( std::map< StructureCellCoords, StructureCell >::iterator cellIter = cellsInDimension.begin(); cellIter != cellsInDimension.end(); )
+	{
+		const StructureCellCoords& cellCoords = cellIter->first;
+		WorldCoordsXY cellCenter( ( cellCoords.x * VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS ) + halfCellSize, ( cellCoords.y * VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS ) + halfCellSize );
+
+		if ( ( cellCenter - center ).CalcLength() > radius )
+			cellIter = cellsInDimension.erase( cellIter );
+		else
+			++cellIter;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Returns false, appending nothing, if the cell isn't placed yet and there's no cell given to insert.
+bool StructureRegistry::AppendStructuresOverlappingChunkFromCell( Dimension dimension, const StructureCellCoords& cellCoords, const ChunkCoords& chunkCoords,
+																  StructureCell* cellToInsertIfMissing, std::vector< const Structure* >& out_structures )
+{
+	std::lock_guard< std::mutex > cellsLock( m_cellsMutex );
+
+	std::map< StructureCellCoords, StructureCell >& cellsInDimension = m_cells[ dimension ];
+	std::map< StructureCellCoords, StructureCell >::iterator found = cellsInDimension.find( cellCoords );
+	if ( found == cellsInDimension.end() )
+	{
+		if ( cellToInsertIfMissing == nullptr )
+			return false;
+
+		found = cellsInDimension.insert( std::make_pair( cellCoords, std::move( *cellToInsertIfMissing ) ) ).first;
+	}
+	//Else another thread placed it first, and as placement is deterministic its copy is the same as ours.
+
+	for ( const Structure& structure : found->second )
+	{
+		if ( structure.OverlapsChunk( chunkCoords ) )
+			out_structures.push_back( &structure );
+	}
+
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::PlaceStructuresInCell( Dimension dimension, const StructureCellCoords& cellCoords, StructureCell& out_cell )
+{
+	if ( !g_generateVillages )
+		return;
+
+	std::vector< GlobalColumnCoords > villageCenters;
+	FindVillageCentersInCell( cellCoords, villageCenters );
+	for ( const GlobalColumnCoords& villageCenter : villageCenters )
+	{
+		int groundHeightAtVillageCenter = Chunk::GetGroundHeightWithPerlinNoiseForColumn( dimension, villageCenter );
+		GlobalBlockCoords villageWorldCenter = GlobalBlockCoords( (int)villageCenter.x, (int)villageCenter.y, groundHeightAtVillageCenter );
+
+		out_cell.push_back( Structure() );
+		Structure& newVillage = out_cell.back();
+		newVillage.m_boundsMins = villageWorldCenter;
+		newVillage.m_boundsMaxs = villageWorldCenter;
+		BuildVillage( dimension, newVillage, villageWorldCenter );
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC StructureRegistry::StructureCellCoords StructureRegistry::GetCellCoordsForGlobalColumn( int globalX, int globalY )
+{
+	//Floored, not truncated, division so negative columns land in the cell below.
+	StructureCellCoords cellCoords;
+	cellCoords.x = ( globalX >= 0 ) ? ( globalX / VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS ) : ( ( ( globalX + 1 ) / VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS ) - 1 );
+	cellCoords.y = ( globalY >= 0 ) ? ( globalY / VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS ) : ( ( ( globalY + 1 ) / VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS ) - 1 );
+	return cellCoords;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::FindVillageCentersInCell( const StructureCellCoords& cellCoords, std::vector< GlobalColumnCoords >& out_villageCenters )
+{
+	//Sample the village grid one column past each side, so every column in the cell has all four neighbors to compare against.
+	const int numSamplesPerSide = VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS + 2;
+	int cellMinX = cellCoords.x * VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS;
+	int cellMinY = cellCoords.y * VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS;
+
+	std::vector< float > villagePerlinValues( numSamplesPerSide * numSamplesPerSide );
+	ComputePerlinNoiseGrid2D(
+		GlobalColumnCoords( (float)( cellMinX - 1 ), (float)( cellMinY - 1 ) ),
+		numSamplesPerSide,
+		numSamplesPerSide,
+		1.f,
+		VILLAGE_PERLIN_GRID_CELL_SIZE,
+		VILLAGE_PERLIN_GRID_NUM_OCTAVES,
+		VILLAGE_PERLIN_GRID_PERSISTANCE,
+		villagePerlinValues.data(),
+		g_worldSeed
+	);
+
+	for ( int sampleY = 1; sampleY <= VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS; sampleY++ )
+	{
+		for ( int sampleX = 1; sampleX <= VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS; sampleX++ )
+		{
+			int sampleIndex = sampleX + ( sampleY * numSamplesPerSide );
+			float currentVillagePerlinGridValue = villagePerlinValues[ sampleIndex ];
+
+			//A village center is a local maximum of the village grid against its four direct neighbors.
+			if ( currentVillagePerlinGridValue <= villagePerlinValues[ sampleIndex + numSamplesPerSide ] ) //North.
+				continue;
+			if ( currentVillagePerlinGridValue <= villagePerlinValues[ sampleIndex - numSamplesPerSide ] ) //South.
+				continue;
+			if ( currentVillagePerlinGridValue <= villagePerlinValues[ sampleIndex + 1 ] ) //East.
+				continue;
+			if ( currentVillagePerlinGridValue <= villagePerlinValues[ sampleIndex - 1 ] ) //West.
+				continue;
+
+			out_villageCenters.push_back( GlobalColumnCoords( (float)( cellMinX + sampleX - 1 ), (float)( cellMinY + sampleY - 1 ) ) );
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::AddBlockToStructure( Structure& out_structure, const GlobalBlockCoords& position, BlockType type )
+{
+	if ( ( position.z < 0 ) || ( position.z >= CHUNK_Z_HEIGHT_IN_BLOCKS ) )
+		return; //e.g. tall shrines on high ground poke out the top of the world.
+
+	out_structure.m_blocks.push_back( StructureBlock( position, type ) );
+
+	out_structure.m_boundsMins.x = GetMin( out_structure.m_boundsMins.x, position.x );
+	out_structure.m_boundsMins.y = GetMin( out_structure.m_boundsMins.y, position.y );
+	out_structure.m_boundsMins.z = GetMin( out_structure.m_boundsMins.z, position.z );
+	out_structure.m_boundsMaxs.x = GetMax( out_structure.m_boundsMaxs.x, position.x );
+	out_structure.m_boundsMaxs.y = GetMax( out_structure.m_boundsMaxs.y, position.y );
+	out_structure.m_boundsMaxs.z = GetMax( out_structure.m_boundsMaxs.z, position.z );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::BuildVillage( Dimension dimension, Structure& out_village, GlobalBlockCoords villageWorldCenter )
+{
+	//Use coord types for math operations, but use BlockInfo type for block-neighbor checking.
+	GlobalBlockCoords villageWorldMins = villageWorldCenter - GlobalBlockCoords( VILLAGE_RADIUS_X_BLOCKS, VILLAGE_RADIUS_Y_BLOCKS, 0 );
+	GlobalBlockCoords villageWorldMaxs = villageWorldCenter + GlobalBlockCoords( VILLAGE_RADIUS_X_BLOCKS, VILLAGE_RADIUS_Y_BLOCKS, 0 );
+
+	//Call a series of build regions, later to be picked out from either more Perlin grids or the village Perlin grid in a repeatable way.
+	//Note that "mins" is lower-left, "maxs" is upper-right of a region.
+	GlobalBlockCoords regionSize = GlobalBlockCoords( VILLAGE_RADIUS_X_BLOCKS - VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER, VILLAGE_RADIUS_Y_BLOCKS - VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER, 0 );
+
+	//Portal shrine in lower-left quadrant of village.
+	GlobalBlockCoords portalShrineMins		= villageWorldMins;
+	GlobalBlockCoords portalShrineMaxs		= portalShrineMins + regionSize;
+
+	//Pond in upper-right quadrant of village.
+	GlobalBlockCoords pondMaxs				= villageWorldMaxs;
+	GlobalBlockCoords pondMins				= pondMaxs - regionSize;
+
+	//Treasure shrine in lower-right quadrant of village.
+	GlobalBlockCoords treasureShrineMins	= GlobalBlockCoords( villageWorldCenter.x + VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER, villageWorldMins.y, villageWorldCenter.z ); //+1 else on center.
+	GlobalBlockCoords treasureShrineMaxs	= treasureShrineMins + regionSize;
+
+	BuildVillageRoads( dimension, out_village, villageWorldMins, villageWorldMaxs, villageWorldCenter );
+	BuildPond( dimension, out_village, pondMins, pondMaxs );
+	BuildPortalShrine( dimension, out_village, portalShrineMins, portalShrineMaxs ); //Later send in %'s of the village sizes.
+	BuildTreasureShrine( dimension, out_village, treasureShrineMins, treasureShrineMaxs );
+
+	//Mark the village center for now.
+	AddBlockToStructure( out_village, villageWorldCenter, BlockType::GLOWSTONE );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::BuildVillageRoads( Dimension dimension, Structure& out_village, GlobalBlockCoords villageWorldMins, GlobalBlockCoords villageWorldMaxs, GlobalBlockCoords villageWorldCenter )
+{
+	int roadRadius = VILLAGE_BLOCKS_FROM_CENTER_TO_CONSTRUCT_INCLUDING_CENTER;
+
+	//Place pond blocks.
+	for ( int y = villageWorldMins.y; y <= villageWorldMaxs.y; y++ )
+	{
+		for ( int x = villageWorldMins.x; x <= villageWorldMaxs.x; x++ )
+		{
+			GlobalColumnCoords currentColumn = GlobalColumnCoords( (float)x, (float)y );
+			int currentColumnGroundHeight = Chunk::GetGroundHeightWithPerlinNoiseForColumn( dimension, currentColumn );
+			BlockType roadType = GRAVEL; //( dimension == DIM_NETHER ? MYCELIUM : GRAVEL ); -- didn't look quite right, but try another this way sometime.
+
+			bool inRangeOnX = ( ( x < ( villageWorldCenter.x + roadRadius ) ) && ( x > ( villageWorldCenter.x - roadRadius ) ) );
+			bool inRangeOnY = ( ( y < ( villageWorldCenter.y + roadRadius ) ) && ( y > ( villageWorldCenter.y - roadRadius ) ) );
+			if ( inRangeOnX || inRangeOnY )
+			{
+				AddBlockToStructure( out_village, GlobalBlockCoords( x, y, currentColumnGroundHeight ), roadType );
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::BuildPortalShrine( Dimension dimension, Structure& out_village, GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs )
+{
+	int bottomOfShrine = GetMaxColumnGroundHeightForArea( dimension, shrineWorldMins, shrineWorldMaxs );
+
+	//Place shrine's floor blocks.
+	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
+	{
+		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
+		{
+			if ( dimension == DIM_NETHER )
+			{
+				AddBlockToStructure( out_village, GlobalBlockCoords( x, y, bottomOfShrine ), BlockType::MYCELIUM );
+			}
+			else
+			{
+				AddBlockToStructure( out_village, GlobalBlockCoords( x, y, bottomOfShrine ), BlockType::BROWNSTONE );
+			}
+		}
+	}
+
+	//Place shrine's pillar blocks.
+	int topOfShrine = bottomOfShrine + VILLAGE_PORTAL_SHRINE_HEIGHT;
+	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
+	{
+		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
+		{
+			for ( int z = 0; z <= topOfShrine; z++ )
+			{
+				bool shouldFormTowerBand = ( ( z & 7 ) == 0 ); //& 7 replaces mod by 8.
+
+				if ( z < bottomOfShrine ) //Foundation.
+				{
+					AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
+				}
+				else if ( x == shrineWorldMins.x || x == shrineWorldMaxs.x )
+				{
+					if ( shouldFormTowerBand || y == shrineWorldMins.y || y == shrineWorldMaxs.y )
+					{
+						if ( dimension == DIM_NETHER )
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::NETHERRACK );
+						}
+						else
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
+						}
+					}
+					else //Place the blocks between the corner pillars.
+					{
+						if ( dimension == DIM_NETHER )
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::RED_SAND );
+						}
+						else
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::BROWNSTONE );
+						}
+					}
+				}
+				else if ( y == shrineWorldMins.y || y == shrineWorldMaxs.y )
+				{
+					if ( shouldFormTowerBand || x == shrineWorldMins.x || x == shrineWorldMaxs.x )
+					{
+						if ( dimension == DIM_NETHER )
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::NETHERRACK );
+						}
+						else
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
+						}
+					}
+					else //Place the blocks between the corner pillars.
+					{
+						if ( dimension == DIM_NETHER )
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::RED_SAND );
+						}
+						else
+						{
+							AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::BROWNSTONE );
+						}
+					}
+				}
+
+			}
+		}
+	}
+
+	//Place shrine's floating platform you have to access via climbing tower.
+	int portalPlatformHeight = topOfShrine;
+	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
+	{
+		//Skip outer ring.
+		if ( ( y <= ( shrineWorldMins.y + 1 ) ) || ( y >= ( shrineWorldMaxs.y - 1 ) ) )
+			continue;
+
+		//Fill rows inside outer ring.
+		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
+		{
+			//Skip outer ring.
+			if ( ( x <= ( shrineWorldMins.x + 1 ) ) || ( x >= ( shrineWorldMaxs.x - 1 ) ) ) 
+				continue;
+
+			AddBlockToStructure( out_village, GlobalBlockCoords( x, y, portalPlatformHeight ), BlockType::GLOWSTONE );
+		}
+	}
+
+	//Place the portal block(s) after finding shrine center.
+	int shrineSizeOnX = abs( shrineWorldMaxs.x - shrineWorldMins.x );
+	int shrineSizeOnY = abs( shrineWorldMaxs.y - shrineWorldMins.y );
+
+	GlobalBlockCoords shrineWorldCenter = shrineWorldMins + GlobalBlockCoords( shrineSizeOnX >> 1, shrineSizeOnY >> 1, 0 ); //div by 2 replaced.
+	GlobalBlockCoords portalWorldMins = GlobalBlockCoords( shrineWorldCenter.x, shrineWorldCenter.y, topOfShrine-1 );
+
+	AddBlockToStructure( out_village, portalWorldMins, BlockType::PORTAL );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::BuildTreasureShrine( Dimension dimension, Structure& out_village, GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs )
+{
+	int bottomOfShrine = GetMaxColumnGroundHeightForArea( dimension, shrineWorldMins, shrineWorldMaxs );
+	int topOfShrine = bottomOfShrine + VILLAGE_TREASURE_SHRINE_HEIGHT;
+
+	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
+	{
+		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
+		{
+			GlobalColumnCoords currentColumnInPond = GlobalColumnCoords( (float)x, (float)y );
+			int currentColumnGroundHeight = Chunk::GetGroundHeightWithPerlinNoiseForColumn( dimension, currentColumnInPond );
+			GlobalBlockCoords currentBlockWorldMins = GlobalBlockCoords( x, y, currentColumnGroundHeight );
+
+			AddBlockToStructure( out_village, GlobalBlockCoords( x, y, topOfShrine ), BlockType::GOLD_BRICK );
+			AddBlockToStructure( out_village, GlobalBlockCoords( x, y, bottomOfShrine ), BlockType::GOLD_BRICK );
+
+			for ( int z = 0; z < topOfShrine; z++ ) //Place walls.
+			{
+				if ( z < bottomOfShrine ) //Foundation.
+				{
+					AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::COBBLESTONE );
+				}
+				else if ( x == shrineWorldMins.x || x == shrineWorldMaxs.x )
+				{
+					if ( y == shrineWorldMins.y || y == shrineWorldMaxs.y )
+					{
+						AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::GOLD_BRICK );
+					}
+				}
+				else if ( y == shrineWorldMins.y || y == shrineWorldMaxs.y )
+				{
+					if ( x == shrineWorldMins.x || x == shrineWorldMaxs.x )
+					{
+						AddBlockToStructure( out_village, GlobalBlockCoords( x, y, z ), BlockType::GOLD_BRICK );
+					}
+				}
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::BuildClimbingTower( Dimension dimension, Structure& out_village, GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs )
+{
+	for ( int y = shrineWorldMins.y; y <= shrineWorldMaxs.y; y++ )
+	{
+		for ( int x = shrineWorldMins.x; x <= shrineWorldMaxs.x; x++ )
+		{
+			GlobalColumnCoords currentColumnInPond = GlobalColumnCoords( (float)x, (float)y );
+			int currentColumnGroundHeight = Chunk::GetGroundHeightWithPerlinNoiseForColumn( dimension, currentColumnInPond );
+			GlobalBlockCoords currentBlockWorldMins = GlobalBlockCoords( x, y, currentColumnGroundHeight );
+
+			AddBlockToStructure( out_village, currentBlockWorldMins, BlockType::BROWNSTONE );
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void StructureRegistry::BuildPond( Dimension dimension, Structure& out_village, GlobalBlockCoords pondWorldMins, GlobalBlockCoords pondWorldMaxs )
+{
+	int topOfPond = GetMaxColumnGroundHeightForArea( dimension, pondWorldMins, pondWorldMaxs ); //Pond goes down from ground level.
+	int bottomOfPond = topOfPond - VILLAGE_POND_HEIGHT;
+
+	//Place pond blocks.
+	for ( int y = pondWorldMins.y; y <= pondWorldMaxs.y; y++ )
+	{
+		for ( int x = pondWorldMins.x; x <= pondWorldMaxs.x; x++ )
+		{
+			for ( int z = 0; z < CHUNK_Z_HEIGHT_IN_BLOCKS; z++ )
+			{
+				GlobalBlockCoords currentBlockWorldMins = GlobalBlockCoords( x, y, z );
+
+				BlockType wallType = ( dimension == DIM_NETHER ? NETHERRACK : COBBLESTONE );
+
+				if ( z > topOfPond )
+				{
+					continue;
+				}
+				else if ( z < bottomOfPond )
+				{
+					AddBlockToStructure( out_village, currentBlockWorldMins, wallType );
+				}
+				else if ( ( x == pondWorldMins.x ) || ( x == pondWorldMaxs.x ) || ( y == pondWorldMins.y ) || ( y == pondWorldMaxs.y ) )
+				{
+					AddBlockToStructure( out_village, currentBlockWorldMins, wallType ); //Perimeter wall.
+				}
+				else
+				{
+					BlockType pondContent = ( dimension == DIM_NETHER ? LAVA : WATER );
+					AddBlockToStructure( out_village, currentBlockWorldMins, pondContent );
+				}
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC int StructureRegistry::GetMaxColumnGroundHeightForArea( Dimension dimension, const GlobalBlockCoords& areaMins, const GlobalBlockCoords& areaMaxs )
+{
+	//To get the bottom of a construct, we have to take the max ground height of all columns in range.
+	int currentMaxColumnGroundHeight = -1;
+	for ( int y = areaMins.y; y <= areaMaxs.y; y++ )
+	{
+		for ( int x = areaMins.x; x <= areaMaxs.x; x++ )
+		{
+			GlobalColumnCoords currentColumn = GlobalColumnCoords( (float)x, (float)y );
+			int currentColumnGroundHeight = Chunk::GetGroundHeightWithPerlinNoiseForColumn( dimension, currentColumn );
+
+			if ( currentMaxColumnGroundHeight < currentColumnGroundHeight )
+				currentMaxColumnGroundHeight = currentColumnGroundHeight;
+		}
+	}
+	return currentMaxColumnGroundHeight;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct StructureBlock
+{
+	StructureBlock( const GlobalBlockCoords& position, BlockType type ) : m_position( position ), m_type( type ) {}
+
+	GlobalBlockCoords m_position;
+	BlockType m_type;
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct Structure
+{
+	bool OverlapsChunk( const ChunkCoords& chunkCoords ) const;
+
+	GlobalBlockCoords m_boundsMins; //Inclusive, grown as blocks are added.
+	GlobalBlockCoords m_boundsMaxs;
+	std::vector< StructureBlock > m_blocks; //In placement order, so later blocks overwrite earlier ones when stamped.
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Places structures once per coarse cell of the world, so chunks only stamp the ones that reach into them
+//rather than each re-searching for and rebuilding every nearby village.
+class StructureRegistry
+{
+public:
+
+	//Safe from many threads at once. Villages are built outside the lock, so threads only wait on each other for map lookups.
+	void GetStructuresOverlappingChunk( Dimension dimension, const ChunkCoords& chunkCoords, std::vector< const Structure* >& out_structures );
+
+	//Deterministic, so forgotten cells just regenerate if revisited. Frees the structures, so it must never run while
+	//another thread may still be stamping structures it got from GetStructuresOverlappingChunk.
+	void ForgetCellsBeyondRadius( Dimension dimension, const WorldCoordsXY& center, float radius );
+
+
+private:
+
+	typedef IntVector2 StructureCellCoords; //Each covers VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS columns on x and y.
+	typedef std::vector< Structure > StructureCell;
+
+	bool AppendStructuresOverlappingChunkFromCell( Dimension dimension, const StructureCellCoords& cellCoords, const ChunkCoords& chunkCoords,
+												   StructureCell* cellToInsertIfMissing, std::vector< const Structure* >& out_structures );
+	static void PlaceStructuresInCell( Dimension dimension, const StructureCellCoords& cellCoords, StructureCell& out_cell );
+	static StructureCellCoords GetCellCoordsForGlobalColumn( int globalX, int globalY );
+	static void FindVillageCentersInCell( const StructureCellCoords& cellCoords, std::vector< GlobalColumnCoords >& out_villageCenters );
+
+	static void AddBlockToStructure( Structure& out_structure, const GlobalBlockCoords& position, BlockType type );
+	static int GetMaxColumnGroundHeightForArea( Dimension dimension, const GlobalBlockCoords& areaMins, const GlobalBlockCoords& areaMaxs );
+	static void BuildVillage( Dimension dimension, Structure& out_village, GlobalBlockCoords villageWorldCenter );
+	static void BuildVillageRoads( Dimension dimension, Structure& out_village, GlobalBlockCoords villageWorldMins, GlobalBlockCoords villageWorldMaxs, GlobalBlockCoords villageWorldCenter );
+	static void BuildPortalShrine( Dimension dimension, Structure& out_village, GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs );
+	static void BuildTreasureShrine( Dimension dimension, Structure& out_village, GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs );
+	static void BuildClimbingTower( Dimension dimension, Structure& out_village, GlobalBlockCoords shrineWorldMins, GlobalBlockCoords shrineWorldMaxs );
+	static void BuildPond( Dimension dimension, Structure& out_village, GlobalBlockCoords pondWorldMins, GlobalBlockCoords pondWorldMaxs );
+
+	std::map< StructureCellCoords, StructureCell > m_cells[ NUM_DIMENSIONS ]; //Map nodes don't move, so handed-out Structure pointers stay valid until forgotten.
+	std::mutex m_cellsMutex;
+};
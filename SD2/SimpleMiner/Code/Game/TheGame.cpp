@@ -2,12 +2,14 @@
 
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Engine/Renderer/TheRenderer.hpp"
 #include "Engine/Renderer/SpriteSheet.hpp"
 #include "Engine/Audio/TheAudio.hpp"
 #include "Engine/String/StringUtils.hpp"
 #include "Engine/Input/TheInput.hpp"
 #include "Engine/Renderer/RenderCommand.hpp"
+#include "Engine/Time/Profiler.hpp"
 
 #include "Game/GameCommon.hpp"
 #include "Game/TheApp.hpp" 
@@ -27,6 +29,7 @@ TheGame* g_theGame = nullptr;
 TheGame::TheGame()
 	: m_playerCamera( new Camera3D( CAMERA_DEFAULT_POSITION ) )
 	, m_player( new Player( PLAYER_DEFAULT_POSITION ) )
+	, m_lastFrameSeconds( 0.f )
 {
 	constexpr int TILE_DIMENSION = 16;
 	constexpr int TILE_WIDTH = TILE_DIMENSION;
@@ -55,6 +58,9 @@ TheGame::~TheGame( )
 //-----------------------------------------------------------------------------
 void TheGame::Update( float deltaSeconds )
 {
+	g_theRenderer->ResetFrameStats(); //Here rather than Render, as chunk meshing uploads its VBOs during Update.
+	m_lastFrameSeconds = deltaSeconds;
+
 	m_world->Update( deltaSeconds ); //Also updates player.
 							
 	UpdateDebugCommands( deltaSeconds );
@@ -84,6 +90,23 @@ void TheGame::Update( float deltaSeconds )
 	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_CULLING ) ) 
 		g_useCulling = !g_useCulling;
 
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_OCCLUSION_CULLING ) ) 
+		g_useOcclusionCulling = !g_useOcclusionCulling;
+
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_LOD_TERRAIN ) ) 
+		g_renderLodTerrain = !g_renderLodTerrain;
+
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_EXPORT_PROFILER_TRACE ) )
+		ExportProfilerCaptureToChromeTrace( PROFILER_TRACE_FILE_PATH );
+
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_FRAME_STATS_LOG ) )
+	{
+		if ( m_frameStatsLog.IsOpen() )
+			m_frameStatsLog.Close();
+		else
+			m_frameStatsLog.Open( FRAME_STATS_LOG_FILE_PATH );
+	}
+
 }
 
 
@@ -96,6 +119,7 @@ void TheGame::SetUpPerspectiveProjection()
 	constexpr float zFar = 1000.f;
 
 	g_theRenderer->SetPerspective( fovDegreesVertical, aspect, zNear, zFar );
+	m_projectionMatrix = Matrix4x4::CreatePerspectiveProjection( fovDegreesVertical, aspect, zNear, zFar ); //CPU copy for frustum culling.
 }
 
 
@@ -117,6 +141,14 @@ void TheGame::ApplyCameraTransform()
 
 	//Anti-translation. (MP1 Recap: negating translation == inverse!)
 	g_theRenderer->TranslateView( m_playerCamera->m_worldPosition * -1.f ); 
+
+	//Same sequence again on the CPU, since GL won't hand the matrix back cheaply.
+	m_viewMatrix = Matrix4x4::CreateRotationDegrees( -90.f, UNIT_X )
+		* Matrix4x4::CreateRotationDegrees( 90.f, UNIT_Z )
+		* Matrix4x4::CreateRotationDegrees( -1.f * m_playerCamera->m_orientation.m_rollDegreesAboutX, UNIT_X )
+		* Matrix4x4::CreateRotationDegrees( -1.f * m_playerCamera->m_orientation.m_pitchDegreesAboutY, UNIT_Y )
+		* Matrix4x4::CreateRotationDegrees( -1.f * m_playerCamera->m_orientation.m_yawDegreesAboutZ, UNIT_Z )
+		* Matrix4x4::CreateTranslation( m_playerCamera->m_worldPosition * -1.f );
 }
 
 
@@ -135,6 +167,8 @@ void TheGame::SetupView3D()
 
 	ApplyCameraTransform();
 
+	m_world->SetViewFrustum( Frustum( m_projectionMatrix * m_viewMatrix ) );
+
 	g_theRenderer->EnableDepthTesting( true );
 	g_theRenderer->EnableBackfaceCulling( true );
 	g_theRenderer->EnableAlphaTesting( true );
@@ -169,7 +203,7 @@ void TheGame::RenderDebug3D()
 	g_theRenderer->DrawDebugAxes( 10.f, 1.f, WITH_Z_FOR_3D );
 
 	//Draw debug commands, for now a sphere slightly off-origin to affirm they render along proper +/- direction.
-	g_theRenderCommands->push_back( new RenderCommandSphere( Vector3::ONE, 1.f, 0.f, DepthMode::DEPTH_TEST_DUAL, Rgba::WHITE, 4.f ) );
+	g_theRenderCommands->AddSphere( Vector3::ONE, 1.f, 0.f, DepthMode::DEPTH_TEST_DUAL, Rgba::WHITE, 4.f );
 
 	RenderAndExpireDebugCommands();
 
@@ -260,8 +294,10 @@ void TheGame::RenderReticle()
 //-----------------------------------------------------------------------------
 void TheGame::RenderDebug2D()
 {
+	g_theRenderer->BeginTextBatch(); //All the HUD's text in one draw.
 	RenderLeftSideDebug2D();
 	RenderRightSideDebug2D();
+	g_theRenderer->EndTextBatch();
 }
 
 
@@ -324,6 +360,24 @@ void TheGame::RenderRightSideDebug2D()
 		nullptr,
 		.65f
 		);
+
+	//Rolling per-zone averages from the profiler, indented by nesting.
+	std::vector< ProfilerZoneAverage > zoneAverages;
+	GetProfilerZoneAverages( zoneAverages );
+	float zoneLineY = (float)g_theApp->GetScreenHeight() - 250.f;
+	for ( const ProfilerZoneAverage& zoneAverage : zoneAverages )
+	{
+		g_theRenderer->DrawText2D
+			(
+			Vector2( (float)g_theApp->GetScreenWidth() - 375.f + ( 12.f * zoneAverage.m_depth ), zoneLineY ),
+			Stringf( "%s: %.2fms", zoneAverage.m_zoneName, zoneAverage.m_averageMilliseconds ),
+			14.f,
+			Rgba( .8f, .8f, .8f ),
+			nullptr,
+			.65f
+			);
+		zoneLineY -= 25.f;
+	}
 }
 
 
@@ -372,8 +426,20 @@ void TheGame::RenderLeftSideDebug2D()
 							   CELL_HEIGHT, darkerGray, nullptr, CELL_ASPECT );
 
 	g_theRenderer->DrawText2D( Vector2( TEXT_LEFT_X, screenHeight - 400.f ),
-								Stringf( "Rendered Chunk Count: %i", g_chunksRendered ),
+								Stringf( "Rendered Chunk Count: %i (Frustum Culled: %i, Occluded: %i) LOD Tiles: %i", g_chunksRendered, g_chunksCulled, g_chunksOccluded, g_lodTilesRendered ),
 							   CELL_HEIGHT, darkerGray, nullptr, CELL_ASPECT );
+
+	RenderFrameStats renderStats = g_theRenderer->GetFrameStats(); //Up to this point in the frame.
+	g_theRenderer->DrawText2D( Vector2( TEXT_LEFT_X, screenHeight - 450.f ),
+								Stringf( "Draw Calls: %u Vertexes: %u Texture Binds: %u State Changes: %u (Redundant Skipped: %u)", 
+										 renderStats.m_numDrawCalls, renderStats.m_numVertexesSubmitted, renderStats.m_numTextureBinds, renderStats.m_numStateChanges, renderStats.m_numStateChangesSkipped ),
+							   CELL_HEIGHT, lighterGray, nullptr, CELL_ASPECT );
+
+	g_theRenderer->DrawText2D( Vector2( TEXT_LEFT_X, screenHeight - 500.f ),
+								Stringf( "VBO Upload: %.1f KB Buffers: +%u -%u Meshed: %i Activated: %i Flushed: %i Lighting Nodes: %i%s", 
+										 renderStats.m_numVboBytesUploaded / 1024.f, renderStats.m_numBuffersCreated, renderStats.m_numBuffersDestroyed,
+										 g_chunksMeshed, g_chunksActivated, g_chunksFlushed, g_lightingNodesProcessed, m_frameStatsLog.IsOpen() ? " [Logging]" : "" ),
+							   CELL_HEIGHT, lighterGray, nullptr, CELL_ASPECT );
 }
 
 
@@ -386,9 +452,8 @@ void TheGame::Render3DOverlayWithSprite( const AABB2& overlayTexCoords, bool onA
 
 	std::vector< Vertex3D_PCT > selectionOverlayVertexes;
 	constexpr float OFFSET_AMOUNT = .05f;
-	AABB3* bounds = new AABB3();
-	GetSelectedBlockBounds( bounds );
-	if ( bounds == nullptr )
+	AABB3 bounds;
+	if ( !GetSelectedBlockBounds( bounds ) )
 		return;
 
 	Vector3 bottomLeftVertex, bottomRightVertex, topRightVertex, topLeftVertex;
@@ -397,12 +462,12 @@ void TheGame::Render3DOverlayWithSprite( const AABB2& overlayTexCoords, bool onA
 	if ( faceSelected == NONE )
 		return;
 
-	const float BOUNDS_MAX_X = bounds->maxs.x;
-	const float BOUNDS_MAX_Y = bounds->maxs.y;
-	const float BOUNDS_MAX_Z = bounds->maxs.z;
-	const float BOUNDS_MIN_X = bounds->mins.x;
-	const float BOUNDS_MIN_Y = bounds->mins.y;
-	const float BOUNDS_MIN_Z = bounds->mins.z;
+	const float BOUNDS_MAX_X = bounds.maxs.x;
+	const float BOUNDS_MAX_Y = bounds.maxs.y;
+	const float BOUNDS_MAX_Z = bounds.maxs.z;
+	const float BOUNDS_MIN_X = bounds.mins.x;
+	const float BOUNDS_MIN_Y = bounds.mins.y;
+	const float BOUNDS_MIN_Z = bounds.mins.z;
 
 	if ( onAllSides || faceSelected == BOTTOM )
 	{
@@ -476,7 +541,6 @@ void TheGame::Render3DOverlayWithSprite( const AABB2& overlayTexCoords, bool onA
 		selectionOverlayVertexes.push_back( Vertex3D_PCT( topRightVertex,		Vector2( overlayTexCoords.maxs.x, overlayTexCoords.mins.y ) ) );
 		selectionOverlayVertexes.push_back( Vertex3D_PCT( topLeftVertex,		Vector2( overlayTexCoords.mins.x, overlayTexCoords.mins.y ) ) );
 	}
-	delete bounds;
 
 	g_theRenderer->BindTexture( g_textureAtlas->GetAtlasTexture() );
 	g_theRenderer->DrawVertexArray_PCT( TheRenderer::VertexGroupingRule::AS_QUADS, selectionOverlayVertexes, selectionOverlayVertexes.size() );
@@ -486,48 +550,31 @@ void TheGame::Render3DOverlayWithSprite( const AABB2& overlayTexCoords, bool onA
 
 
 //-----------------------------------------------------------------------------
-void TheGame::GetSelectedBlockBounds( AABB3* out_selectedBlockBounds )
+bool TheGame::GetSelectedBlockBounds( AABB3& out_selectedBlockBounds ) const
 {
-	Chunk* selectedChunk = m_world->m_chunkOfSelectedBlock;
-	if ( selectedChunk == nullptr ) //No such selected block exists.
-	{
-		if ( out_selectedBlockBounds != nullptr ) 
-			delete out_selectedBlockBounds;
-
-		out_selectedBlockBounds = nullptr;
-		return;
-	}
-
-	LocalBlockIndex lbiSelected = selectedChunk->m_selectedBlock;
-	if ( ( lbiSelected < 0 ) || ( lbiSelected >= NUM_BLOCKS_PER_CHUNK ) )
-	{
-		if ( out_selectedBlockBounds != nullptr ) 
-			delete out_selectedBlockBounds;
-
-		out_selectedBlockBounds = nullptr;
-		return;
-	}
+	if ( !m_world->HasSelectedBlock() ) //No such selected block exists.
+		return false;
 
+	const BlockInfo& selectedBlock = m_world->GetSelectedBlock();
 	const Vector3& blockSize = Vector3::ONE;
-	WorldCoords renderBoundsMins = selectedChunk->GetWorldCoordsFromLocalBlockIndex( lbiSelected );
-	*out_selectedBlockBounds = AABB3( renderBoundsMins, renderBoundsMins + blockSize );
+	WorldCoords renderBoundsMins = selectedBlock.m_myChunk->GetWorldCoordsFromLocalBlockIndex( selectedBlock.m_myBlockIndex );
+	out_selectedBlockBounds = AABB3( renderBoundsMins, renderBoundsMins + blockSize );
+	return true;
 }
 
 
 //-----------------------------------------------------------------------------
-BlockFace TheGame::GetSelectedBlockFace()
+BlockFace TheGame::GetSelectedBlockFace() const
 {
-	Chunk* selectedChunk = m_world->m_chunkOfSelectedBlock;
-	if ( selectedChunk == nullptr )
-		return NONE;
-
-	return selectedChunk->m_selectedFace;
+	return m_world->GetSelectedFace();
 }
 
 
 //-----------------------------------------------------------------------------
 void TheGame::Render()
 {
+	PROFILE_SCOPE( "TheGame::Render" );
+
 	SetupView3D();
 	Render3D();
 	if ( g_renderDebugInfo )
@@ -537,4 +584,6 @@ void TheGame::Render()
 	Render2D();
 	if ( g_renderDebugInfo )
 		RenderDebug2D( );
+
+	m_frameStatsLog.WriteFrame( m_lastFrameSeconds, g_theRenderer->GetFrameStats() );
 }
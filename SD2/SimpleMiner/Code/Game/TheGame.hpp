@@ -3,6 +3,8 @@
 
 #include <vector>
 #include "Engine/Math/Vector3.hpp"
+#include "Engine/Math/Matrix4x4.hpp"
+#include "Game/FrameStatsLog.hpp"
 
 
 //-----------------------------------------------------------------------------
@@ -46,10 +48,14 @@ private:
 	void RenderLeftSideDebug2D();
 
 	void Render3DOverlayWithSprite( const AABB2& overlayTexCoords, bool onAllSides, bool enableBackfaceCulling = false, bool enableDepthTesting = false );
-	void GetSelectedBlockBounds( AABB3* out_selectedBlockBounds );
-	BlockFace GetSelectedBlockFace();
+	bool GetSelectedBlockBounds( AABB3& out_selectedBlockBounds ) const;
+	BlockFace GetSelectedBlockFace() const;
 
 	Camera3D* m_playerCamera;
 	Player* m_player;
 	World* m_world;
+	Matrix4x4 m_projectionMatrix; //Mirrors of what SetUpPerspectiveProjection and ApplyCameraTransform push to GL.
+	Matrix4x4 m_viewMatrix;
+	FrameStatsLog m_frameStatsLog;
+	float m_lastFrameSeconds; //For the log, as the frame's time is only known to Update.
 };
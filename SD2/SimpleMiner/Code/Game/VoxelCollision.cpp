@@ -0,0 +1,143 @@
+#include "Game/VoxelCollision.hpp"
+
+
+#include "Game/WorldBlockQuery.hpp"
+#include "Game/Chunk.hpp"
+#include "Game/BlockDefinition.hpp"
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------------------------------------
+static inline float GetAxis( const Vector3& v, int axis )
+{
+	return ( axis == 0 ) ? v.x : ( ( axis == 1 ) ? v.y : v.z );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static inline void SetAxis( Vector3& v, int axis, float value )
+{
+	if ( axis == 0 )
+		v.x = value;
+	else if ( axis == 1 )
+		v.y = value;
+	else
+		v.z = value;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static inline int GetFirstOverlappedBlock( float boxMin ) { return (int)floor( boxMin + VOXEL_COLLISION_SKIN ); }
+static inline int GetLastOverlappedBlock( float boxMax ) { return (int)floor( boxMax - VOXEL_COLLISION_SKIN ); }
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Scans one layer of blocks perpendicular to sweptAxis. Returns true if any are solid, also flagging stairs.
+static bool IsBlockLayerSolid( WorldBlockQuery& blockQuery, Dimension dimension, int sweptAxis, int layer,
+							   const int firstBlock[ 3 ], const int lastBlock[ 3 ], bool& out_hasStairs )
+{
+	int firstAxis = ( sweptAxis + 1 ) % 3;
+	int secondAxis = ( sweptAxis + 2 ) % 3;
+	bool isSolid = false;
+
+	GlobalBlockCoords blockCoords;
+	int* coords[ 3 ] = { &blockCoords.x, &blockCoords.y, &blockCoords.z };
+	*coords[ sweptAxis ] = layer;
+
+	for ( int first = firstBlock[ firstAxis ]; first <= lastBlock[ firstAxis ]; first++ )
+	{
+		*coords[ firstAxis ] = first;
+		for ( int second = firstBlock[ secondAxis ]; second <= lastBlock[ secondAxis ]; second++ )
+		{
+			*coords[ secondAxis ] = second;
+
+			BlockInfo blockInfo = blockQuery.GetBlockInfo( dimension, blockCoords );
+			if ( ( blockInfo.m_myChunk == nullptr ) || !blockInfo.m_myChunk->IsBlockSolid( blockInfo.m_myBlockIndex ) )
+				continue;
+
+			isSolid = true;
+			if ( blockInfo.GetBlock()->GetBlockType() == STAIRS )
+				out_hasStairs = true; //Keep scanning the layer, a stair beside a wall shouldn't hide the wall.
+		}
+	}
+
+	return isSolid;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void SweepBoxThroughSolidBlocks( WorldBlockQuery& blockQuery, Dimension dimension, const Vector3& boxCenter, const Vector3& boxHalfExtents,
+								 const Vector3& desiredDisplacement, SweptBoxResult& out_result )
+{
+	static const int AXIS_ORDER[ 3 ] = { 2, 0, 1 };
+
+	out_result = SweptBoxResult();
+	Vector3 boxMins = boxCenter - boxHalfExtents;
+	Vector3 boxMaxs = boxCenter + boxHalfExtents;
+
+	for ( int axis : AXIS_ORDER )
+	{
+		float displacement = GetAxis( desiredDisplacement, axis );
+		if ( displacement == 0.f )
+			continue;
+
+		//Blocks the box covers on every axis, using the position after the axes already resolved.
+		int firstBlock[ 3 ] = { GetFirstOverlappedBlock( boxMins.x ), GetFirstOverlappedBlock( boxMins.y ), GetFirstOverlappedBlock( boxMins.z ) };
+		int lastBlock[ 3 ] = { GetLastOverlappedBlock( boxMaxs.x ), GetLastOverlappedBlock( boxMaxs.y ), GetLastOverlappedBlock( boxMaxs.z ) };
+
+		float boxMin = GetAxis( boxMins, axis );
+		float boxMax = GetAxis( boxMaxs, axis );
+		bool hasStairs = false;
+
+		if ( displacement > 0.f )
+		{
+			int lastLayerSwept = GetLastOverlappedBlock( boxMax + displacement );
+			for ( int layer = lastBlock[ axis ] + 1; layer <= lastLayerSwept; layer++ )
+			{
+				if ( !IsBlockLayerSolid( blockQuery, dimension, axis, layer, firstBlock, lastBlock, hasStairs ) )
+					continue;
+
+				displacement = ( (float)layer - boxMax > 0.f ) ? (float)layer - boxMax : 0.f; //Never pulled backward if already sunk in.
+				out_result.m_wasAxisBlocked[ axis ] = true;
+				break;
+			}
+		}
+		else
+		{
+			int lastLayerSwept = GetFirstOverlappedBlock( boxMin + displacement );
+			for ( int layer = firstBlock[ axis ] - 1; layer >= lastLayerSwept; layer-- )
+			{
+				if ( !IsBlockLayerSolid( blockQuery, dimension, axis, layer, firstBlock, lastBlock, hasStairs ) )
+					continue;
+
+				displacement = ( (float)( layer + 1 ) - boxMin < 0.f ) ? (float)( layer + 1 ) - boxMin : 0.f;
+				out_result.m_wasAxisBlocked[ axis ] = true;
+				break;
+			}
+		}
+
+		if ( hasStairs && ( axis != 2 ) )
+			out_result.m_wasBlockedByStairs = true;
+
+		SetAxis( out_result.m_allowedDisplacement, axis, displacement );
+		SetAxis( boxMins, axis, boxMin + displacement );
+		SetAxis( boxMaxs, axis, boxMax + displacement );
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool IsBoxClearOfSolidBlocks( WorldBlockQuery& blockQuery, Dimension dimension, const Vector3& boxCenter, const Vector3& boxHalfExtents )
+{
+	Vector3 boxMins = boxCenter - boxHalfExtents;
+	Vector3 boxMaxs = boxCenter + boxHalfExtents;
+	int firstBlock[ 3 ] = { GetFirstOverlappedBlock( boxMins.x ), GetFirstOverlappedBlock( boxMins.y ), GetFirstOverlappedBlock( boxMins.z ) };
+	int lastBlock[ 3 ] = { GetLastOverlappedBlock( boxMaxs.x ), GetLastOverlappedBlock( boxMaxs.y ), GetLastOverlappedBlock( boxMaxs.z ) };
+
+	bool hasStairs = false;
+	for ( int layer = firstBlock[ 2 ]; layer <= lastBlock[ 2 ]; layer++ )
+		if ( IsBlockLayerSolid( blockQuery, dimension, 2, layer, firstBlock, lastBlock, hasStairs ) )
+			return false;
+
+	return true;
+}
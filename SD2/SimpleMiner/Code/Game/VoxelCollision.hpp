@@ -0,0 +1,35 @@
+#pragma once
+
+
+#include "Engine/Math/Vector3.hpp"
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+class WorldBlockQuery;
+
+
+//--------------------------------------------------------------------------------------------------------------
+static const float VOXEL_COLLISION_SKIN = .001f; //Faces this close count as touching, not overlapping, so resting boxes don't snag.
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct SweptBoxResult
+{
+	SweptBoxResult() : m_wasBlockedByStairs( false ) { m_wasAxisBlocked[ 0 ] = m_wasAxisBlocked[ 1 ] = m_wasAxisBlocked[ 2 ] = false; }
+
+	Vector3 m_allowedDisplacement;
+	bool m_wasAxisBlocked[ 3 ]; //x, y, z.
+	bool m_wasBlockedByStairs; //A horizontal axis stopped against stairs, for the caller to try IsBoxClearOfSolidBlocks a step up.
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Moves an axis-aligned box through the block grid one axis at a time, z first so ground contact resolves before sliding.
+//Each axis only visits the layers of blocks its own displacement sweeps through, stopping at the first solid one,
+//so the cost is bounded by the swept volume however many faces the box ends up sliding along. Nothing is allocated.
+//Unloaded chunks and blocks above or below the world are treated as open, as the old box traces did.
+void SweepBoxThroughSolidBlocks( WorldBlockQuery& blockQuery, Dimension dimension, const Vector3& boxCenter, const Vector3& boxHalfExtents,
+								 const Vector3& desiredDisplacement, SweptBoxResult& out_result );
+
+bool IsBoxClearOfSolidBlocks( WorldBlockQuery& blockQuery, Dimension dimension, const Vector3& boxCenter, const Vector3& boxHalfExtents );
@@ -1,15 +1,22 @@
 #include "Game/World.hpp"
 
+
+#include <algorithm>
+#include <thread>
+
 #include "Engine/Error/ErrorWarningAssert.hpp"
 #include "Engine/FileUtils/FileUtils.hpp"
 #include "Engine/String/StringUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Noise.hpp"
 #include "Engine/Input/TheInput.hpp" //For input polling.
+#include "Engine/Time/Profiler.hpp"
 
 #include "Game/Chunk.hpp"
 #include "Game/BlockDefinition.hpp"
 #include "Game/Camera3D.hpp"
 #include "Game/Player.hpp"
+#include "Game/VoxelCollision.hpp"
 
 
 //--------------------------------------------------------------------------------------------------------------
@@ -23,17 +30,34 @@ World::World( Camera3D* camera, Player* player )
 	, m_flushRadius( INITIAL_FLUSH_RADIUS )
 	, m_playerCamera( camera )
 	, m_activeHudElement( 0 )
-	, m_chunkOfSelectedBlock( nullptr )
 	, m_currentDigDamageFrame( 0 )
 	, m_player( player )
 	, m_blockBeingDug( new BlockInfo() )
 	, m_activeDimension( DIM_OVERWORLD )
+	, m_sectionWalkStamp( 0 )
+	, m_blockQuery( m_activeChunks )
+	, m_secondsOfSimulationOwed( 0.f )
+	, m_fractionTowardThisTick( 0.f )
+	, m_wasJumpPressedSinceLastTick( false )
+	, m_wasDimensionWarpPressedSinceLastTick( false )
+	, m_wasForwardPressedSinceLastTick( false )
+	, m_wasBackwardPressedSinceLastTick( false )
+	, m_wasLeftPressedSinceLastTick( false )
+	, m_wasRightPressedSinceLastTick( false )
+	, m_currentTick( 0 )
+	, m_blockTickResumeChunkCoords( 0, 0 )
+	, m_selectedFace( NONE )
 {
 	ASSERT_OR_DIE( m_activeRadius < m_flushRadius, "Active Exceeds Flush Radius!" ); //Ensures a chunk can't activate and flush at the same time.
 	ASSERT_OR_DIE( ( (m_activeRadius - m_flushRadius) % CHUNK_X_LENGTH_IN_BLOCKS ) == 0, "Active/Flush Radii Not a Chunk-multiple Apart!" ); //Not a speed-critical %.
 
 	BlockDefinition::InitializeBlockDefinitions();
 	LoadPlayerFile( "Data/Saves/Player.txt" );
+	m_playerPositionLastTick = m_player->m_worldPosition;
+	m_playerPositionThisTick = m_player->m_worldPosition;
+	m_cameraPositionLastTick = m_playerCamera->m_worldPosition;
+	m_cameraPositionThisTick = m_playerCamera->m_worldPosition;
+	LoadOrCreateWorldInfoFile();
 
 	World::m_hudChangeSoundID = g_theAudio->CreateOrGetSound( "Data/Audio/Boxing_SlapStick1.wav" );
 }
@@ -45,6 +69,12 @@ World::~World()
 	//m_camera, m_player deleted by TheGame.
 	delete m_blockBeingDug;
 
+	for ( ChunkLightingJob& lightingJob : m_chunksAwaitingLighting )
+	{
+		lightingJob.m_localLightingResult.wait(); //Worker still writes into the chunk until then.
+		delete lightingJob.m_chunk;
+	}
+
 	for ( int dimensionIndex = 0; dimensionIndex < NUM_DIMENSIONS; dimensionIndex++ )
 	{
 		const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ dimensionIndex ];
@@ -68,45 +98,300 @@ bool World::IsChunkVisible( const Chunk& chunk ) const
 	if ( g_useCulling == false )
 		return true;
 
-	for ( int chunkCornerIndex = 0; chunkCornerIndex < Chunk::ChunkCornerPosition::NUM_CHUNK_CORNERS; chunkCornerIndex++ )
+	if ( m_viewFrustum.DoesOverlapAABB( chunk.GetRenderBounds() ) )
+		return true;
+
+	++g_chunksCulled;
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static Chunk* GetChunkAcrossSectionFace( Chunk* chunk, SectionFace face, int sectionIndex, int& out_neighborSectionIndex )
+{
+	out_neighborSectionIndex = sectionIndex;
+
+	switch ( face )
 	{
-		Vector3 cameraToChunkCornerDisp = chunk.m_chunkCornersInWorldUnits[ chunkCornerIndex ] - m_player->m_worldPosition;
+		case SECTION_NORTH: return chunk->m_northNeighbor;
+		case SECTION_SOUTH: return chunk->m_southNeighbor;
+		case SECTION_WEST: return chunk->m_westNeighbor;
+		case SECTION_EAST: return chunk->m_eastNeighbor;
+		case SECTION_UP: out_neighborSectionIndex = sectionIndex + 1; break;
+		case SECTION_DOWN: out_neighborSectionIndex = sectionIndex - 1; break;
+	}
 
-		//If any dot products of 3D camera forward XYZ vector and the chunk corner world positions are negative, don't render.
-		const Vector3& cameraForward = m_playerCamera->GetForwardXYZ();
-		if ( DotProduct( cameraToChunkCornerDisp, cameraForward ) > 0.f )
-			return true;
+	if ( ( out_neighborSectionIndex < 0 ) || ( out_neighborSectionIndex >= NUM_SECTIONS_PER_CHUNK ) )
+		return nullptr; //Nothing is meshed above or below the chunk, so there's nothing to walk into there.
+
+	return chunk;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct ChunkDrawEntry
+{
+	unsigned short m_distanceKey;
+	Chunk* m_chunk;
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+STATIC void World::SortChunksFrontToBack( const WorldCoords& cameraPosition, std::vector< Chunk* >& inout_chunks )
+{
+	constexpr float DISTANCE_KEY_STEPS_PER_BLOCK = 4.f; //16-bit keys then cover 16384 blocks, far past the flush radius.
+	const unsigned int numChunks = inout_chunks.size();
+
+	std::vector< ChunkDrawEntry > entries( numChunks );
+	std::vector< ChunkDrawEntry > sortedEntries( numChunks );
+	for ( unsigned int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++ )
+	{
+		const AABB3& renderBounds = inout_chunks[ chunkIndex ]->GetRenderBounds();
+		Vector3 cameraToChunkCenter = ( ( renderBounds.mins + renderBounds.maxs ) * .5f ) - cameraPosition;
+		int distanceKey = (int)( cameraToChunkCenter.CalcLength() * DISTANCE_KEY_STEPS_PER_BLOCK );
+
+		entries[ chunkIndex ].m_distanceKey = (unsigned short)GetMin( distanceKey, 0xFFFF );
+		entries[ chunkIndex ].m_chunk = inout_chunks[ chunkIndex ];
 	}
 
-	return false;
+	//LSD radix sort, one counting pass per key byte. Each pass is stable, so the low byte's order survives the high byte's.
+	for ( int keyShift = 0; keyShift < 16; keyShift += 8 )
+	{
+		unsigned int bucketStarts[ 256 + 1 ] = { 0 };
+		for ( const ChunkDrawEntry& entry : entries )
+			++bucketStarts[ ( ( entry.m_distanceKey >> keyShift ) & 0xFF ) + 1 ];
+
+		for ( int bucketIndex = 1; bucketIndex <= 256; bucketIndex++ )
+			bucketStarts[ bucketIndex ] += bucketStarts[ bucketIndex - 1 ];
+
+		for ( const ChunkDrawEntry& entry : entries )
+			sortedEntries[ bucketStarts[ ( entry.m_distanceKey >> keyShift ) & 0xFF ]++ ] = entry;
+
+		entries.swap( sortedEntries );
+	}
+
+	for ( unsigned int chunkIndex = 0; chunkIndex < numChunks; chunkIndex++ )
+		inout_chunks[ chunkIndex ] = entries[ chunkIndex ].m_chunk;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool World::CollectChunksVisibleThroughSections( std::vector< Chunk* >& out_visibleChunks ) const
+{
+	const WorldCoords& cameraPosition = m_playerCamera->m_worldPosition;
+	const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
+	std::map< ChunkCoords, Chunk* >::const_iterator cameraChunkIter = activeChunksInActiveDimension.find( GetChunkCoordsFromWorldCoordsXY( WorldCoordsXY( cameraPosition.x, cameraPosition.y ) ) );
+	if ( cameraChunkIter == activeChunksInActiveDimension.end() )
+		return false;
+
+	++m_sectionWalkStamp;
+	int cameraSectionIndex = GetMax( 0, GetMin( (int)floor( cameraPosition.z ) >> SECTION_BITS_Z, NUM_SECTIONS_PER_CHUNK - 1 ) );
+
+	//The camera's own section counts as open on every side, whatever it's standing in.
+	SectionVisit cameraSection;
+	cameraSection.m_chunk = cameraChunkIter->second;
+	cameraSection.m_sectionIndex = cameraSectionIndex;
+	cameraSection.m_entryFace = NUM_SECTION_FACES;
+	cameraSection.m_directionsTaken = 0;
+	cameraSection.m_chunk->m_sectionVisitStamps[ cameraSectionIndex ] = m_sectionWalkStamp;
+
+	m_sectionWalkQueue.clear();
+	m_sectionWalkQueue.push_back( cameraSection );
+
+	//Breadth-first, so each section is reached first along its shortest path from the camera.
+	for ( unsigned int visitIndex = 0; visitIndex < m_sectionWalkQueue.size(); visitIndex++ )
+	{
+		SectionVisit currentVisit = m_sectionWalkQueue[ visitIndex ]; //Copy, the push_backs below may reallocate.
+		Chunk* currentChunk = currentVisit.m_chunk;
+
+		if ( currentChunk->m_chunkVisitStamp != m_sectionWalkStamp )
+		{
+			currentChunk->m_chunkVisitStamp = m_sectionWalkStamp;
+			out_visibleChunks.push_back( currentChunk );
+		}
+
+		SectionConnectivity connectivity = currentChunk->GetSectionConnectivity( currentVisit.m_sectionIndex );
+		for ( int faceIndex = 0; faceIndex < NUM_SECTION_FACES; faceIndex++ )
+		{
+			SectionFace exitFace = (SectionFace)faceIndex;
+			if ( ( currentVisit.m_directionsTaken & BIT( GetOppositeSectionFace( exitFace ) ) ) != 0 )
+				continue;
+
+			if ( ( currentVisit.m_entryFace != NUM_SECTION_FACES ) && !AreSectionFacesConnected( connectivity, currentVisit.m_entryFace, exitFace ) )
+				continue;
+
+			int neighborSectionIndex;
+			Chunk* neighborChunk = GetChunkAcrossSectionFace( currentChunk, exitFace, currentVisit.m_sectionIndex, neighborSectionIndex );
+			if ( neighborChunk == nullptr )
+				continue;
+
+			if ( neighborChunk->m_sectionVisitStamps[ neighborSectionIndex ] == m_sectionWalkStamp )
+				continue;
+
+			neighborChunk->m_sectionVisitStamps[ neighborSectionIndex ] = m_sectionWalkStamp; //Even if culled below, no other path will see it either.
+			if ( g_useCulling && !m_viewFrustum.DoesOverlapAABB( neighborChunk->GetSectionBounds( neighborSectionIndex ) ) )
+				continue;
+
+			SectionVisit neighborVisit;
+			neighborVisit.m_chunk = neighborChunk;
+			neighborVisit.m_sectionIndex = neighborSectionIndex;
+			neighborVisit.m_entryFace = GetOppositeSectionFace( exitFace );
+			neighborVisit.m_directionsTaken = currentVisit.m_directionsTaken | BIT( exitFace );
+			m_sectionWalkQueue.push_back( neighborVisit );
+		}
+	}
+
+	return true;
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void World::Render() const
 {
+	PROFILE_SCOPE( "World::Render" );
+
 	g_chunksRendered = 0;
+	g_chunksCulled = 0;
+	g_chunksOccluded = 0;
 
 	if ( g_renderDebugInfo )
 		DrawDebugPoints( 10.f, true );
 
 	g_theRenderer->EnableDepthTesting( true );
 	m_player->Render();
+	m_entities.Render( m_activeDimension, m_fractionTowardThisTick );
 
 	const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
-	for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
+
+	std::vector< Chunk* > chunksToDraw;
+	std::vector< Chunk* > walkedChunks;
+	if ( g_useOcclusionCulling && CollectChunksVisibleThroughSections( walkedChunks ) )
+	{
+		for ( Chunk* walkedChunk : walkedChunks )
+			if ( IsChunkVisible( *walkedChunk ) ) //Its sections were in view, but its actual mesh may not be.
+				chunksToDraw.push_back( walkedChunk );
+
+		//Only for the debug counts: whatever the walk never reached was either outside the frustum or sealed off.
+		for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
+		{
+			const Chunk& chunk = *activeChunkPair.second;
+			if ( chunk.m_chunkVisitStamp == m_sectionWalkStamp )
+				continue;
+
+			if ( g_useCulling && !m_viewFrustum.DoesOverlapAABB( chunk.GetRenderBounds() ) )
+				++g_chunksCulled;
+			else
+				++g_chunksOccluded;
+		}
+	}
+	else
 	{
-		const Chunk& chunk = *activeChunkPair.second;
-		if ( IsChunkVisible( chunk ) )
-			RenderChunk( chunk );
+		for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
+			if ( IsChunkVisible( *activeChunkPair.second ) )
+				chunksToDraw.push_back( activeChunkPair.second );
 	}
+
+	SortChunksFrontToBack( m_playerCamera->m_worldPosition, chunksToDraw );
+
+	for ( const Chunk* chunk : chunksToDraw )
+		RenderChunk( *chunk );
+	m_lodTerrain.QueueVisibleTiles( m_viewFrustum ); //All beyond the chunks, so still roughly front to back.
+	DrawQueuedChunks();
+
+	RenderTranslucentChunks( chunksToDraw );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::DrawQueuedChunks( bool preserveQueueOrder /*= false*/ ) const
+{
+	//All chunks share the atlas, so it's bound once and every queued chunk goes out in one multi-draw per arena page.
+	g_theRenderer->BindTexture( g_textureAtlas->GetAtlasTexture() );
+	g_theRenderer->DrawQueuedArenaVertexes( TheRenderer::AS_QUADS, preserveQueueOrder );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::RenderTranslucentChunks( const std::vector< Chunk* >& chunksFrontToBack ) const
+{
+	//Blended, so drawn back to front over the finished opaque depth buffer, without writing depth of their own.
+	//Culling is off so water surfaces stay visible from underneath.
+	g_theRenderer->EnableDepthWriting( false );
+	g_theRenderer->EnableBackfaceCulling( false );
+
+	for ( std::vector< Chunk* >::const_reverse_iterator chunkIter = chunksFrontToBack.rbegin(); chunkIter != chunksFrontToBack.rend(); ++chunkIter )
+		( *chunkIter )->RenderTranslucent();
+	DrawQueuedChunks( true );
+
+	g_theRenderer->EnableBackfaceCulling( true );
+	g_theRenderer->EnableDepthWriting( true );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 void World::Update( float deltaSeconds )
 {
-	UpdateCameraAndPlayer( deltaSeconds ); //Because movement == camera == player.
+	PROFILE_SCOPE( "World::Update" );
+
+	g_chunksMeshed = 0;
+	g_chunksActivated = 0;
+	g_chunksFlushed = 0;
+	g_lightingNodesProcessed = 0;
+
+	UpdateFromFrameInput();
+
+	//Simulation advances in fixed ticks so physics, digging and streaming behave the same at any frame rate.
+	m_secondsOfSimulationOwed += deltaSeconds;
+	int numTicksRun = 0;
+	while ( m_secondsOfSimulationOwed >= SIMULATION_SECONDS_PER_TICK )
+	{
+		if ( numTicksRun == SIMULATION_MAX_CATCH_UP_TICKS_PER_FRAME )
+		{
+			m_secondsOfSimulationOwed = 0.f; //Drop the backlog rather than spiral, the world just runs slow through a long hitch.
+			break;
+		}
+
+		Tick( SIMULATION_SECONDS_PER_TICK );
+		m_secondsOfSimulationOwed -= SIMULATION_SECONDS_PER_TICK;
+		++numTicksRun;
+	}
+
+	InterpolateTransformsForRender( m_secondsOfSimulationOwed / SIMULATION_SECONDS_PER_TICK );
+
+	UpdateCameraAndSelection( deltaSeconds );
+
+	if ( g_updateVertexDataEnabled )
+		UpdateDirtyVertexArrays();
+
+	m_lodTerrain.Update( m_activeDimension, GetSkyLightLevel(), m_player->m_worldPosition, m_activeChunks[ m_activeDimension ] ); //After meshing, so tiles under fresh chunks go the same frame.
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::Tick( float tickSeconds )
+{
+	PROFILE_SCOPE( "World::Tick" );
+
+	++m_currentTick;
+
+	//Rendering left the transforms interpolated, so pick the simulation back up from where the last tick left them.
+	m_player->m_worldPosition = m_playerPositionThisTick;
+	m_playerCamera->m_worldPosition = m_cameraPositionThisTick;
+	m_playerPositionLastTick = m_playerPositionThisTick;
+	m_cameraPositionLastTick = m_cameraPositionThisTick;
+
+	UpdatePlayer( tickSeconds ); //Because movement == camera == player.
+
+	//Streaming below centers on the camera, so it has to follow the player here too, not only once per frame.
+	Vector3 camDirection = m_playerCamera->GetForwardXYZ();
+	camDirection.Normalize();
+	PlaceCameraRelativeToPlayer( m_playerCamera->m_worldPosition, m_player->m_worldPosition, camDirection );
+
+	m_playerPositionThisTick = m_player->m_worldPosition;
+	m_cameraPositionThisTick = m_playerCamera->m_worldPosition;
+
+	m_entities.Update( tickSeconds, m_blockQuery, m_activeDimension, m_playerPositionThisTick, m_landedFallingBlocks );
+	PlaceLandedFallingBlocks();
 
 	if ( g_flushChunksEnabled ) 
 		DeactivateFarthestObsoleteChunk(); //Deactivate comes before activate if for example close to memory limit, we wouldn't want to allocate when we can free first.
@@ -114,14 +399,26 @@ void World::Update( float deltaSeconds )
 	if ( g_activateChunksEnabled ) 
 		ActivateNearestMissingChunk(); //Name implies if there's more than one missing, we'll only activate one--and if none missing, none activated.		
 
+	FinishCompletedLightingJobs(); //Links chunks whose worker-thread lighting is done, then exchanges border light with neighbors.
+
 	UpdateChunks(); //I have a TNT that went off, started fires, etc. but I will also change lighting. i.e. these are events inside the chunk like grass propagating.
 
+	UpdateScheduledBlockTicks(); //Fluids and falling blocks, before lighting so their changes relight this same tick.
+
 	UpdateLighting(); //Because lights spill chunk to chunk, so it can't be in a chunk.
 		//Chunks hold the blocks that know they are dirty and their light levels--so in global list of lighting-dirty blocks, may or may not be same-chunk.
 		//"While they are any dirty blocks left, process the next lighting-dirty block."
+}
 
-	if ( g_updateVertexDataEnabled )
-		UpdateDirtyVertexArrays();
+
+//--------------------------------------------------------------------------------------------------------------
+void World::InterpolateTransformsForRender( float fractionTowardThisTick )
+{
+	//Blends the last two ticks rather than extrapolating, so what's drawn always lags by up to a tick but never overshoots into a wall.
+	m_fractionTowardThisTick = fractionTowardThisTick; //For the entities, blended as they're drawn.
+	m_player->m_worldPosition = m_playerPositionLastTick + ( ( m_playerPositionThisTick - m_playerPositionLastTick ) * fractionTowardThisTick );
+	m_playerCamera->m_worldPosition = m_cameraPositionLastTick + ( ( m_cameraPositionThisTick - m_cameraPositionLastTick ) * fractionTowardThisTick );
+	m_player->UpdateCollidersAndDigTime( 0.f ); //Just moves the colliders along for rendering, digging time only accrues in ticks.
 }
 
 
@@ -132,7 +429,7 @@ void World::CheckForDimensionWarp()
 	BlockType blockTypeAtPlayerFeet = GetBlockTypeFromWorldCoords( playerFeetPos );
 
 	//Dimension warping.
-	if ( ( blockTypeAtPlayerFeet == BlockType::PORTAL ) || g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_DIMENSION ) )
+	if ( ( blockTypeAtPlayerFeet == BlockType::PORTAL ) || m_wasDimensionWarpPressedSinceLastTick )
 	{
 		m_activeDimension = ( m_activeDimension == DIM_OVERWORLD ? DIM_NETHER : DIM_OVERWORLD );
 
@@ -183,11 +480,9 @@ void World::CheckForHotbarChange()
 
 
 //--------------------------------------------------------------------------------------------------------------
-void World::UpdateCameraAndPlayer( float deltaSeconds )
+void World::UpdateFromFrameInput()
 {
-	UnhighlightSelectedBlock(); //Dirties a chunk in process.
-
-	CheckForDimensionWarp();
+	ClearSelectedBlock(); //Reselected below unless the selection ray is skipped this frame.
 
 	CheckForHotbarChange();
 
@@ -200,24 +495,66 @@ void World::UpdateCameraAndPlayer( float deltaSeconds )
 		g_currentMovementMode = (MovementMode)boundedModeNumber;
 	}
 
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_PLAYER_COLLIDER ) ) 
+		g_renderPlayerCollider = !g_renderPlayerCollider;
+
+	//Presses only last a frame, which may run no ticks or several, so they're held until the next tick consumes them.
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_MOVE_UP ) )
+		m_wasJumpPressedSinceLastTick = true;
+
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_DIMENSION ) )
+		m_wasDimensionWarpPressedSinceLastTick = true;
+
+	if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_FORWARD ) )
+		m_wasForwardPressedSinceLastTick = true;
+	if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_BACKWARD ) )
+		m_wasBackwardPressedSinceLastTick = true;
+	if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_LEFT ) )
+		m_wasLeftPressedSinceLastTick = true;
+	if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_RIGHT ) )
+		m_wasRightPressedSinceLastTick = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::UpdatePlayer( float deltaSeconds )
+{
+	PROFILE_SCOPE( "World::UpdatePlayer" );
+
+	CheckForDimensionWarp();
+
 	Vector3& playerPos = m_player->m_worldPosition;
 	Vector3& cameraPos = m_playerCamera->m_worldPosition;
 	Vector3& posToMove = ( g_currentCameraMode == FREE_SPECTATOR ? cameraPos : playerPos );
 	Vector3 camForwardXY = m_playerCamera->GetForwardXY(); //Heading for forward/back.
 	Vector3 camLeftXY = m_playerCamera->GetLeftXY(); //Heading for strafing.
-	Vector3 camDirection = m_playerCamera->GetForwardXYZ();
-	camDirection.Normalize();
 	camLeftXY.Normalize();
 	camForwardXY.Normalize();
 
 	UpdateFromMovementKeys( deltaSeconds, camForwardXY, camLeftXY, posToMove );
 
-	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_PLAYER_COLLIDER ) ) 
-		g_renderPlayerCollider = !g_renderPlayerCollider;
-
 	m_player->UpdateCollidersAndDigTime( deltaSeconds );
 
-	UpdateMouseAndCameraOffset( cameraPos, playerPos, camDirection );
+	m_wasJumpPressedSinceLastTick = false;
+	m_wasDimensionWarpPressedSinceLastTick = false;
+	m_wasForwardPressedSinceLastTick = false;
+	m_wasBackwardPressedSinceLastTick = false;
+	m_wasLeftPressedSinceLastTick = false;
+	m_wasRightPressedSinceLastTick = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::UpdateCameraAndSelection( float deltaSeconds )
+{
+	PROFILE_SCOPE( "World::UpdateCameraAndSelection" );
+
+	Vector3& playerPos = m_player->m_worldPosition;
+	Vector3& cameraPos = m_playerCamera->m_worldPosition;
+	Vector3 camDirection = m_playerCamera->GetForwardXYZ();
+	camDirection.Normalize();
+
+	UpdateMouseAndCameraOffset( cameraPos, playerPos, camDirection ); //Off the interpolated player, so the view moves smoothly between ticks.
 
 	//Raycast enclosed by defensive code against rays cast from outside sky/ground limit.
 	if ( ( playerPos.z < 0 ) || ( playerPos.z > CHUNK_Z_HEIGHT_IN_BLOCKS ) )
@@ -242,14 +579,14 @@ void World::UpdateFromMovementKeys( float deltaSeconds, const Vector3& camForwar
 	//Player physics!
 	if ( g_theInput->IsKeyDown( KEY_TO_MOVE_BACKWARD ) )
 	{
-		if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_FORWARD ) ) 
+		if ( m_wasForwardPressedSinceLastTick ) 
 			playerVel *= ( 1.f - HORIZONTAL_DECEL_BEFORE_STOP_KNOB ); //Applying drag/friction-stop for moving abruptly in an opposite direction.
 
 		playerVel -= camForwardXY;
 	}
 	else if ( g_theInput->IsKeyDown( KEY_TO_MOVE_FORWARD ) )
 	{
-		if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_BACKWARD ) ) 
+		if ( m_wasBackwardPressedSinceLastTick ) 
 			playerVel *= ( 1.f - HORIZONTAL_DECEL_BEFORE_STOP_KNOB );
 
 		playerVel += camForwardXY;
@@ -257,14 +594,14 @@ void World::UpdateFromMovementKeys( float deltaSeconds, const Vector3& camForwar
 
 	if ( g_theInput->IsKeyDown( KEY_TO_MOVE_LEFT ) )
 	{
-		if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_RIGHT ) ) 
+		if ( m_wasRightPressedSinceLastTick ) 
 			playerVel *= ( 1.f - HORIZONTAL_DECEL_BEFORE_STOP_KNOB );
 
 		playerVel += camLeftXY;
 	}
 	else if ( g_theInput->IsKeyDown( KEY_TO_MOVE_RIGHT ) )
 	{
-		if ( g_theInput->WasKeyJustPressed( KEY_TO_MOVE_LEFT ) ) 
+		if ( m_wasLeftPressedSinceLastTick ) 
 			playerVel *= ( 1.f - HORIZONTAL_DECEL_BEFORE_STOP_KNOB );
 
 		playerVel -= camLeftXY;
@@ -272,7 +609,7 @@ void World::UpdateFromMovementKeys( float deltaSeconds, const Vector3& camForwar
 
 	playerVel.z += ( g_currentMovementMode == WALKING ) ? ( PLAYER_GRAVITY_FORCE * deltaSeconds ) : 0.f; //Note *dt makes it an accel.
 	
-	if ( g_theInput->WasKeyPressedOnce( KEY_TO_MOVE_UP ) && ( g_currentMovementMode == WALKING ) && IsPlayerOnGround() ) 
+	if ( m_wasJumpPressedSinceLastTick && ( g_currentMovementMode == WALKING ) && IsPlayerOnGround() ) 
 		playerVel.z += PLAYER_JUMP_SPEED * speedUp;
 
 	if ( g_currentMovementMode != WALKING )
@@ -360,75 +697,37 @@ Vector3 World::GetPhysicsCorrectedVelocityForDeltaSeconds( const Vector3& veloci
 	if ( g_currentMovementMode == NOCLIP ) 
 		return velocityToPrevent; //Allowed unscaled velocity to clip past solid blocks in Noclip mode.
 
-	//First implementation of preventive phyics: Scale down the velocity by the min of 12 raycasts from the player's box top, bottom, and midpoint's 4 corners.
-	RaycastResult3D minHitResult;
-	bool hitSomething = false;
-	Vector3 newRedirectedVelocity = velocityToPrevent; //Initial start at the unscaled, uncorrected velocity values.
-	Vector3 lastIterationVelocity;
-
-	while ( ( newRedirectedVelocity != lastIterationVelocity ) || ( newRedirectedVelocity == Vector3::ZERO ) )
-	{
-		lastIterationVelocity = newRedirectedVelocity; //If the latter hasn't changed by end of loop, nothing to re-check and we're done.
-		Vector3 newPositionBeforeCorrection = m_player->m_worldPosition + ( newRedirectedVelocity * deltaSeconds );
-
-		if ( !g_useAmanWooRaycastOverStepAndSample )
-		{
-			hitSomething = BoxTraceWithStepAndSample( m_player->m_worldPosition, newPositionBeforeCorrection, minHitResult );
-		}
-		else
-		{
-			hitSomething = BoxTraceWithAmanatidesWoo( m_player->m_worldPosition, newPositionBeforeCorrection, minHitResult );
-		}
-
-		if ( !hitSomething ) 
-			return newRedirectedVelocity; //Move without any further correction if not hitting anything, but it may have had correction in past iteration so can't just return velocityToPrevent.
-
-		//Had a problem where with gravity you had constant 0% impact fraction against floor--zeroing x and y via scaling by impactFraction, when it should have been 1 - impactFraction.
-		float redirectionScalar = ( 1.0f - minHitResult.impactFraction );
+	if ( deltaSeconds <= 0.f )
+		return velocityToPrevent;
 
-		//Direction opposite selected face AKA surface normal.
-		Vector3 directionOppositeCollidedBlock = FindDirectionBetweenBlocks( minHitResult.penultimateBlockHit, minHitResult.lastBlockHit );
-		if ( directionOppositeCollidedBlock == Vector3::ZERO ) 
-			return Vector3::ZERO; //e.g. penultimate and ultimate block hit were the same block.
+	//One swept pass resolves all three axes, so sliding along several faces no longer re-traces the whole box per face.
+	const Vector3 playerHalfExtents = Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT );
+	Vector3 desiredDisplacement = velocityToPrevent * deltaSeconds;
+	SweptBoxResult sweepResult;
+	SweepBoxThroughSolidBlocks( m_blockQuery, m_activeDimension, m_player->m_worldPosition, playerHalfExtents, desiredDisplacement, sweepResult );
 
-		//If we collided with a stairs slab, check for an existing block above and push upward, then re-run physics.
-		if ( !( ( directionOppositeCollidedBlock == WORLD_DOWN ) || ( directionOppositeCollidedBlock == WORLD_UP ) ) && ( minHitResult.lastBlockHit.GetBlock()->GetBlockType() == STAIRS ) )
+	//Stairs: a separate query for whether the box fits a step up and over, in which case the horizontal move goes ahead.
+	if ( sweepResult.m_wasBlockedByStairs && ( g_currentMovementMode == WALKING ) )
+	{
+		Vector3 steppedUpDestination = m_player->m_worldPosition + STAIR_BOOST + Vector3( desiredDisplacement.x, desiredDisplacement.y, 0.f );
+		if ( IsBoxClearOfSolidBlocks( m_blockQuery, m_activeDimension, m_player->m_worldPosition + STAIR_BOOST, playerHalfExtents )
+			&& IsBoxClearOfSolidBlocks( m_blockQuery, m_activeDimension, steppedUpDestination, playerHalfExtents ) )
 		{
-			BlockInfo blockAboveStairs = minHitResult.lastBlockHit;
-
-			do
-			{
-				blockAboveStairs.StepUp();
-			} 
-			while ( blockAboveStairs.GetBlock()->GetBlockType() == STAIRS );
-
-			if ( BlockDefinition::IsSolid( blockAboveStairs.GetBlock()->GetBlockType() ) )
-				continue;
-
 			posToMove += STAIR_BOOST;
+			return Vector3( velocityToPrevent.x, velocityToPrevent.y, 0.f );
 		}
-
-		//Redirect prior iteration's velocity to slide by the % we moved when we had the collision into dimensions EXCEPTING the one the hit occurred in.
-		if ( ( directionOppositeCollidedBlock == WORLD_DOWN ) || ( directionOppositeCollidedBlock == WORLD_UP ) )
-		{
-			newRedirectedVelocity = Vector3( newRedirectedVelocity.x * redirectionScalar, newRedirectedVelocity.y * redirectionScalar, 0.f );
-		}
-		else if ( ( directionOppositeCollidedBlock == WORLD_LEFT ) || ( directionOppositeCollidedBlock == WORLD_RIGHT ) )
-		{
-			newRedirectedVelocity = Vector3( newRedirectedVelocity.x * redirectionScalar, 0.f, newRedirectedVelocity.z * redirectionScalar );
-		}
-		else if ( ( directionOppositeCollidedBlock == WORLD_FORWARD ) || ( directionOppositeCollidedBlock == WORLD_BACKWARD ) )
-		{
-			newRedirectedVelocity = Vector3( 0.f, newRedirectedVelocity.y * redirectionScalar, newRedirectedVelocity.z * redirectionScalar );
-		}
-		else break; //Nothing redirected!
-
-		if ( newRedirectedVelocity == Vector3::ZERO ) 
-			break; //No possibility of shoving into block (assuming we aren't in one already), can exit loop.
-		
 	}
 
-	return newRedirectedVelocity;
+	//Blocked axes keep only the velocity that carries the box up to the face it hit.
+	Vector3 correctedVelocity = velocityToPrevent;
+	if ( sweepResult.m_wasAxisBlocked[ 0 ] )
+		correctedVelocity.x = sweepResult.m_allowedDisplacement.x / deltaSeconds;
+	if ( sweepResult.m_wasAxisBlocked[ 1 ] )
+		correctedVelocity.y = sweepResult.m_allowedDisplacement.y / deltaSeconds;
+	if ( sweepResult.m_wasAxisBlocked[ 2 ] )
+		correctedVelocity.z = sweepResult.m_allowedDisplacement.z / deltaSeconds;
+
+	return correctedVelocity;
 }
 
 
@@ -445,446 +744,84 @@ BlockType World::GetBlockTypeFromWorldCoords( const WorldCoords& wc )
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool World::BoxTraceWithStepAndSample( const Vector3& rayStartPos, const Vector3& rayEndPos, RaycastResult3D& minHitResult )
+void World::UpdateMouseAndCameraOffset( Vector3& cameraPos, Vector3& playerPos, Vector3 camDirection )
 {
-	RaycastResult3D hitResult; //Take the first raycast that hits something and use it to scale back the velocity vector preventively.
-	
-	//Top of player bounding box, front-left corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	minHitResult = hitResult;
-
-	//Top of player bounding box, front-right corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Top of player bounding box, back-right corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Top of player bounding box, back-left corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, front-left corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, front-right corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, back-right corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, back-left corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, front-left corner.`
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, front-right corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, back-right corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, back-left corner.
-	RaycastWithStepAndSample(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	if ( minHitResult.impactFraction > .999f ) //Afforded error tolerance at .001.
-		return false; //No collisions, move forward without scaling back player velocity vector.
-	else 
-		return true;
+	const float mouseSensitivityYaw = 0.044f;
+	m_playerCamera->m_orientation.m_yawDegreesAboutZ -= mouseSensitivityYaw * (float)g_theInput->GetCursorDeltaX();
+	m_playerCamera->m_orientation.m_pitchDegreesAboutY += mouseSensitivityYaw * (float)g_theInput->GetCursorDeltaY();
+	m_playerCamera->FixAndClampAngles();
+
+	//Push camera to correct offset relative to player based on movement mode.
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_CAMERA ) ) g_currentCameraMode = (CameraMode)WrapNumberWithinCircularRange( g_currentCameraMode + 1, 0, NUM_CAMERA_MODES );
+
+	PlaceCameraRelativeToPlayer( cameraPos, playerPos, camDirection );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-bool World::BoxTraceWithAmanatidesWoo( const Vector3& rayStartPos, const Vector3& rayEndPos, RaycastResult3D& minHitResult )
-{
-	RaycastResult3D hitResult; //Take the first raycast that hits something and use it to scale back the velocity vector preventively.
-
-	//Top of player bounding box, front-left corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	minHitResult = hitResult;
-
-	//Top of player bounding box, front-right corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Top of player bounding box, back-right corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Top of player bounding box, back-left corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, front-left corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, front-right corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, back-right corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Middle of player bounding box, back-left corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, 0.f ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, front-left corner.`
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, front-right corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, back-right corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, -PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	//Bottom of player bounding box, back-left corner.
-	RaycastWithAmanatidesWoo(
-		rayStartPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ),
-		rayEndPos + Vector3( -PLAYER_HALF_WIDTH, PLAYER_HALF_WIDTH, -PLAYER_HALF_HEIGHT ), hitResult );
-	if ( minHitResult.impactFraction > hitResult.impactFraction )
-		minHitResult = hitResult;
-
-	if ( minHitResult.impactFraction > .999f ) //Afforded error tolerance at .001.
-		return false; //No collisions, move forward without scaling back player velocity vector.
-	else 
-		return true;
+STATIC void World::PlaceCameraRelativeToPlayer( Vector3& cameraPos, const Vector3& playerPos, const Vector3& camDirection )
+{
+	constexpr float FIXED_SPECTATOR_ARM_DISTANCE = 10.f;
+	const Vector3 FIXED_SPECTATOR_ARM_DISPLACEMENT = Vector3( FIXED_SPECTATOR_ARM_DISTANCE, FIXED_SPECTATOR_ARM_DISTANCE, FIXED_SPECTATOR_ARM_DISTANCE );
+
+	switch ( g_currentCameraMode )
+	{
+		case FIRST_PERSON: cameraPos = playerPos + Vector3( 0.f, 0.f, PLAYER_HEIGHT - CAMERA_FIRST_PERSON_HEIGHT ); break;
+		case FIXED_SPECTATOR: cameraPos = playerPos + FIXED_SPECTATOR_ARM_DISPLACEMENT; break;
+		case FROM_BEHIND: cameraPos = playerPos + ( -camDirection * CAMERA_FROM_BEHIND_PUSHBACK_LENGTH ); break;
+	}
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
-//WARNING, Did not work: need to check 8 blocks around each new position, as the box can snag at any of its corners.
-bool World::BoxTraceWithAmanatidesWoo( Vector3 boxCenterStartPos, Vector3 boxCenterEndPos, float boxHalfLengthX, float boxHalfWidthY, float boxHalfHeightZ, RaycastResult3D& out_result )
+void World::DeactivateFarthestObsoleteChunk()
 {
-	BlockInfo originBlockInfo = GetBlockInfoFromWorldCoords( boxCenterStartPos );
-	if ( originBlockInfo.m_myChunk == nullptr ) 
-		return false;
+	std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
+	if ( activeChunksInActiveDimension.size() <= 0 )
+		return;
 
-	//Initialization of Raycast -- NEED TO TAKE THE MINS OF EACH OF THE 8 CORNERS OF OUR PLAYER, AS WE CAN OVERLAP UP TO 8 BLOCKS THAT MAY BE SOLID!
-	BlockInfo initialCheckingBlockInfo;
-	GlobalBlockCoords currentCheckingBlockPos;
-	for ( int initialCheckingBlockIndex = 0; initialCheckingBlockIndex < 8; initialCheckingBlockIndex++ )
+	//Find chunk.
+	Chunk* farthestObsoleteChunk = nullptr;
+	for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
 	{
-		switch ( initialCheckingBlockIndex )
+		Chunk* currentChunk = activeChunkPair.second;
+		if ( IsChunkBeyondFlushRadius( currentChunk ) ) //Even if true, another chunk may be farther away.
 		{
-		case 0: //upperBackLeftBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x + boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y + boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z + boxHalfHeightZ );
-		case 1: //upperFrontLeftBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x - boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y + boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z + boxHalfHeightZ );
-		case 2: //upperBackRightBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x - boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y - boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z + boxHalfHeightZ );
-		case 3: //upperFrontRightBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x + boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y - boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z + boxHalfHeightZ );
-		case 4: //lowerBackLeftBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x + boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y + boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z - boxHalfHeightZ );
-		case 5: //lowerFrontLeftBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x - boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y + boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z - boxHalfHeightZ );
-		case 6: //lowerBackRightBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x - boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y - boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z - boxHalfHeightZ );
-		case 7: //lowerFrontRightBlockPos
-			currentCheckingBlockPos.x = (int)floor( boxCenterStartPos.x + boxHalfLengthX );
-			currentCheckingBlockPos.y = (int)floor( boxCenterStartPos.y - boxHalfWidthY );
-			currentCheckingBlockPos.z = (int)floor( boxCenterStartPos.z - boxHalfHeightZ );
+			if ( farthestObsoleteChunk == nullptr )
+			{
+				farthestObsoleteChunk = currentChunk;
+			}
+			else
+			{
+				farthestObsoleteChunk = GetChunkFartherFromPlayer( farthestObsoleteChunk, currentChunk );
+			}
 		}
+	}
 
-		initialCheckingBlockInfo = GetBlockInfoFromGlobalBlockCoords( currentCheckingBlockPos );
+	if ( farthestObsoleteChunk != nullptr )
+	{
+		FlushChunk( farthestObsoleteChunk );
 
-		if ( initialCheckingBlockInfo.m_myChunk->IsBlockSolid( initialCheckingBlockInfo.m_myBlockIndex ) ) //Are initial blocks solid?
-		{
-			out_result.penultimateBlockHit = out_result.lastBlockHit = initialCheckingBlockInfo;
-			out_result.impactFraction = 0.f;
-			out_result.impactPosition = boxCenterStartPos;
-			return true;
-		}
+		//Past the flush radius by a cell, no chunk we could still activate would stamp from it.
+		WorldCoordsXY playerPos = WorldCoordsXY( m_playerCamera->m_worldPosition.x, m_playerCamera->m_worldPosition.y );
+		m_structureRegistry.ForgetCellsBeyondRadius( m_activeDimension, playerPos, (float)( m_flushRadius + VILLAGE_REGISTRY_CELL_SIZE_IN_BLOCKS ) );
 	}
+}
 
-	/////////////////////////////////////////////////////////////
 
-	GlobalBlockCoords blockPos = GlobalBlockCoords(
-		(int)floor( boxCenterStartPos.x ),
-		(int)floor( boxCenterStartPos.y ),
-		(int)floor( boxCenterStartPos.z )
-	);
+//--------------------------------------------------------------------------------------------------------------
+void World::ActivateNearestMissingChunk() //Possible future optimization: amortize over all dimensions. Currently unnecessary.
+{
+	PROFILE_SCOPE( "World::ActivateNearestMissingChunk" );
 
-	Vector3 rayDisplacement = boxCenterEndPos - boxCenterStartPos;
-	float totalRayLength = rayDisplacement.CalcLength();
+	//Loop around the player position +- active radius.
+	WorldCoords playerPos = m_playerCamera->m_worldPosition;
 
-	//tDelta: how much t it takes to cross to the next x/y/z.
-	float tDeltaX = abs( 1.0f / rayDisplacement.x );
-	float tDeltaY = abs( 1.0f / rayDisplacement.y );
-	float tDeltaZ = abs( 1.0f / rayDisplacement.z );
-
-	//Which direction to step along, computable because a ray's dir is constant.
-	int tileStepX = ( rayDisplacement.x > 0 ) ? 1 : -1;
-	int tileStepY = ( rayDisplacement.y > 0 ) ? 1 : -1;
-	int tileStepZ = ( rayDisplacement.z > 0 ) ? 1 : -1;
-
-	//0 or 1 fudge factor, and the 0 means that casts in negative directions have first intersection at the above block-mins (see blockPos init above).
-	int offsetToLeadingEdgeX = ( tileStepX + 1 ) >> 1; //replaces div by 2^1.
-	int offsetToLeadingEdgeY = ( tileStepY + 1 ) >> 1;
-	int offsetToLeadingEdgeZ = ( tileStepZ + 1 ) >> 1;
-
-	//This is just the next crossing in the world that changes integer parts of our world positions, INDEPENDENT of player box bounds.
-	float firstIntersectionOnX = (float)( blockPos.x + offsetToLeadingEdgeX );
-	float firstIntersectionOnY = (float)( blockPos.y + offsetToLeadingEdgeY );
-	float firstIntersectionOnZ = (float)( blockPos.z + offsetToLeadingEdgeZ );
-
-	//How many "t's" it takes to reach the next intersection with the world from the start position -- NEED TO TAKE MINS OF EACH OF THE CORNERS?
-	float tOfNextCrossingOnX = abs( firstIntersectionOnX - ( boxCenterStartPos.x + ( boxHalfLengthX * tileStepX ) ) ) * tDeltaX;
-	float tOfNextCrossingOnY = abs( firstIntersectionOnY - ( boxCenterStartPos.y + ( boxHalfWidthY * tileStepY ) ) ) * tDeltaY;
-	float tOfNextCrossingOnZ = abs( firstIntersectionOnZ - ( boxCenterStartPos.z + ( boxHalfHeightZ * tileStepZ ) ) ) * tDeltaZ;
-
-	//Main Loop of Regan-cast
-	BlockInfo currentBlockInfo = originBlockInfo;
-	BlockInfo blockBeforeCurrentInfo;
-
-	bool shutUpVisualStudioWarning = true;
-	while ( shutUpVisualStudioWarning ) // Loop until impact or end of line segment.
-	{
-		//Find min of tOfNextCrossingOnX,Y,Z to determine what line gets crossed next.
-
-		//if OnX is lowest
-		if ( ( tOfNextCrossingOnX < tOfNextCrossingOnY ) && ( tOfNextCrossingOnX < tOfNextCrossingOnZ ) )
-		{
-			if ( tOfNextCrossingOnX > 1 ) 
-				return false; //No impact, i.e. next crossing past endpoint.
-
-			blockPos.x += tileStepX; //move into next tile on x
-			currentBlockInfo = GetBlockInfoFromGlobalBlockCoords( blockPos );
-			if ( currentBlockInfo.m_myChunk == nullptr ) 
-				return false;
-
-			if ( currentBlockInfo.m_myChunk->IsBlockSolid( currentBlockInfo.m_myBlockIndex ) ) //Impact.
-			{
-				out_result.lastBlockHit = currentBlockInfo;
-				out_result.penultimateBlockHit = blockBeforeCurrentInfo;
-				out_result.impactPosition = boxCenterStartPos + ( rayDisplacement * tOfNextCrossingOnX );
-				WorldCoords displacementToImpact = out_result.impactPosition - boxCenterStartPos;
-				float steppedRayLength = displacementToImpact.CalcLength();
-				out_result.impactFraction = ( steppedRayLength / totalRayLength );
-
-				return true;
-			}
-			else tOfNextCrossingOnX += tDeltaX; //Move t to next crossing onX.			
-		}
-
-		//if OnY is lowest
-		else if ( ( tOfNextCrossingOnY < tOfNextCrossingOnX ) && ( tOfNextCrossingOnY < tOfNextCrossingOnZ ) )
-		{
-			if ( tOfNextCrossingOnY > 1 ) 
-				return false; //No impact, i.e. next crossing past endpoint.
-
-			blockPos.y += tileStepY; //move into next tile on y
-			currentBlockInfo = GetBlockInfoFromGlobalBlockCoords( blockPos );
-			if ( currentBlockInfo.m_myChunk == nullptr )
-				return false;
-
-			if ( currentBlockInfo.m_myChunk->IsBlockSolid( currentBlockInfo.m_myBlockIndex ) ) //Impact.
-			{
-				out_result.lastBlockHit = currentBlockInfo;
-				out_result.penultimateBlockHit = blockBeforeCurrentInfo;
-				out_result.impactPosition = boxCenterStartPos + ( rayDisplacement * tOfNextCrossingOnY );
-				WorldCoords displacementToImpact = out_result.impactPosition - boxCenterStartPos;
-				float steppedRayLength = displacementToImpact.CalcLength();
-				out_result.impactFraction = ( steppedRayLength / totalRayLength );
-				
-				return true;
-			}
-			else tOfNextCrossingOnY += tDeltaY; //Move t to next crossing onY.
-		}
-
-		// tOfNextCrossingOnZ is lowest
-		else
-		{
-			if ( tOfNextCrossingOnZ > 1 ) 
-				return false; //No impact, i.e. next crossing past endpoint.
-
-			blockPos.z += tileStepZ; //move into next tile on z
-			currentBlockInfo = GetBlockInfoFromGlobalBlockCoords( blockPos );
-			if ( currentBlockInfo.m_myChunk == nullptr ) 
-				return false;
-
-			if ( currentBlockInfo.m_myChunk->IsBlockSolid( currentBlockInfo.m_myBlockIndex ) ) //Impact.
-			{
-				out_result.lastBlockHit = currentBlockInfo;
-				out_result.penultimateBlockHit = blockBeforeCurrentInfo;
-				out_result.impactPosition = boxCenterStartPos + ( rayDisplacement * tOfNextCrossingOnZ );
-				WorldCoords displacementToImpact = out_result.impactPosition - boxCenterStartPos;
-				float steppedRayLength = displacementToImpact.CalcLength();
-				out_result.impactFraction = ( steppedRayLength / totalRayLength );
-
-				return true;
-			}
-			else tOfNextCrossingOnZ += tDeltaZ; //Move t to next crossing onZ.
-		}
-
-		blockBeforeCurrentInfo = currentBlockInfo;
-	}
-
-	return false;
-}
-
-
-//--------------------------------------------------------------------------------------------------------------
-void World::UpdateMouseAndCameraOffset( Vector3& cameraPos, Vector3& playerPos, Vector3 camDirection )
-{
-	const float mouseSensitivityYaw = 0.044f;
-	m_playerCamera->m_orientation.m_yawDegreesAboutZ -= mouseSensitivityYaw * (float)g_theInput->GetCursorDeltaX();
-	m_playerCamera->m_orientation.m_pitchDegreesAboutY += mouseSensitivityYaw * (float)g_theInput->GetCursorDeltaY();
-	m_playerCamera->FixAndClampAngles();
-
-	//Push camera to correct offset relative to player based on movement mode.
-	if ( g_theInput->WasKeyPressedOnce( KEY_TO_TOGGLE_CAMERA ) ) g_currentCameraMode = (CameraMode)WrapNumberWithinCircularRange( g_currentCameraMode + 1, 0, NUM_CAMERA_MODES );
-
-	constexpr float FIXED_SPECTATOR_ARM_DISTANCE = 10.f;
-	const Vector3 FIXED_SPECTATOR_ARM_DISPLACEMENT = Vector3( FIXED_SPECTATOR_ARM_DISTANCE, FIXED_SPECTATOR_ARM_DISTANCE, FIXED_SPECTATOR_ARM_DISTANCE );
-
-	switch ( g_currentCameraMode )
-	{
-		case FIRST_PERSON: cameraPos = playerPos + Vector3( 0.f, 0.f, PLAYER_HEIGHT - CAMERA_FIRST_PERSON_HEIGHT ); break;
-		case FIXED_SPECTATOR: cameraPos = playerPos + FIXED_SPECTATOR_ARM_DISPLACEMENT; break;
-		case FROM_BEHIND: cameraPos = playerPos + ( -camDirection * CAMERA_FROM_BEHIND_PUSHBACK_LENGTH ); break;
-	}
-}
-
-
-//--------------------------------------------------------------------------------------------------------------
-void World::DeactivateFarthestObsoleteChunk()
-{
-	std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
-	if ( activeChunksInActiveDimension.size() <= 0 )
-		return;
-
-	//Find chunk.
-	Chunk* farthestObsoleteChunk = nullptr;
-	for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
-	{
-		Chunk* currentChunk = activeChunkPair.second;
-		if ( IsChunkBeyondFlushRadius( currentChunk ) ) //Even if true, another chunk may be farther away.
-		{
-			if ( farthestObsoleteChunk == nullptr )
-			{
-				farthestObsoleteChunk = currentChunk;
-			}
-			else
-			{
-				farthestObsoleteChunk = GetChunkFartherFromPlayer( farthestObsoleteChunk, currentChunk );
-			}
-		}
-	}
-
-	if ( farthestObsoleteChunk != nullptr )
-		FlushChunk( farthestObsoleteChunk );
-}
-
-
-//--------------------------------------------------------------------------------------------------------------
-void World::ActivateNearestMissingChunk() //Possible future optimization: amortize over all dimensions. Currently unnecessary.
-{
-	//Loop around the player position +- active radius.
-	WorldCoords playerPos = m_playerCamera->m_worldPosition;
-
-	WorldCoordsXY searchMins = WorldCoordsXY( playerPos.x - m_activeRadius, playerPos.y - m_activeRadius ); //Start from mins.
-	WorldCoordsXY searchMaxs = WorldCoordsXY( playerPos.x + m_activeRadius, playerPos.y + m_activeRadius );
-	WorldCoordsXY currentChunkInWorldPos = searchMins;
-	WorldCoordsXY closestUnloadedChunkInWorldPos;
-	bool foundCandidate = false;
+	WorldCoordsXY searchMins = WorldCoordsXY( playerPos.x - m_activeRadius, playerPos.y - m_activeRadius ); //Start from mins.
+	WorldCoordsXY searchMaxs = WorldCoordsXY( playerPos.x + m_activeRadius, playerPos.y + m_activeRadius );
+	WorldCoordsXY currentChunkInWorldPos = searchMins;
+	WorldCoordsXY closestUnloadedChunkInWorldPos;
+	bool foundCandidate = false;
 
 	int searchDiameter = 2 * m_activeRadius;
 	int numChunksSearched = (searchDiameter * searchDiameter) / NUM_COLUMNS_PER_CHUNK; //Square search.
@@ -893,7 +830,7 @@ void World::ActivateNearestMissingChunk() //Possible future optimization: amorti
 		//Candidacy check--even if true, another chunk may be closer.
 		ChunkCoords asCC = GetChunkCoordsFromWorldCoordsXY( currentChunkInWorldPos );
 
-		if ( m_activeChunks[ m_activeDimension ].count( asCC ) == 0 && IsChunkWithinActiveRadius( currentChunkInWorldPos ) )
+		if ( m_activeChunks[ m_activeDimension ].count( asCC ) == 0 && !IsChunkAwaitingLighting( asCC ) && IsChunkWithinActiveRadius( currentChunkInWorldPos ) )
 		{
 			closestUnloadedChunkInWorldPos = ( foundCandidate ? GetChunkPosNearerToPlayer( closestUnloadedChunkInWorldPos, currentChunkInWorldPos ) 
 															  : currentChunkInWorldPos );
@@ -920,6 +857,8 @@ void World::ActivateNearestMissingChunk() //Possible future optimization: amorti
 //--------------------------------------------------------------------------------------------------------------
 void World::UpdateDirtyVertexArrays()
 {
+	PROFILE_SCOPE( "World::UpdateDirtyVertexArrays" );
+
 	const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
 	for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
 	{
@@ -1006,8 +945,12 @@ void World::FlushChunk( Chunk* obsoleteChunk )
 		SaveBufferToBinaryFile( Stringf( "Data/Saves/%s/Chunk_at_(%i,%i).chunk", dimensionName, cc.x, cc.y ), rleBuffer );
 	}
 
+	m_blockQuery.ForgetChunk( obsoleteChunk );
+	if ( m_selectedBlock.m_myChunk == obsoleteChunk )
+		ClearSelectedBlock();
 	delete obsoleteChunk;
 	m_activeChunks[ m_activeDimension ].erase( cc );
+	++g_chunksFlushed;
 }
 
 
@@ -1068,18 +1011,16 @@ void World::LoadPlayerFile( const std::string& filePath )
 //--------------------------------------------------------------------------------------------------------------
 void World::CreateOrLoadChunk( const ChunkCoords& unloadedChunkPos )
 {
-	Chunk* newChunk = new Chunk( unloadedChunkPos, m_activeDimension );
-	m_activeChunks[ m_activeDimension ][ unloadedChunkPos ] = newChunk; //Nothing populates it yet.
+	PROFILE_SCOPE( "World::CreateOrLoadChunk" );
 
-	//Neighbor pointer configuration.
-	UpdateNeighborPointers( newChunk );
+	Chunk* newChunk = new Chunk( unloadedChunkPos, m_activeDimension ); //Not in m_activeChunks until lit, see LinkLitChunkIntoWorld.
 
 	//Check if the chunk has a save file.
 	std::vector< unsigned char > out_buffer;
 
 	if ( g_disableLoading )
 	{
-		newChunk->PopulateChunkWithPerlinNoise();
+		newChunk->PopulateChunkWithPerlinNoise( m_structureRegistry );
 	}
 	else 
 	{
@@ -1089,11 +1030,87 @@ void World::CreateOrLoadChunk( const ChunkCoords& unloadedChunkPos )
 		if ( fileOperationSuccess )
 			newChunk->PopulateChunkWithRleString( out_buffer );
 		else
-			newChunk->PopulateChunkWithPerlinNoise();
+			newChunk->PopulateChunkWithPerlinNoise( m_structureRegistry );
+	}
+
+	//Intra-chunk lighting goes wide, as nothing else can see the chunk before it's linked.
+	ChunkLightingJob lightingJob;
+	lightingJob.m_chunk = newChunk;
+	lightingJob.m_localLightingResult = std::async( std::launch::async, &Chunk::InitializeLocalLighting, newChunk );
+	m_chunksAwaitingLighting.push_back( std::move( lightingJob ) );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::FinishCompletedLightingJobs()
+{
+	while ( !m_chunksAwaitingLighting.empty() )
+	{
+		ChunkLightingJob& oldestJob = m_chunksAwaitingLighting.front();
+		if ( oldestJob.m_localLightingResult.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+			break; //Later jobs wait their turn even if already done, keeping link order deterministic.
+
+		oldestJob.m_localLightingResult.get();
+		LinkLitChunkIntoWorld( oldestJob.m_chunk );
+		m_chunksAwaitingLighting.pop_front();
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::LinkLitChunkIntoWorld( Chunk* litChunk )
+{
+	m_activeChunks[ litChunk->GetDimension() ][ litChunk->GetChunkCoords() ] = litChunk;
+	++g_chunksActivated;
+
+	//Neighbor pointer configuration.
+	UpdateNeighborPointers( litChunk );
+
+	//Cross-border phase: only the two block layers along each seam can disagree, so only they go through m_dirtyBlocks.
+	if ( litChunk->m_northNeighbor != nullptr )
+	{
+		MarkChunkBorderLightingDirty( litChunk, ChunkCoords( 1, 0 ) );
+		MarkChunkBorderLightingDirty( litChunk->m_northNeighbor, ChunkCoords( -1, 0 ) );
+	}
+	if ( litChunk->m_southNeighbor != nullptr )
+	{
+		MarkChunkBorderLightingDirty( litChunk, ChunkCoords( -1, 0 ) );
+		MarkChunkBorderLightingDirty( litChunk->m_southNeighbor, ChunkCoords( 1, 0 ) );
+	}
+	if ( litChunk->m_westNeighbor != nullptr )
+	{
+		MarkChunkBorderLightingDirty( litChunk, ChunkCoords( 0, 1 ) );
+		MarkChunkBorderLightingDirty( litChunk->m_westNeighbor, ChunkCoords( 0, -1 ) );
+	}
+	if ( litChunk->m_eastNeighbor != nullptr )
+	{
+		MarkChunkBorderLightingDirty( litChunk, ChunkCoords( 0, -1 ) );
+		MarkChunkBorderLightingDirty( litChunk->m_eastNeighbor, ChunkCoords( 0, 1 ) );
+	}
+
+	if ( g_renderSkyBlocksAsDebugPoints ) //Kept off the worker since g_debugPoints isn't thread-safe.
+	{
+		for ( int blockIndex = 0; blockIndex < NUM_COLUMNS_PER_CHUNK * ( SEA_LEVEL_HEIGHT_LIMIT + 4 ); blockIndex++ ) //Adjust height as desired for debug tests.
+		{
+			if ( litChunk->GetBlockFromLocalBlockIndex( blockIndex )->IsSky() )
+				AddDebugPoint( litChunk->GetWorldCoordsFromLocalBlockIndex( blockIndex ) + Vector3( .5f, .5f, .5f ), Rgba( 1.f, 0.f, 0.f ) );
+		}
+	}
+
+	litChunk->RebuildVertexArray();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool World::IsChunkAwaitingLighting( const ChunkCoords& chunkPos ) const
+{
+	for ( const ChunkLightingJob& lightingJob : m_chunksAwaitingLighting )
+	{
+		if ( ( lightingJob.m_chunk->GetDimension() == m_activeDimension ) && ( lightingJob.m_chunk->GetChunkCoords() == chunkPos ) )
+			return true;
 	}
 
-	InitializeLightingForChunk( newChunk );
-	newChunk->RebuildVertexArray( );
+	return false;
 }
 
 
@@ -1101,7 +1118,7 @@ void World::CreateOrLoadChunk( const ChunkCoords& unloadedChunkPos )
 void World::UpdateNeighborPointers( Chunk* newChunk )
 {
 	ChunkCoords newChunkPos = newChunk->GetChunkCoords();
-	std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
+	std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ newChunk->GetDimension() ]; //May have warped while it was being lit.
 
 	//North.
 	ChunkCoords tmpCoords = ChunkCoords( newChunkPos.x + 1, newChunkPos.y );
@@ -1111,7 +1128,6 @@ void World::UpdateNeighborPointers( Chunk* newChunk )
 		newChunk->m_northNeighbor = neighborOfNewChunk;
 		neighborOfNewChunk->m_southNeighbor = newChunk;
 		neighborOfNewChunk->MarkVertexArrayDirty();
-		MarkChunkLightingDirty( neighborOfNewChunk );
 	}
 	else newChunk->m_northNeighbor = nullptr;
 
@@ -1123,7 +1139,6 @@ void World::UpdateNeighborPointers( Chunk* newChunk )
 		newChunk->m_southNeighbor = neighborOfNewChunk;
 		neighborOfNewChunk->m_northNeighbor = newChunk;
 		neighborOfNewChunk->MarkVertexArrayDirty();
-		MarkChunkLightingDirty( neighborOfNewChunk );
 	}
 	else newChunk->m_southNeighbor = nullptr;
 
@@ -1136,7 +1151,6 @@ void World::UpdateNeighborPointers( Chunk* newChunk )
 		newChunk->m_westNeighbor = neighborOfNewChunk;
 		neighborOfNewChunk->m_eastNeighbor = newChunk;
 		neighborOfNewChunk->MarkVertexArrayDirty( );
-		MarkChunkLightingDirty( neighborOfNewChunk );
 	}
 	else newChunk->m_westNeighbor = nullptr;
 
@@ -1148,7 +1162,6 @@ void World::UpdateNeighborPointers( Chunk* newChunk )
 		newChunk->m_eastNeighbor = neighborOfNewChunk;
 		neighborOfNewChunk->m_westNeighbor = newChunk;
 		neighborOfNewChunk->MarkVertexArrayDirty();
-		MarkChunkLightingDirty( neighborOfNewChunk );
 	}
 	else newChunk->m_eastNeighbor = nullptr;
 }
@@ -1212,23 +1225,22 @@ void World::SelectBlock( const WorldCoords& selectorsPos, const WorldCoords& end
 
 	if ( !hitSomething )
 	{
-		m_chunkOfSelectedBlock = nullptr;
+		ClearSelectedBlock();
 		return;
 	}
 
 	BlockInfo selectedBlock = hitResult.lastBlockHit;
-	m_chunkOfSelectedBlock = selectedBlock.m_myChunk;
 
 	//Direction opposite selected face AKA surface normal.
 	Vector3 directionOppositeSelectedFace = FindDirectionBetweenBlocks( hitResult.penultimateBlockHit, selectedBlock );
 	if ( directionOppositeSelectedFace == Vector3::ZERO )
 	{
-		m_chunkOfSelectedBlock = nullptr;
+		ClearSelectedBlock();
 		return; //There was either an error or we're in the block we hit.
 	}
 
-
-	hitResult.lastBlockHit.m_myChunk->HighlightBlock( selectedBlock.m_myBlockIndex, directionOppositeSelectedFace );
+	m_selectedBlock = selectedBlock;
+	m_selectedFace = GetBlockFaceFromDirectionOppositeFace( directionOppositeSelectedFace );
 
 	if ( m_blockBeingDug->m_myChunk != nullptr ) //Stop digging if we moved to another block.
 	{
@@ -1250,6 +1262,7 @@ void World::SelectBlock( const WorldCoords& selectorsPos, const WorldCoords& end
 			PlayBreakingSound( selectedBlock.GetBlock()->GetBlockType() );
 			hitResult.lastBlockHit.m_myChunk->BreakBlock( selectedBlock.m_myBlockIndex );
 			UpdateLightingForBlockBroken( selectedBlock );
+			ScheduleBlockTicksAroundBlock( selectedBlock );
 		}
 		else //Progressive dig damage.
 		{
@@ -1281,6 +1294,17 @@ void World::SelectBlock( const WorldCoords& selectorsPos, const WorldCoords& end
 			typeToPlace,
 			&blockPlacedInto );
 		UpdateLightingForBlockPlaced( blockPlacedInto );
+		if ( blockPlacedInto.m_myChunk != nullptr )
+			ScheduleBlockTicksAroundBlock( blockPlacedInto );
+	}
+
+	if ( g_theInput->WasKeyPressedOnce( KEY_TO_DETONATE_AT_SELECTION ) )
+	{
+		WorldEdit detonation( m_activeDimension );
+		detonation.FillSphere( GetGlobalBlockCoordsFromChunkAndLocalBlockIndex( selectedBlock.m_myChunk, selectedBlock.m_myBlockIndex ), DETONATION_RADIUS_IN_BLOCKS, AIR );
+		PlayBreakingSound( selectedBlock.GetBlock()->GetBlockType() );
+		CommitWorldEdit( detonation );
+		ClearSelectedBlock(); //Likely just blown away.
 	}
 }
 
@@ -1337,11 +1361,14 @@ bool World::RaycastWithStepAndSample( const WorldCoords& selectorsPos, const Wor
 //--------------------------------------------------------------------------------------------------------------
 bool World::RaycastWithAmanatidesWoo( const WorldCoords& selectorsPos, const WorldCoords& endOfSelectionRay, RaycastResult3D& out_result )
 {
-	//Regan-casting
-	BlockInfo originBlockInfo = GetBlockInfoFromWorldCoords( selectorsPos );
-	if ( originBlockInfo.m_myChunk == nullptr ) 
-		return false;
+	return RaycastWithAmanatidesWoo( m_blockQuery, selectorsPos, endOfSelectionRay, out_result );
+}
+
 
+//--------------------------------------------------------------------------------------------------------------
+//Only reads the world through blockQuery, so worker threads can each cast with their own.
+bool World::RaycastWithAmanatidesWoo( WorldBlockQuery& blockQuery, const WorldCoords& selectorsPos, const WorldCoords& endOfSelectionRay, RaycastResult3D& out_result ) const
+{
 	//Initialization of Regan-cast
 	GlobalBlockCoords blockPos = GlobalBlockCoords(
 		(int)floor( selectorsPos.x ),
@@ -1349,9 +1376,14 @@ bool World::RaycastWithAmanatidesWoo( const WorldCoords& selectorsPos, const Wor
 		(int)floor( selectorsPos.z )
 		); //Makes block coords mins-based.
 
+	BlockTraversal traversal( blockQuery, m_activeDimension, blockPos );
+	BlockInfo originBlockInfo = traversal.GetBlockInfo();
+	if ( originBlockInfo.m_myChunk == nullptr ) 
+		return false;
+
 	if ( originBlockInfo.m_myChunk->IsBlockSolid( originBlockInfo.m_myBlockIndex ) ) //Is ray's block origin solid?
 	{
-		out_result.penultimateBlockHit = out_result.lastBlockHit = GetBlockInfoFromGlobalBlockCoords( blockPos );
+		out_result.penultimateBlockHit = out_result.lastBlockHit = originBlockInfo;
 		out_result.impactFraction = 0.f;
 		out_result.impactPosition = selectorsPos;
 		return true;
@@ -1397,8 +1429,8 @@ bool World::RaycastWithAmanatidesWoo( const WorldCoords& selectorsPos, const Wor
 			if ( tOfNextCrossingOnX > 1 ) 
 				return false; //No impact, i.e. next crossing past endpoint.
 		
-			blockPos.x += tileStepX; //move into next tile on x
-			currentBlockInfo = GetBlockInfoFromGlobalBlockCoords( blockPos );
+			traversal.StepX( tileStepX ); //move into next tile on x
+			currentBlockInfo = traversal.GetBlockInfo();
 			if ( currentBlockInfo.m_myChunk == nullptr ) 
 				return false;
 
@@ -1422,8 +1454,8 @@ bool World::RaycastWithAmanatidesWoo( const WorldCoords& selectorsPos, const Wor
 			if ( tOfNextCrossingOnY > 1 ) 
 				return false; //No impact, i.e. next crossing past endpoint.
 
-			blockPos.y += tileStepY; //move into next tile on y
-			currentBlockInfo = GetBlockInfoFromGlobalBlockCoords( blockPos );
+			traversal.StepY( tileStepY ); //move into next tile on y
+			currentBlockInfo = traversal.GetBlockInfo();
 			if ( currentBlockInfo.m_myChunk == nullptr ) 
 				return false;
 
@@ -1447,8 +1479,8 @@ bool World::RaycastWithAmanatidesWoo( const WorldCoords& selectorsPos, const Wor
 			if ( tOfNextCrossingOnZ > 1 ) 
 				return false; //No impact, i.e. next crossing past endpoint.
 
-			blockPos.z += tileStepZ; //move into next tile on z
-			currentBlockInfo = GetBlockInfoFromGlobalBlockCoords( blockPos );
+			traversal.StepZ( tileStepZ ); //move into next tile on z
+			currentBlockInfo = traversal.GetBlockInfo();
 			if ( currentBlockInfo.m_myChunk == nullptr ) 
 				return false;
 
@@ -1473,6 +1505,60 @@ bool World::RaycastWithAmanatidesWoo( const WorldCoords& selectorsPos, const Wor
 }
 
 
+//--------------------------------------------------------------------------------------------------------------
+void World::RaycastBatch( const std::vector< RaycastRequest3D >& rays, std::vector< RaycastResult3D >& out_results, bool useWorkerThreads )
+{
+	PROFILE_SCOPE( "World::RaycastBatch" );
+
+	out_results.assign( rays.size(), RaycastResult3D() );
+
+	//Grouping by starting chunk keeps consecutive rays walking the same blocks and each query's last-chunk cache warm.
+	m_raycastBatchOrder.resize( rays.size() );
+	for ( unsigned int rayIndex = 0; rayIndex < rays.size(); rayIndex++ )
+	{
+		const WorldCoords& rayStart = rays[ rayIndex ].m_start;
+		m_raycastBatchOrder[ rayIndex ] = std::make_pair( GetChunkCoordsFromWorldCoordsXY( WorldCoordsXY( rayStart.x, rayStart.y ) ), rayIndex );
+	}
+	std::sort( m_raycastBatchOrder.begin(), m_raycastBatchOrder.end() );
+
+	unsigned int numRays = rays.size();
+	unsigned int numWorkers = useWorkerThreads ? GetMax( 1u, std::thread::hardware_concurrency() ) : 1;
+	numWorkers = GetMin( numWorkers, GetMax( 1u, numRays / RAYCAST_BATCH_MIN_RAYS_PER_WORKER ) ); //Small batches aren't worth a thread's startup.
+	if ( numWorkers == 1 )
+	{
+		RaycastBatchSlice( 0, numRays, rays, out_results );
+		return;
+	}
+
+	//Contiguous slices of the sorted order, so each worker's rays stay grouped by chunk too.
+	std::vector< std::future< void > > workers;
+	unsigned int raysPerWorker = ( numRays + numWorkers - 1 ) / numWorkers;
+	for ( unsigned int firstSortedRay = raysPerWorker; firstSortedRay < numRays; firstSortedRay += raysPerWorker )
+	{
+		unsigned int endSortedRay = GetMin( firstSortedRay + raysPerWorker, numRays );
+		workers.push_back( std::async( std::launch::async, &World::RaycastBatchSlice, this, firstSortedRay, endSortedRay, std::cref( rays ), std::ref( out_results ) ) );
+	}
+	RaycastBatchSlice( 0, GetMin( raysPerWorker, numRays ), rays, out_results ); //Main thread takes the first slice rather than idling.
+
+	for ( std::future< void >& worker : workers )
+		worker.wait();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::RaycastBatchSlice( unsigned int firstSortedRay, unsigned int endSortedRay, const std::vector< RaycastRequest3D >& rays, std::vector< RaycastResult3D >& out_results ) const
+{
+	PROFILE_SCOPE( "World::RaycastBatchSlice" );
+
+	WorldBlockQuery blockQuery( m_activeChunks ); //Own cache per slice, as m_blockQuery isn't safe to share across threads.
+	for ( unsigned int sortedRayIndex = firstSortedRay; sortedRayIndex < endSortedRay; sortedRayIndex++ )
+	{
+		unsigned int rayIndex = m_raycastBatchOrder[ sortedRayIndex ].second;
+		RaycastWithAmanatidesWoo( blockQuery, rays[ rayIndex ].m_start, rays[ rayIndex ].m_end, out_results[ rayIndex ] );
+	}
+}
+
+
 //--------------------------------------------------------------------------------------------------------------
 Vector3 World::FindDirectionBetweenBlocks( BlockInfo lastBlockHit, BlockInfo hitBlockInfo )
 {
@@ -1532,52 +1618,19 @@ Vector3 World::FindDirectionBetweenBlocks( BlockInfo lastBlockHit, BlockInfo hit
 }
 
 
-//--------------------------------------------------------------------------------------------------------------
-void World::UnhighlightSelectedBlock()
-{
-	const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
-	for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
-	{
-		Chunk* currentChunk = activeChunkPair.second;
-		if ( currentChunk->IsHighlighting() )
-			currentChunk->Unhighlight();
-	}
-}
-
-
 //--------------------------------------------------------------------------------------------------------------
 BlockInfo World::GetBlockInfoFromWorldCoords( const WorldCoords& wc )
 {
-	WorldCoordsXY wc2D = WorldCoordsXY( wc.x, wc.y );
-	ChunkCoords chunkCoordsOfCurrentPos = GetChunkCoordsFromWorldCoordsXY( wc2D );
-
-
-	const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
-	if ( activeChunksInActiveDimension.count( chunkCoordsOfCurrentPos ) == 0 ) 
-		return BlockInfo(); //WorldCoords outside loaded chunks.
+	GlobalBlockCoords blockPos = GlobalBlockCoords( (int)floor( wc.x ), (int)floor( wc.y ), (int)floor( wc.z ) ); //Floor because blocks are mins-based.
 
-	Chunk* currentChunk = activeChunksInActiveDimension.at( chunkCoordsOfCurrentPos );
-	WorldCoordsXY currentChunkCoordsInWorldUnits = currentChunk->GetChunkMinsInWorldUnits(); //e.g. (1,0) becomes (16.f,0.f).
-
-	LocalBlockCoords lbc;
-	lbc.x = (int)( wc.x - currentChunkCoordsInWorldUnits.x );
-	lbc.y = (int)( wc.y - currentChunkCoordsInWorldUnits.y );
-	lbc.z = (int)wc.z;
-	
-	return BlockInfo( currentChunk, GetLocalBlockIndexFromLocalBlockCoords( lbc ) );
+	return m_blockQuery.GetBlockInfo( m_activeDimension, blockPos );
 }
 
 
 //--------------------------------------------------------------------------------------------------------------
 BlockInfo World::GetBlockInfoFromGlobalBlockCoords( const GlobalBlockCoords& blockPos )
 {
-	WorldCoords wc;
-
-	wc.x = (float)blockPos.x;
-	wc.y = (float)blockPos.y;
-	wc.z = (float)blockPos.z;
-
-	return GetBlockInfoFromWorldCoords( wc );
+	return m_blockQuery.GetBlockInfo( m_activeDimension, blockPos );
 }
 
 
@@ -1596,81 +1649,16 @@ GlobalBlockCoords World::GetGlobalBlockCoordsFromBlockInfo( const BlockInfo& blo
 }
 
 
-//--------------------------------------------------------------------------------------------------------------
-void World::InitializeLightingForChunk( Chunk* newChunk )
-{
-	//Pass 1: mark sky blocks.
-	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
-	{
-		for ( int blockHeight = CHUNK_Z_HEIGHT_IN_BLOCKS-1; blockHeight >= 0; blockHeight-- )
-		{
-			LocalColumnCoords lcc = newChunk->GetLocalColumnCoordsFromChunkColumnIndex( columnIndex );
-			LocalBlockCoords lbc = IntVector3( lcc.x, lcc.y, blockHeight );
-
-			Block* currentBlock = newChunk->GetBlockFromLocalBlockCoords( lbc );
-			if ( currentBlock == nullptr ) 
-				return;
-
-			if ( currentBlock->IsOpaque( ) ) 
-				break; //Stop descent, no more sky blocks, nor is this one.
-
-			currentBlock->SetBlockToBeSky( );
-			currentBlock->SetLightLevel( MAX_LIGHTING_LEVEL );
-			if ( g_renderSkyBlocksAsDebugPoints && ( blockHeight < ( SEA_LEVEL_HEIGHT_LIMIT + 4 ) ) ) //Adjust height as desired for debug tests.
-			{
-				AddDebugPoint
-				(
-					newChunk->GetWorldCoordsFromLocalBlockIndex( GetLocalBlockIndexFromLocalBlockCoords( lbc ) ) + Vector3( .5f, .5f, .5f ),
-					Rgba( 1.f, 0.f, 0.f )
-				);
-			}
-		}
-	}
-
-	//Pass 2: start letting light bleed into non-sky XY-neighbors via dirty flag.
-	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
-	{
-		for ( int blockHeight = CHUNK_Z_HEIGHT_IN_BLOCKS - 1; blockHeight >= 0; blockHeight-- )
-		{
-			LocalColumnCoords lcc = newChunk->GetLocalColumnCoordsFromChunkColumnIndex( columnIndex );
-			LocalBlockCoords lbc = IntVector3( lcc.x, lcc.y, blockHeight );
-			LocalBlockIndex lbi = GetLocalBlockIndexFromLocalBlockCoords( lbc );
-
-			Block* currentBlock = newChunk->GetBlockFromLocalBlockIndex( lbi );
-			if ( currentBlock == nullptr ) 
-				return;
-
-			if ( currentBlock->IsOpaque() ) 
-				break; //Stop descent, no more sky blocks, nor is this one.
-
-			BlockInfo currentBlockInfo = BlockInfo( newChunk, lbi );
-			DirtyNonSkyNeighborsForBlock( currentBlockInfo, false );
-		}
-	}
-
-	//Pass 3: handle blocks that are non-sky light sources.
-	for ( int blockIndex = 0; blockIndex < NUM_BLOCKS_PER_CHUNK; blockIndex++ )
-	{
-		Block* currentBlock = newChunk->GetBlockFromLocalBlockIndex( blockIndex );
-		if ( currentBlock == nullptr ) 
-			continue;
-
-		int lightLevelForBlockType = BlockDefinition::GetLightLevel( currentBlock->GetBlockType() );
-		bool isLightSource = ( lightLevelForBlockType > 0 );
-
-		if ( !currentBlock->IsSky() && isLightSource )
-			MarkBlockLightingDirty( BlockInfo( newChunk, blockIndex ) );
-	}
-}
-
-
 //--------------------------------------------------------------------------------------------------------------
 void World::UpdateLighting()
 {
+	PROFILE_SCOPE( "World::UpdateLighting" );
+
 	while ( !m_dirtyBlocks.empty() )
 	{
 		BlockInfo bi = m_dirtyBlocks.front();
 		m_dirtyBlocks.pop_front();
+		++g_lightingNodesProcessed;
 		
 		Block* currentBlock = bi.GetBlock();
 		if ( currentBlock == nullptr ) 
@@ -1747,31 +1735,13 @@ int World::GetIdealLightForBlock( BlockInfo& bi )
 	int skyFactor = block->IsSky() ? bi.m_myChunk->GetCurrentSkyLightLevel() : 0;
 	int highestNeighborLight = 0; //Taking the max of our neighbors' light levels.
 
-	BlockInfo neighbor;
-
-	neighbor = bi;
-	neighbor.StepEast();
-	highestNeighborLight = GetMax( highestNeighborLight, neighbor.GetBlock( )->GetLightLevel( ) );
-
-	neighbor = bi;
-	neighbor.StepWest();
-	highestNeighborLight = GetMax( highestNeighborLight, neighbor.GetBlock( )->GetLightLevel( ) );
-
-	neighbor = bi;
-	neighbor.StepNorth();
-	highestNeighborLight = GetMax( highestNeighborLight, neighbor.GetBlock( )->GetLightLevel( ) );
-
-	neighbor = bi;
-	neighbor.StepSouth();
-	highestNeighborLight = GetMax( highestNeighborLight, neighbor.GetBlock( )->GetLightLevel( ) );
-
-	neighbor = bi;
-	neighbor.StepUp();
-	highestNeighborLight = GetMax( highestNeighborLight, neighbor.GetBlock( )->GetLightLevel( ) );
-
-	neighbor = bi;
-	neighbor.StepDown();
-	highestNeighborLight = GetMax( highestNeighborLight, neighbor.GetBlock( )->GetLightLevel( ) );
+	BlockInfo neighbors[ NUM_FACES ];
+	unsigned char existingNeighborsMask = bi.GetNeighbors( neighbors );
+	for ( int face = 0; face < NUM_FACES; face++ )
+	{
+		if ( ( existingNeighborsMask & BIT( face ) ) != 0 ) //Else past the world's edge, which used to count this block's own stale light.
+			highestNeighborLight = GetMax( highestNeighborLight, neighbors[ face ].GetBlock()->GetLightLevel() );
+	}
 
 	return GetMax( highestNeighborLight - 1, GetMax( skyFactor, currentBlockLight ) );
 }
@@ -1780,7 +1750,7 @@ int World::GetIdealLightForBlock( BlockInfo& bi )
 //--------------------------------------------------------------------------------------------------------------
 void World::UpdateChunks()
 {
-	int chunkLightLevel = ( g_useNightLightLevel ? NIGHT_LIGHTING_LEVEL : MAX_LIGHTING_LEVEL ); //Currently just a constant.
+	int chunkLightLevel = GetSkyLightLevel();
 	
 	const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
 	for ( const std::pair< ChunkCoords, Chunk* >& activeChunkPair : activeChunksInActiveDimension )
@@ -1791,7 +1761,425 @@ void World::UpdateChunks()
 			currentChunk->SetCurrentSkyLightLevel( chunkLightLevel );
 			MarkChunkLightingDirty( currentChunk );
 		}
+
+		UpdateRandomBlockTicks( currentChunk );
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::UpdateRandomBlockTicks( Chunk* chunk )
+{
+	//A fixed number of samples per section rather than a scan, so the cost follows loaded sections, not blocks.
+	//Hashed from chunk, section, sample and tick instead of rand(), so a given seed replays the same ambient changes.
+	ChunkCoords chunkCoords = chunk->GetChunkCoords();
+	unsigned int randomTickSeed = g_worldSeed + (unsigned int)chunk->GetDimension();
+	for ( int sectionIndex = 0; sectionIndex < NUM_SECTIONS_PER_CHUNK; sectionIndex++ )
+	{
+		if ( chunk->IsSectionAllAir( sectionIndex ) )
+			continue;
+
+		for ( int sampleIndex = 0; sampleIndex < RANDOM_TICKS_PER_SECTION_PER_TICK; sampleIndex++ )
+		{
+			unsigned int randomBits = Get4dNoiseUint( chunkCoords.x, chunkCoords.y, ( sectionIndex * RANDOM_TICKS_PER_SECTION_PER_TICK ) + sampleIndex, (int)m_currentTick, randomTickSeed );
+			LocalBlockIndex sampledBlockIndex = ( sectionIndex * NUM_BLOCKS_PER_SECTION ) + ( randomBits & ( NUM_BLOCKS_PER_SECTION - 1 ) );
+			RunRandomBlockTick( BlockInfo( chunk, sampledBlockIndex ), randomBits >> BITS_PER_SECTION ); //Leftover bits are the rule's to use.
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::RunRandomBlockTick( const BlockInfo& bi, unsigned int randomBits )
+{
+	BlockType blockType = bi.GetBlock()->GetBlockType();
+	if ( ( blockType != GRASS ) && ( blockType != MYCELIUM ) )
+		return; //Nearly every sample, so this is kept to one compare.
+
+	BlockInfo blockAbove = bi;
+	if ( blockAbove.StepUp() && blockAbove.GetBlock()->IsOpaque() )
+	{
+		if ( blockType == GRASS )
+			SetBlockFromBlockTick( bi, DIRT ); //Smothered.
+		return;
+	}
+
+	//Grass spreads to lit dirt and mycelium to netherrack, either up to a block above or below in the 3x3 around.
+	BlockType spreadsOnto = ( blockType == GRASS ) ? DIRT : NETHERRACK;
+	int offsetX = (int)( randomBits % 3 ) - 1;
+	int offsetY = (int)( ( randomBits / 3 ) % 3 ) - 1;
+	int offsetZ = (int)( ( randomBits / 9 ) % 3 ) - 1;
+
+	BlockInfo target = bi;
+	if ( ( offsetX != 0 ) && !( ( offsetX > 0 ) ? target.StepEast() : target.StepWest() ) )
+		return;
+	if ( ( offsetY != 0 ) && !( ( offsetY > 0 ) ? target.StepNorth() : target.StepSouth() ) )
+		return;
+	if ( ( offsetZ != 0 ) && !( ( offsetZ > 0 ) ? target.StepUp() : target.StepDown() ) )
+		return;
+	if ( target.GetBlock()->GetBlockType() != spreadsOnto )
+		return;
+
+	BlockInfo targetAbove = target;
+	if ( !targetAbove.StepUp() || targetAbove.GetBlock()->IsOpaque() )
+		return;
+	if ( ( blockType == GRASS ) && ( targetAbove.GetBlock()->GetLightLevel() < GRASS_SPREAD_MIN_LIGHT_LEVEL ) )
+		return;
+
+	SetBlockFromBlockTick( target, blockType );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::PlaceLandedFallingBlocks()
+{
+	for ( const LandedFallingBlock& landedBlock : m_landedFallingBlocks )
+	{
+		BlockInfo landedInto = m_blockQuery.GetBlockInfo( landedBlock.m_dimension, landedBlock.m_blockCoords );
+		BlockType landedIntoType = ( landedInto.m_myChunk != nullptr ) ? landedInto.GetBlock()->GetBlockType() : AIR;
+		if ( ( landedInto.m_myChunk != nullptr ) && ( ( landedIntoType == AIR ) || BlockDefinition::IsFluid( landedIntoType ) ) ) //Sand settles through water and displaces it.
+		{
+			BlockInfo blockPlacedInto;
+			landedInto.m_myChunk->PlaceBlock( landedInto.m_myBlockIndex, Vector3::ZERO, landedBlock.m_blockType, &blockPlacedInto );
+			UpdateLightingForBlockPlaced( blockPlacedInto );
+			ScheduleBlockTicksAroundBlock( blockPlacedInto );
+			continue;
+		}
+
+		//Landed somewhere already filled, e.g. a ladder or a block placed under it mid-fall, so it pops out as an item instead.
+		WorldCoords blockCenter = WorldCoords( (float)landedBlock.m_blockCoords.x + .5f, (float)landedBlock.m_blockCoords.y + .5f, (float)landedBlock.m_blockCoords.z + 1.5f );
+		m_entities.SpawnEntity( ENTITY_DROPPED_ITEM, landedBlock.m_dimension, blockCenter, Vector3::ZERO, landedBlock.m_blockType );
+	}
+
+	m_landedFallingBlocks.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+typedef bool ( BlockInfo::*BlockInfoStep )();
+static const BlockInfoStep STEPS_TO_HORIZONTAL_NEIGHBORS[ 4 ] = { &BlockInfo::StepNorth, &BlockInfo::StepSouth, &BlockInfo::StepEast, &BlockInfo::StepWest };
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::UpdateScheduledBlockTicks()
+{
+	PROFILE_SCOPE( "World::UpdateScheduledBlockTicks" );
+
+	const std::map< ChunkCoords, Chunk* >& activeChunksInActiveDimension = m_activeChunks[ m_activeDimension ];
+	if ( activeChunksInActiveDimension.empty() )
+		return;
+
+	//Resumes at the chunk the last tick's budget ran out in, so one big flood can't starve every chunk after it.
+	std::map< ChunkCoords, Chunk* >::const_iterator chunkIter = activeChunksInActiveDimension.lower_bound( m_blockTickResumeChunkCoords );
+	unsigned int numBlockTicksRun = 0;
+	for ( unsigned int numChunksVisited = 0; numChunksVisited < activeChunksInActiveDimension.size(); numChunksVisited++, ++chunkIter )
+	{
+		if ( chunkIter == activeChunksInActiveDimension.end() )
+			chunkIter = activeChunksInActiveDimension.begin();
+
+		Chunk* currentChunk = chunkIter->second;
+		LocalBlockIndex dueBlockIndex;
+		while ( ( numBlockTicksRun < BLOCK_TICKS_BUDGET_PER_TICK ) && currentChunk->m_scheduledBlockTicks.PopDueTick( m_currentTick, dueBlockIndex ) )
+		{
+			BlockInfo dueBlock( currentChunk, dueBlockIndex );
+			BlockType dueBlockType = dueBlock.GetBlock()->GetBlockType(); //May have changed since it was scheduled, so re-checked here.
+			if ( BlockDefinition::IsFluid( dueBlockType ) )
+				RunFluidBlockTick( dueBlock );
+			else if ( BlockDefinition::FallsWhenUnsupported( dueBlockType ) )
+				RunFallingBlockTick( dueBlock );
+
+			++numBlockTicksRun;
+		}
+
+		if ( numBlockTicksRun == BLOCK_TICKS_BUDGET_PER_TICK )
+		{
+			m_blockTickResumeChunkCoords = chunkIter->first; //Whatever's left is overdue and runs first next tick.
+			break;
+		}
+	}
+
+	FlushBlockTickChanges();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::RunFluidBlockTick( const BlockInfo& fluidBlock )
+{
+	BlockType fluidType = fluidBlock.GetBlock()->GetBlockType();
+	int fluidLevel = fluidBlock.m_myChunk->GetFluidLevel( fluidBlock.m_myBlockIndex );
+	int maxFluidLevel = BlockDefinition::GetMaxFluidLevel( fluidType );
+
+	//Flowing fluid only lasts while something still feeds it: the same fluid from above, or a shallower level beside it.
+	if ( fluidLevel > 0 )
+	{
+		int fedFluidLevel = maxFluidLevel + 1;
+
+		BlockInfo blockAbove = fluidBlock;
+		if ( blockAbove.StepUp() && ( blockAbove.GetBlock()->GetBlockType() == fluidType ) )
+			fedFluidLevel = 1;
+
+		for ( BlockInfoStep stepToNeighbor : STEPS_TO_HORIZONTAL_NEIGHBORS )
+		{
+			BlockInfo neighbor = fluidBlock;
+			if ( ( neighbor.*stepToNeighbor )() && ( neighbor.GetBlock()->GetBlockType() == fluidType ) )
+				fedFluidLevel = GetMin( fedFluidLevel, neighbor.m_myChunk->GetFluidLevel( neighbor.m_myBlockIndex ) + 1 );
+		}
+
+		if ( fedFluidLevel > maxFluidLevel )
+		{
+			SetBlockFromBlockTick( fluidBlock, AIR ); //Dries up, and its neighbors recheck their own feeds in turn.
+			return;
+		}
+
+		if ( fedFluidLevel != fluidLevel )
+		{
+			SetBlockFromBlockTick( fluidBlock, fluidType, fedFluidLevel ); //Spreads on the tick this reschedules.
+			return;
+		}
+	}
+
+	BlockInfo blockBelow = fluidBlock;
+	if ( !blockBelow.StepDown() )
+		return;
+
+	BlockType blockTypeBelow = blockBelow.GetBlock()->GetBlockType();
+	if ( blockTypeBelow == AIR )
+	{
+		SetBlockFromBlockTick( blockBelow, fluidType, 1 ); //Falls first, only spreading sideways once it lands.
+		return;
+	}
+
+	if ( BlockDefinition::IsFluid( blockTypeBelow ) )
+		return; //Pooled on top of fluid, e.g. a waterfall into a lake.
+
+	int spreadFluidLevel = fluidLevel + 1;
+	if ( spreadFluidLevel > maxFluidLevel )
+		return;
+
+	for ( BlockInfoStep stepToNeighbor : STEPS_TO_HORIZONTAL_NEIGHBORS )
+	{
+		BlockInfo neighbor = fluidBlock;
+		if ( !( neighbor.*stepToNeighbor )() )
+			continue; //Unloaded, it'll flow there if poked again once the chunk's in.
+
+		BlockType neighborType = neighbor.GetBlock()->GetBlockType();
+		if ( neighborType == AIR )
+			SetBlockFromBlockTick( neighbor, fluidType, spreadFluidLevel );
+		else if ( ( neighborType == fluidType ) && ( neighbor.m_myChunk->GetFluidLevel( neighbor.m_myBlockIndex ) > spreadFluidLevel ) )
+			SetBlockFromBlockTick( neighbor, fluidType, spreadFluidLevel );
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::RunFallingBlockTick( const BlockInfo& fallingBlock )
+{
+	BlockInfo blockBelow = fallingBlock;
+	if ( !blockBelow.StepDown() )
+		return;
+
+	BlockType blockTypeBelow = blockBelow.GetBlock()->GetBlockType();
+	if ( ( blockTypeBelow != AIR ) && !BlockDefinition::IsFluid( blockTypeBelow ) )
+		return; //Still supported.
+
+	//Handed to the entity system to fall, which gives it back to PlaceLandedFallingBlocks once it lands.
+	BlockType fallingBlockType = fallingBlock.GetBlock()->GetBlockType();
+	WorldCoords blockCenter = fallingBlock.m_myChunk->GetWorldCoordsFromLocalBlockIndex( fallingBlock.m_myBlockIndex ) + Vector3( .5f, .5f, .5f );
+	SetBlockFromBlockTick( fallingBlock, AIR );
+	m_entities.SpawnEntity( ENTITY_FALLING_BLOCK, fallingBlock.m_myChunk->GetDimension(), blockCenter, Vector3::ZERO, fallingBlockType );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::SetBlockFromBlockTick( const BlockInfo& bi, BlockType newType, int fluidLevel /*= 0*/ )
+{
+	Chunk* chunk = bi.m_myChunk;
+	if ( bi.GetBlock()->GetBlockType() != newType ) //A level change alone changes nothing drawn or lit.
+	{
+		if ( newType == AIR )
+			chunk->BreakBlock( bi.m_myBlockIndex );
+		else
+			chunk->PlaceBlock( bi.m_myBlockIndex, Vector3::ZERO, newType );
+
+		m_blockTickChangedBlocks.push_back( bi );
+	}
+
+	chunk->SetFluidLevel( bi.m_myBlockIndex, fluidLevel );
+	ScheduleBlockTicksAroundBlock( bi );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::ScheduleBlockTick( const BlockInfo& bi )
+{
+	unsigned int tickDelay = BlockDefinition::GetBlockTickDelay( bi.GetBlock()->GetBlockType() );
+	if ( tickDelay > 0 )
+		bi.m_myChunk->m_scheduledBlockTicks.Schedule( bi.m_myBlockIndex, m_currentTick + tickDelay );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::ScheduleBlockTicksAroundBlock( const BlockInfo& changedBlock )
+{
+	ScheduleBlockTick( changedBlock );
+
+	BlockInfo neighbor = changedBlock;
+	if ( neighbor.StepUp() )
+		ScheduleBlockTick( neighbor );
+
+	neighbor = changedBlock;
+	if ( neighbor.StepDown() )
+		ScheduleBlockTick( neighbor );
+
+	for ( BlockInfoStep stepToNeighbor : STEPS_TO_HORIZONTAL_NEIGHBORS )
+	{
+		neighbor = changedBlock;
+		if ( ( neighbor.*stepToNeighbor )() )
+			ScheduleBlockTick( neighbor );
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void World::FlushBlockTickChanges()
+{
+	//Relit once per changed block after all of this tick's updates, rather than between updates that may undo each other.
+	//Meshes are batched already: changes only flag their chunk, and UpdateDirtyVertexArrays rebuilds each flagged chunk once.
+	for ( const BlockInfo& changedBlock : m_blockTickChangedBlocks )
+	{
+		BlockType newType = changedBlock.GetBlock()->GetBlockType();
+		if ( newType == AIR )
+			UpdateLightingForBlockBroken( changedBlock );
+		else if ( BlockDefinition::IsOpaque( newType ) )
+			UpdateLightingForBlockPlaced( changedBlock );
+		else //Fluids only ever flow into air, and sky passes through them as at generation, so the column keeps its sky flags.
+			MarkBlockLightingDirty( changedBlock );
+	}
+
+	m_blockTickChangedBlocks.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+unsigned int World::CommitWorldEdit( const WorldEdit& edit )
+{
+	PROFILE_SCOPE( "World::CommitWorldEdit" );
+
+	//Grouped by chunk, and by index within a chunk, so a later write to the same block still lands last.
+	const std::vector< WorldEditWrite >& writes = edit.GetWrites();
+	m_worldEditOrder.clear();
+	for ( unsigned int writeIndex = 0; writeIndex < writes.size(); writeIndex++ )
+		m_worldEditOrder.push_back( std::make_pair( WorldBlockQuery::GetChunkCoordsFromGlobalBlockCoords( writes[ writeIndex ].m_position ), writeIndex ) );
+	std::sort( m_worldEditOrder.begin(), m_worldEditOrder.end() );
+
+	unsigned int numBlocksChanged = 0;
+	for ( unsigned int firstSortedWrite = 0; firstSortedWrite < m_worldEditOrder.size(); )
+	{
+		ChunkCoords chunkCoords = m_worldEditOrder[ firstSortedWrite ].first;
+		unsigned int endSortedWrite = firstSortedWrite + 1;
+		while ( ( endSortedWrite < m_worldEditOrder.size() ) && ( m_worldEditOrder[ endSortedWrite ].first == chunkCoords ) )
+			++endSortedWrite;
+
+		Chunk* chunk = m_blockQuery.GetChunk( edit.GetDimension(), chunkCoords );
+		if ( chunk != nullptr )
+			numBlocksChanged += ApplyWorldEditToChunk( chunk, writes, firstSortedWrite, endSortedWrite );
+
+		firstSortedWrite = endSortedWrite;
+	}
+
+	return numBlocksChanged;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+unsigned int World::ApplyWorldEditToChunk( Chunk* chunk, const std::vector< WorldEditWrite >& writes, unsigned int firstSortedWrite, unsigned int endSortedWrite )
+{
+	//Blocks are written bare, with none of PlaceBlock's per-block dirtying or column walks; all of that follows once for the chunk.
+	WorldCoordsXY chunkMins = chunk->GetChunkMinsInWorldUnits();
+	int lowestChangeInColumn[ NUM_COLUMNS_PER_CHUNK ];
+	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
+		lowestChangeInColumn[ columnIndex ] = CHUNK_Z_HEIGHT_IN_BLOCKS; //Untouched.
+
+	unsigned char changedSectionMask = 0;
+	bool changedBorder[ 4 ] = { false, false, false, false }; //-x, +x, -y, +y.
+	m_worldEditChangedBlocks.clear();
+
+	for ( unsigned int sortedWrite = firstSortedWrite; sortedWrite < endSortedWrite; sortedWrite++ )
+	{
+		const WorldEditWrite& write = writes[ m_worldEditOrder[ sortedWrite ].second ];
+		LocalBlockCoords lbc = LocalBlockCoords( write.m_position.x - (int)chunkMins.x, write.m_position.y - (int)chunkMins.y, write.m_position.z );
+		LocalBlockIndex lbi = GetLocalBlockIndexFromLocalBlockCoords( lbc );
+
+		Block* block = chunk->GetBlockFromLocalBlockIndex( lbi );
+		BlockType oldType = block->GetBlockType();
+		if ( ( oldType == write.m_newType ) || ( ( write.m_onlyReplaceType != NUM_BLOCK_TYPES ) && ( oldType != write.m_onlyReplaceType ) ) )
+			continue;
+
+		block->SetBlockType( write.m_newType );
+		chunk->SetFluidLevel( lbi, 0 );
+		m_worldEditChangedBlocks.push_back( lbi );
+
+		int columnIndex = lbi & ( NUM_COLUMNS_PER_CHUNK - 1 );
+		lowestChangeInColumn[ columnIndex ] = GetMin( lowestChangeInColumn[ columnIndex ], lbc.z );
+		changedSectionMask |= BIT( lbi >> BITS_PER_SECTION );
+		changedBorder[ 0 ] |= ( lbc.x == 0 );
+		changedBorder[ 1 ] |= ( lbc.x == CHUNK_X_LENGTH_IN_BLOCKS - 1 );
+		changedBorder[ 2 ] |= ( lbc.y == 0 );
+		changedBorder[ 3 ] |= ( lbc.y == CHUNK_Y_WIDTH_IN_BLOCKS - 1 );
+	}
+
+	if ( m_worldEditChangedBlocks.empty() )
+		return 0;
+
+	//One mesh rebuild for this chunk, plus any neighbor whose faces against an edited border may have changed.
+	chunk->MarkSectionsChanged( changedSectionMask );
+	if ( changedBorder[ 0 ] && ( chunk->m_southNeighbor != nullptr ) )
+		chunk->m_southNeighbor->MarkVertexArrayDirty();
+	if ( changedBorder[ 1 ] && ( chunk->m_northNeighbor != nullptr ) )
+		chunk->m_northNeighbor->MarkVertexArrayDirty();
+	if ( changedBorder[ 2 ] && ( chunk->m_eastNeighbor != nullptr ) )
+		chunk->m_eastNeighbor->MarkVertexArrayDirty();
+	if ( changedBorder[ 3 ] && ( chunk->m_westNeighbor != nullptr ) )
+		chunk->m_westNeighbor->MarkVertexArrayDirty();
+
+	//Sky is everything above a column's first opaque block, so each touched column is walked once from the top.
+	//Below its lowest change, the first block already agreeing it's under cover means the rest of the column agrees too.
+	for ( int columnIndex = 0; columnIndex < NUM_COLUMNS_PER_CHUNK; columnIndex++ )
+	{
+		if ( lowestChangeInColumn[ columnIndex ] == CHUNK_Z_HEIGHT_IN_BLOCKS )
+			continue;
+
+		bool isSky = true;
+		for ( int z = CHUNK_Z_HEIGHT_IN_BLOCKS - 1; z >= 0; z-- )
+		{
+			LocalBlockIndex lbi = columnIndex + ( z * NUM_COLUMNS_PER_CHUNK );
+			Block* block = chunk->GetBlockFromLocalBlockIndex( lbi );
+			if ( block->IsOpaque() )
+				isSky = false;
+
+			if ( block->IsSky() == isSky )
+			{
+				if ( !isSky && ( z < lowestChangeInColumn[ columnIndex ] ) )
+					break;
+				continue;
+			}
+
+			if ( isSky )
+				block->SetBlockToBeSky();
+			else
+				block->SetBlockToNotBeSky();
+			MarkBlockLightingDirty( BlockInfo( chunk, lbi ) );
+		}
 	}
+
+	for ( LocalBlockIndex changedBlockIndex : m_worldEditChangedBlocks )
+	{
+		BlockInfo changedBlock( chunk, changedBlockIndex );
+		MarkBlockLightingDirty( changedBlock );
+		ScheduleBlockTicksAroundBlock( changedBlock ); //e.g. sand left hanging over a crater, or water next to one.
+	}
+
+	return m_worldEditChangedBlocks.size();
 }
 
 
@@ -1872,6 +2260,32 @@ void World::MarkChunkLightingDirty( Chunk* chunk )
 }
 
 
+//--------------------------------------------------------------------------------------------------------------
+void World::MarkChunkBorderLightingDirty( Chunk* chunk, const ChunkCoords& borderDirection ) //e.g. (1,0) is the +x layer facing the north neighbor.
+{
+	int borderLength = ( borderDirection.x != 0 ) ? CHUNK_Y_WIDTH_IN_BLOCKS : CHUNK_X_LENGTH_IN_BLOCKS;
+
+	for ( int blockHeight = 0; blockHeight < CHUNK_Z_HEIGHT_IN_BLOCKS; blockHeight++ )
+	{
+		for ( int alongBorder = 0; alongBorder < borderLength; alongBorder++ )
+		{
+			LocalBlockCoords lbc = LocalBlockCoords( alongBorder, alongBorder, blockHeight );
+			if ( borderDirection.x != 0 )
+				lbc.x = ( borderDirection.x > 0 ) ? CHUNK_X_LENGTH_IN_BLOCKS - 1 : 0;
+			if ( borderDirection.y != 0 )
+				lbc.y = ( borderDirection.y > 0 ) ? CHUNK_Y_WIDTH_IN_BLOCKS - 1 : 0;
+
+			LocalBlockIndex lbi = GetLocalBlockIndexFromLocalBlockCoords( lbc );
+			Block* borderBlock = chunk->GetBlockFromLocalBlockIndex( lbi );
+			if ( borderBlock->IsOpaque() || borderBlock->IsSky() )
+				continue; //Neither can change from what a neighbor offers.
+
+			MarkBlockLightingDirty( BlockInfo( chunk, lbi ) );
+		}
+	}
+}
+
+
 //--------------------------------------------------------------------------------------------------------------
 bool World::IsBlockDugEnoughToBreak( BlockInfo block )
 {
@@ -3,10 +3,18 @@
 
 #include <map>
 #include <deque>
+#include <future>
 
 #include "Engine/Renderer/TheRenderer.hpp"
+#include "Engine/Math/Frustum.hpp"
 #include "Game/GameCommon.hpp"
 #include "Game/BlockInfo.hpp"
+#include "Game/LodTerrain.hpp"
+#include "Game/SectionConnectivity.hpp"
+#include "Game/StructureRegistry.hpp"
+#include "Game/WorldBlockQuery.hpp"
+#include "Game/EntitySystem.hpp"
+#include "Game/WorldEdit.hpp"
 
 //-----------------------------------------------------------------------------
 class Chunk;
@@ -24,6 +32,32 @@ struct RaycastResult3D
 };
 
 
+//-----------------------------------------------------------------------------
+struct RaycastRequest3D
+{
+	WorldCoords m_start;
+	WorldCoords m_end;
+};
+
+
+//-----------------------------------------------------------------------------
+struct ChunkLightingJob //Chunk isn't linked into m_activeChunks until its worker's local lighting pass is done.
+{
+	Chunk* m_chunk;
+	std::future< void > m_localLightingResult;
+};
+
+
+//-----------------------------------------------------------------------------
+struct SectionVisit //One step of the per-frame walk outward from the camera's section.
+{
+	Chunk* m_chunk;
+	int m_sectionIndex;
+	SectionFace m_entryFace;
+	unsigned char m_directionsTaken; //Bit per SectionFace already stepped through, so the walk never doubles back toward the camera.
+};
+
+
 //-----------------------------------------------------------------------------
 class World
 {
@@ -33,41 +67,59 @@ public:
 	~World();
 	void RenderChunk( const Chunk& chunk ) const;
 	bool IsChunkVisible( const Chunk& chunk ) const;
+	bool CollectChunksVisibleThroughSections( std::vector< Chunk* >& out_visibleChunks ) const; //False if the camera's chunk isn't active, to fall back to IsChunkVisible.
 	void Render() const;
+	void DrawQueuedChunks( bool preserveQueueOrder = false ) const;
+	void RenderTranslucentChunks( const std::vector< Chunk* >& chunksFrontToBack ) const;
+	static void SortChunksFrontToBack( const WorldCoords& cameraPosition, std::vector< Chunk* >& inout_chunks ); //Nearest first, so early-z rejects what's behind.
 	void Update( float deltaSeconds );
 	void SaveAndExitWorld();
 	void LoadPlayerFile( const std::string& filePath );
 	inline Dimension GetActiveDimension() const { return m_activeDimension; }
 	inline int GetActiveHudElement() const { return m_activeHudElement; }
 	inline void SetActiveHudElement( int newValue ) { m_activeHudElement = newValue; }
+	inline void SetViewFrustum( const Frustum& viewFrustum ) { m_viewFrustum = viewFrustum; }
+	inline EntitySystem& GetEntities() { return m_entities; }
+
+	//Tracked here rather than on the chunks, so clearing it never has to visit any of them. TheGame draws it as an overlay.
+	inline bool HasSelectedBlock() const { return m_selectedFace != NONE; }
+	inline const BlockInfo& GetSelectedBlock() const { return m_selectedBlock; }
+	inline BlockFace GetSelectedFace() const { return m_selectedFace; }
+	inline void ClearSelectedBlock() { m_selectedBlock = BlockInfo(); m_selectedFace = NONE; }
+
+	//For line-of-sight style workloads: out_results[i] answers rays[i]. Rays are cast grouped by starting chunk for cache locality,
+	//and large batches can be split across worker threads, which is safe as the world is left untouched until they all finish.
+	void RaycastBatch( const std::vector< RaycastRequest3D >& rays, std::vector< RaycastResult3D >& out_results, bool useWorkerThreads = false );
+
+	unsigned int CommitWorldEdit( const WorldEdit& edit ); //Returns how many blocks actually changed.
 
 	Dimension m_activeDimension;
 	std::map< ChunkCoords, Chunk* > m_activeChunks[ NUM_DIMENSIONS ];
-	Chunk* m_chunkOfSelectedBlock;
 	int m_currentDigDamageFrame;
 	BlockInfo* m_blockBeingDug;
 
 private:
 
-	void UpdateCameraAndPlayer( float deltaSeconds );
+	void Tick( float tickSeconds ); //Fixed-rate simulation, Update runs as many as the frame's time owes.
+	void InterpolateTransformsForRender( float fractionTowardThisTick );
+	void UpdateFromFrameInput();
+	void UpdatePlayer( float deltaSeconds );
+	void UpdateCameraAndSelection( float deltaSeconds );
 	void UpdateFromMovementKeys( float deltaSeconds, const Vector3& camForwardXY, const Vector3& camLeftXY, Vector3 &posToMove );
 	void UpdateMouseAndCameraOffset( Vector3& cameraPos, Vector3& playerPos, Vector3 camDirection );
+	static void PlaceCameraRelativeToPlayer( Vector3& cameraPos, const Vector3& playerPos, const Vector3& camDirection ); //Per camera mode, leaves FREE_SPECTATOR's alone.
 
 	void ApplyFrictionStopping( Vector3 &playerVel, BlockType blockTypeForPlayerFeet );
 	Vector3 GetPhysicsCorrectedVelocityForDeltaSeconds( const Vector3& velocityToPrevent, Vector3& posToMove, float deltaSeconds );
 
-	bool BoxTraceWithStepAndSample( const Vector3& rayStartPos, const Vector3& rayEndPos, RaycastResult3D& hitResult );
-	bool BoxTraceWithAmanatidesWoo( const Vector3& rayStartPos, const Vector3& rayEndPos, RaycastResult3D& minHitResult );
-	bool BoxTraceWithAmanatidesWoo( Vector3 boxCenterStartPos, Vector3 boxCenterEndPos, float boxHalfLengthX, float boxHalfWidthY, float boxHalfHeightZ, RaycastResult3D& out_result );
-
 	void SelectBlock( const WorldCoords& selectorsPos, const WorldCoords& endOfSelectionRay, float deltaSeconds );
-	void UnhighlightSelectedBlock();
 	bool RaycastWithStepAndSample( const WorldCoords& selectorsPos, const WorldCoords& endOfSelectionRay, RaycastResult3D& out_result );
 	bool RaycastWithAmanatidesWoo( const WorldCoords& selectorsPos, const WorldCoords& endOfSelectionRay, RaycastResult3D& out_result );
+	bool RaycastWithAmanatidesWoo( WorldBlockQuery& blockQuery, const WorldCoords& selectorsPos, const WorldCoords& endOfSelectionRay, RaycastResult3D& out_result ) const;
+	void RaycastBatchSlice( unsigned int firstSortedRay, unsigned int endSortedRay, const std::vector< RaycastRequest3D >& rays, std::vector< RaycastResult3D >& out_results ) const;
 
 	void DeactivateFarthestObsoleteChunk();
 	void ActivateNearestMissingChunk();
-	void InitializeLightingForChunk( Chunk* chunk );
 	void UpdateDirtyVertexArrays();
 	bool IsChunkBeyondFlushRadius( const Chunk* currentChunk ) const;
 	bool IsChunkWithinActiveRadius( const WorldCoordsXY& chunkPos ) const;
@@ -75,6 +127,9 @@ private:
 	WorldCoordsXY GetChunkPosNearerToPlayer( const WorldCoordsXY& chunkPos1, const WorldCoordsXY& chunkPos2 ) const;
 	void FlushChunk( Chunk* obsoleteChunk );
 	void CreateOrLoadChunk( const ChunkCoords& unloadedChunkPos );
+	void FinishCompletedLightingJobs();
+	void LinkLitChunkIntoWorld( Chunk* litChunk );
+	bool IsChunkAwaitingLighting( const ChunkCoords& chunkPos ) const;
 	void UpdateNeighborPointers( Chunk* newChunk );
 	void NullifyNeighborPointers( Chunk* obsoleteChunk );
 
@@ -90,9 +145,23 @@ private:
 	int GetIdealLightForBlock( BlockInfo& bi );
 
 	void UpdateChunks();
+	inline int GetSkyLightLevel() const { return ( g_useNightLightLevel ? NIGHT_LIGHTING_LEVEL : MAX_LIGHTING_LEVEL ); } //Currently just a constant.
+	void PlaceLandedFallingBlocks();
+
+	void UpdateRandomBlockTicks( Chunk* chunk );
+	void RunRandomBlockTick( const BlockInfo& bi, unsigned int randomBits );
+	void UpdateScheduledBlockTicks();
+	void RunFluidBlockTick( const BlockInfo& fluidBlock );
+	void RunFallingBlockTick( const BlockInfo& fallingBlock );
+	void SetBlockFromBlockTick( const BlockInfo& bi, BlockType newType, int fluidLevel = 0 );
+	void ScheduleBlockTick( const BlockInfo& bi );
+	void ScheduleBlockTicksAroundBlock( const BlockInfo& changedBlock ); //The block and its six neighbors, as any of them may now need to flow or fall.
+	void FlushBlockTickChanges();
+	unsigned int ApplyWorldEditToChunk( Chunk* chunk, const std::vector< WorldEditWrite >& writes, unsigned int firstSortedWrite, unsigned int endSortedWrite );
 	void UpdateLightingForBlockPlaced( BlockInfo blockPlacedInto );
 	void UpdateLightingForBlockBroken( BlockInfo blockBroken );
 	void MarkChunkLightingDirty( Chunk* chunk );
+	void MarkChunkBorderLightingDirty( Chunk* chunk, const ChunkCoords& borderDirection );
 	bool IsBlockDugEnoughToBreak( BlockInfo block );
 
 	bool IsPlayerOnGround();
@@ -108,9 +177,39 @@ private:
 	void CheckForDimensionWarp();
 	void CheckForHotbarChange();
 
+	WorldBlockQuery m_blockQuery; //Block lookups by integer coords, remembering the last chunk hit.
 	std::deque< BlockInfo > m_dirtyBlocks;
+	std::deque< ChunkLightingJob > m_chunksAwaitingLighting; //Linked strictly in creation order, so border resolution doesn't depend on thread timing.
+	StructureRegistry m_structureRegistry; //Village placements per coarse cell, shared by every chunk generated in range of them.
+	LodTerrain m_lodTerrain; //Coarse heightmap meshes out past the active chunks.
+	Frustum m_viewFrustum; //Set by TheGame each frame from the same matrices it hands OpenGL.
+	mutable unsigned int m_sectionWalkStamp; //Bumped per walk instead of clearing every chunk's visited flags.
+	mutable std::vector< SectionVisit > m_sectionWalkQueue; //Kept to reuse its capacity frame to frame.
+	EntitySystem m_entities; //Simulated with the player each tick, drawn after the player each frame.
+	std::vector< LandedFallingBlock > m_landedFallingBlocks; //Filled by m_entities each tick. Kept to reuse its capacity.
+	unsigned int m_currentTick; //Simulation ticks since the world was created, what scheduled block ticks are due against.
+	ChunkCoords m_blockTickResumeChunkCoords; //Where the last tick's block tick budget ran out, so the next starts there.
+	std::vector< BlockInfo > m_blockTickChangedBlocks; //This tick's block tick changes, relit together once the budget's spent.
+	std::vector< std::pair< ChunkCoords, unsigned int > > m_worldEditOrder; //Each write's chunk and index, sorted. Kept to reuse its capacity.
+	std::vector< LocalBlockIndex > m_worldEditChangedBlocks; //Scratch for the chunk a commit is on.
+	std::vector< std::pair< ChunkCoords, unsigned int > > m_raycastBatchOrder; //Each ray's starting chunk and index, sorted. Kept to reuse its capacity.
 	Camera3D* m_playerCamera;
 	Player* m_player;
+	BlockInfo m_selectedBlock; //Only meaningful while m_selectedFace isn't NONE.
+	BlockFace m_selectedFace;
+
+	float m_secondsOfSimulationOwed; //Frame time not yet simulated, always under a tick after Update.
+	float m_fractionTowardThisTick; //Of the way from the last tick to this one that the frame is drawn at.
+	Vector3 m_playerPositionLastTick; //Last two ticks' transforms, blended between for rendering.
+	Vector3 m_playerPositionThisTick;
+	Vector3 m_cameraPositionLastTick;
+	Vector3 m_cameraPositionThisTick;
+	bool m_wasJumpPressedSinceLastTick;
+	bool m_wasDimensionWarpPressedSinceLastTick;
+	bool m_wasForwardPressedSinceLastTick; //The four below brake a reversal of direction.
+	bool m_wasBackwardPressedSinceLastTick;
+	bool m_wasLeftPressedSinceLastTick;
+	bool m_wasRightPressedSinceLastTick;
 	
 	int m_activeRadius;
 	int m_flushRadius;
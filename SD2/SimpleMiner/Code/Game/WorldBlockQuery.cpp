@@ -0,0 +1,63 @@
+#include "Game/WorldBlockQuery.hpp"
+
+
+#include "Game/Chunk.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+WorldBlockQuery::WorldBlockQuery( const std::map< ChunkCoords, Chunk* >* activeChunksPerDimension )
+	: m_activeChunksPerDimension( activeChunksPerDimension )
+	, m_cachedDimension( DIM_OVERWORLD )
+	, m_cachedChunk( nullptr )
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+Chunk* WorldBlockQuery::GetChunk( Dimension dimension, const ChunkCoords& cc )
+{
+	if ( ( m_cachedChunk != nullptr ) && ( m_cachedDimension == dimension ) && ( m_cachedChunkCoords == cc ) )
+		return m_cachedChunk;
+
+	const std::map< ChunkCoords, Chunk* >& activeChunksInDimension = m_activeChunksPerDimension[ dimension ];
+	std::map< ChunkCoords, Chunk* >::const_iterator chunkIter = activeChunksInDimension.find( cc ); //One walk, not count() then at().
+	if ( chunkIter == activeChunksInDimension.end() )
+		return nullptr;
+
+	m_cachedDimension = dimension;
+	m_cachedChunkCoords = cc;
+	m_cachedChunk = chunkIter->second;
+	return m_cachedChunk;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+BlockInfo WorldBlockQuery::GetBlockInfo( Dimension dimension, const GlobalBlockCoords& gbc )
+{
+	if ( ( gbc.z < 0 ) || ( gbc.z >= CHUNK_Z_HEIGHT_IN_BLOCKS ) )
+		return BlockInfo();
+
+	Chunk* chunk = GetChunk( dimension, GetChunkCoordsFromGlobalBlockCoords( gbc ) );
+	if ( chunk == nullptr )
+		return BlockInfo(); //Outside loaded chunks.
+
+	return BlockInfo( chunk, GetLocalBlockIndexFromGlobalBlockCoords( gbc ) );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void WorldBlockQuery::ForgetChunk( const Chunk* chunk )
+{
+	if ( m_cachedChunk == chunk )
+		m_cachedChunk = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+BlockTraversal::BlockTraversal( WorldBlockQuery& query, Dimension dimension, const GlobalBlockCoords& startBlockCoords )
+	: m_query( query )
+	, m_dimension( dimension )
+	, m_blockCoords( startBlockCoords )
+{
+	Resolve();
+}
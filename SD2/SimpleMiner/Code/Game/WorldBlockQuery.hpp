@@ -0,0 +1,120 @@
+#pragma once
+
+
+#include <map>
+
+#include "Game/GameCommon.hpp"
+#include "Game/BlockInfo.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+class Chunk;
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Integer-coordinate block lookups for raycasts and collision. Consecutive lookups nearly always land in the same chunk,
+//so the last chunk found is remembered and the map is only walked again when a lookup leaves it.
+class WorldBlockQuery
+{
+public:
+
+	explicit WorldBlockQuery( const std::map< ChunkCoords, Chunk* >* activeChunksPerDimension ); //Array of NUM_DIMENSIONS.
+
+	Chunk* GetChunk( Dimension dimension, const ChunkCoords& cc );
+	BlockInfo GetBlockInfo( Dimension dimension, const GlobalBlockCoords& gbc ); //m_myChunk is nullptr if unloaded or above/below the world.
+	void ForgetChunk( const Chunk* chunk ); //Call before the chunk is freed.
+	inline void Invalidate() { m_cachedChunk = nullptr; }
+
+	static inline ChunkCoords GetChunkCoordsFromGlobalBlockCoords( const GlobalBlockCoords& gbc );
+	static inline LocalBlockIndex GetLocalBlockIndexFromGlobalBlockCoords( const GlobalBlockCoords& gbc ); //z must already be in range.
+
+
+private:
+
+	const std::map< ChunkCoords, Chunk* >* m_activeChunksPerDimension;
+	Dimension m_cachedDimension;
+	ChunkCoords m_cachedChunkCoords;
+	Chunk* m_cachedChunk; //Misses aren't cached, as that chunk may be activated any frame.
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Walks block to block by stepping the local index in place, only going back to the query when it crosses into another chunk.
+class BlockTraversal
+{
+public:
+
+	BlockTraversal( WorldBlockQuery& query, Dimension dimension, const GlobalBlockCoords& startBlockCoords );
+
+	inline void StepX( int step ); //step is +1 or -1.
+	inline void StepY( int step );
+	inline void StepZ( int step );
+
+	inline const BlockInfo& GetBlockInfo() const { return m_blockInfo; }
+	inline const GlobalBlockCoords& GetGlobalBlockCoords() const { return m_blockCoords; }
+	inline bool IsLoaded() const { return m_blockInfo.m_myChunk != nullptr; }
+
+
+private:
+
+	inline void Resolve() { m_blockInfo = m_query.GetBlockInfo( m_dimension, m_blockCoords ); }
+
+	WorldBlockQuery& m_query;
+	Dimension m_dimension;
+	GlobalBlockCoords m_blockCoords;
+	BlockInfo m_blockInfo;
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline ChunkCoords WorldBlockQuery::GetChunkCoordsFromGlobalBlockCoords( const GlobalBlockCoords& gbc )
+{
+	//Arithmetic shifts floor where division truncates, so unlike GetChunkCoordsFromWorldCoordsXY negatives need no correction.
+	return ChunkCoords( gbc.x >> CHUNK_BITS_X, gbc.y >> CHUNK_BITS_Y );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline LocalBlockIndex WorldBlockQuery::GetLocalBlockIndexFromGlobalBlockCoords( const GlobalBlockCoords& gbc )
+{
+	//Masking two's complement gives the mins-based local coords for negatives too.
+	return ( gbc.x & LOCAL_X_BITMASK ) | ( ( gbc.y & LOCAL_Y_BITMASK ) << CHUNK_BITS_X ) | ( gbc.z << BITS_PER_XY_LAYER );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline void BlockTraversal::StepX( int step )
+{
+	int newLocalX = ( m_blockCoords.x & LOCAL_X_BITMASK ) + step;
+	m_blockCoords.x += step;
+
+	if ( IsLoaded() && ( newLocalX >= 0 ) && ( newLocalX < CHUNK_X_LENGTH_IN_BLOCKS ) )
+		m_blockInfo.m_myBlockIndex += step;
+	else
+		Resolve();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline void BlockTraversal::StepY( int step )
+{
+	int newLocalY = ( m_blockCoords.y & LOCAL_Y_BITMASK ) + step;
+	m_blockCoords.y += step;
+
+	if ( IsLoaded() && ( newLocalY >= 0 ) && ( newLocalY < CHUNK_Y_WIDTH_IN_BLOCKS ) )
+		m_blockInfo.m_myBlockIndex += step * CHUNK_X_LENGTH_IN_BLOCKS;
+	else
+		Resolve();
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+inline void BlockTraversal::StepZ( int step )
+{
+	m_blockCoords.z += step; //Global z is local z, chunks being full-height.
+
+	if ( IsLoaded() && ( m_blockCoords.z >= 0 ) && ( m_blockCoords.z < CHUNK_Z_HEIGHT_IN_BLOCKS ) )
+		m_blockInfo.m_myBlockIndex += step * NUM_COLUMNS_PER_CHUNK;
+	else
+		Resolve();
+}
@@ -0,0 +1,70 @@
+#include "Game/WorldEdit.hpp"
+
+
+#include "Game/StructureRegistry.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+void WorldEdit::AddWrite( const GlobalBlockCoords& position, BlockType newType, BlockType onlyReplaceType )
+{
+	if ( ( position.z < 0 ) || ( position.z >= CHUNK_Z_HEIGHT_IN_BLOCKS ) )
+		return; //Above or below the world.
+
+	WorldEditWrite newWrite = { position, newType, onlyReplaceType };
+	m_writes.push_back( newWrite );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void WorldEdit::SetBlock( const GlobalBlockCoords& position, BlockType newType )
+{
+	AddWrite( position, newType, NUM_BLOCK_TYPES );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void WorldEdit::FillBox( const GlobalBlockCoords& mins, const GlobalBlockCoords& maxs, BlockType newType )
+{
+	for ( int z = mins.z; z <= maxs.z; z++ )
+		for ( int y = mins.y; y <= maxs.y; y++ )
+			for ( int x = mins.x; x <= maxs.x; x++ )
+				AddWrite( GlobalBlockCoords( x, y, z ), newType, NUM_BLOCK_TYPES );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void WorldEdit::ReplaceInBox( const GlobalBlockCoords& mins, const GlobalBlockCoords& maxs, BlockType oldType, BlockType newType )
+{
+	for ( int z = mins.z; z <= maxs.z; z++ )
+		for ( int y = mins.y; y <= maxs.y; y++ )
+			for ( int x = mins.x; x <= maxs.x; x++ )
+				AddWrite( GlobalBlockCoords( x, y, z ), newType, oldType );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void WorldEdit::FillSphere( const GlobalBlockCoords& center, int radius, BlockType newType )
+{
+	int radiusSquared = radius * radius;
+	for ( int offsetZ = -radius; offsetZ <= radius; offsetZ++ )
+	{
+		for ( int offsetY = -radius; offsetY <= radius; offsetY++ )
+		{
+			for ( int offsetX = -radius; offsetX <= radius; offsetX++ )
+			{
+				if ( ( offsetX * offsetX ) + ( offsetY * offsetY ) + ( offsetZ * offsetZ ) > radiusSquared )
+					continue;
+
+				AddWrite( center + GlobalBlockCoords( offsetX, offsetY, offsetZ ), newType, NUM_BLOCK_TYPES );
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void WorldEdit::PasteStructure( const Structure& structure, const GlobalBlockCoords& offset )
+{
+	for ( const StructureBlock& structureBlock : structure.m_blocks )
+		AddWrite( structureBlock.m_position + offset, structureBlock.m_type, NUM_BLOCK_TYPES );
+}
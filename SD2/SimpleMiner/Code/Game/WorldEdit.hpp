@@ -0,0 +1,49 @@
+#pragma once
+
+
+#include <vector>
+
+#include "Game/GameCommon.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct Structure;
+
+
+//--------------------------------------------------------------------------------------------------------------
+struct WorldEditWrite
+{
+	GlobalBlockCoords m_position;
+	BlockType m_newType;
+	BlockType m_onlyReplaceType; //NUM_BLOCK_TYPES to overwrite whatever's there.
+};
+
+
+//--------------------------------------------------------------------------------------------------------------
+//A batch of block writes for one dimension. Nothing changes until World::CommitWorldEdit, which writes each chunk's
+//share in one pass, then relights each touched column and remeshes each touched chunk once, rather than once per block.
+//Writes land in the order they were made, so later ones win. Blocks in unloaded chunks are skipped.
+class WorldEdit
+{
+public:
+
+	explicit WorldEdit( Dimension dimension ) : m_dimension( dimension ) {}
+
+	void SetBlock( const GlobalBlockCoords& position, BlockType newType );
+	void FillBox( const GlobalBlockCoords& mins, const GlobalBlockCoords& maxs, BlockType newType ); //Inclusive.
+	void ReplaceInBox( const GlobalBlockCoords& mins, const GlobalBlockCoords& maxs, BlockType oldType, BlockType newType ); //Checked at commit.
+	void FillSphere( const GlobalBlockCoords& center, int radius, BlockType newType ); //With AIR, an explosion crater.
+	void PasteStructure( const Structure& structure, const GlobalBlockCoords& offset );
+	void Clear() { m_writes.clear(); }
+
+	inline Dimension GetDimension() const { return m_dimension; }
+	inline const std::vector< WorldEditWrite >& GetWrites() const { return m_writes; }
+
+
+private:
+
+	void AddWrite( const GlobalBlockCoords& position, BlockType newType, BlockType onlyReplaceType );
+
+	Dimension m_dimension;
+	std::vector< WorldEditWrite > m_writes;
+};
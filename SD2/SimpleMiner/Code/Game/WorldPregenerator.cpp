@@ -0,0 +1,114 @@
+#include "Game/WorldPregenerator.hpp"
+
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include "Engine/Audio/TheAudio.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Error/ErrorWarningAssert.hpp"
+#include "Engine/FileUtils/FileUtils.hpp"
+#include "Engine/Renderer/SpriteSheet.hpp"
+#include "Engine/String/StringUtils.hpp"
+#include "Engine/Time/Time.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/BlockDefinition.hpp"
+#include "Game/Chunk.hpp"
+#include "Game/StructureRegistry.hpp"
+
+
+//--------------------------------------------------------------------------------------------------------------
+void ApplyWorldSeedFromCommandLine( const std::string& commandLine )
+{
+	std::string seedString;
+	if ( FindCommandLineOptionValue( commandLine, "seed", seedString ) )
+		g_worldSeed = (unsigned int)strtoul( seedString.c_str(), nullptr, 10 );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+bool GetPregenerationRadiusFromCommandLine( const std::string& commandLine, int& out_radiusInChunks )
+{
+	std::string radiusString;
+	if ( !FindCommandLineOptionValue( commandLine, "pregen", radiusString ) )
+		return false;
+
+	out_radiusInChunks = atoi( radiusString.c_str() );
+	return ( out_radiusInChunks >= 0 );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+static void GenerateAndSaveChunk( StructureRegistry& structureRegistry, Dimension dimension, const ChunkCoords& chunkCoords )
+{
+	Chunk* newChunk = new Chunk( chunkCoords, dimension ); //Heap, as each chunk's blocks are too big for a worker's stack.
+	newChunk->PopulateChunkWithPerlinNoise( structureRegistry );
+
+	std::vector< unsigned char > rleBuffer;
+	newChunk->GetRleString( rleBuffer );
+	delete newChunk;
+
+	SaveBufferToBinaryFile( Stringf( "Data/Saves/%s/Chunk_at_(%i,%i).chunk", GetDimensionAsString( dimension ), chunkCoords.x, chunkCoords.y ), rleBuffer );
+}
+
+
+//--------------------------------------------------------------------------------------------------------------
+void PregenerateWorld( int radiusInChunks )
+{
+	double startSeconds = GetCurrentTimeSeconds();
+
+	//Block definitions need audio and atlas layout but no window, so stand in a texture-less atlas.
+	g_theAudio = new AudioSystem();
+	g_textureAtlas = new SpriteSheet( 16, 16, 16, 16 ); //Same layout TheGame gives SimpleMinerAtlas.png.
+	BlockDefinition::InitializeBlockDefinitions();
+	LoadOrCreateWorldInfoFile(); //Settles g_worldSeed before anything generates.
+
+	struct PregenerationRequest { Dimension m_dimension; ChunkCoords m_chunkCoords; };
+	std::vector< PregenerationRequest > requests;
+	for ( int dimensionIndex = 0; dimensionIndex < NUM_DIMENSIONS; dimensionIndex++ )
+	{
+		Dimension dimension = (Dimension)dimensionIndex;
+		for ( int chunkY = -radiusInChunks; chunkY <= radiusInChunks; chunkY++ )
+		{
+			for ( int chunkX = -radiusInChunks; chunkX <= radiusInChunks; chunkX++ )
+			{
+				if ( ( chunkX * chunkX ) + ( chunkY * chunkY ) > ( radiusInChunks * radiusInChunks ) )
+					continue;
+
+				//Never overwrite a saved chunk, it may hold player edits.
+				std::vector< unsigned char > existingSave;
+				if ( LoadBinaryFileIntoBuffer( Stringf( "Data/Saves/%s/Chunk_at_(%i,%i).chunk", GetDimensionAsString( dimension ), chunkX, chunkY ), existingSave ) )
+					continue;
+
+				PregenerationRequest request;
+				request.m_dimension = dimension;
+				request.m_chunkCoords = ChunkCoords( chunkX, chunkY );
+				requests.push_back( request );
+			}
+		}
+	}
+
+	//Workers pull the next request off a shared counter; noise, heightmap and structure caches are all thread-safe.
+	StructureRegistry structureRegistry;
+	std::atomic< int > nextRequestIndex( 0 );
+	unsigned int numWorkers = GetMax( 1u, std::thread::hardware_concurrency() );
+	std::vector< std::future< void > > workers;
+	for ( unsigned int workerIndex = 0; workerIndex < numWorkers; workerIndex++ )
+	{
+		workers.push_back( std::async( std::launch::async, [ & ]()
+		{
+			for ( int requestIndex = nextRequestIndex++; requestIndex < (int)requests.size(); requestIndex = nextRequestIndex++ )
+				GenerateAndSaveChunk( structureRegistry, requests[ requestIndex ].m_dimension, requests[ requestIndex ].m_chunkCoords );
+		} ) );
+	}
+	for ( std::future< void >& worker : workers )
+		worker.wait();
+
+	ReportHeadlessResult( Stringf( "Pregenerated %i chunks with seed %u in %.2f seconds.", (int)requests.size(), g_worldSeed, GetCurrentTimeSeconds() - startSeconds ) );
+
+	delete g_textureAtlas;
+	g_textureAtlas = nullptr;
+	delete g_theAudio;
+	g_theAudio = nullptr;
+}
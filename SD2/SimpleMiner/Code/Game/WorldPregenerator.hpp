@@ -0,0 +1,14 @@
+#pragma once
+
+
+#include <string>
+
+
+//--------------------------------------------------------------------------------------------------------------
+//Command line options, e.g. "-seed=1234 -pregen=20":
+//	-seed=<n>		Seed for a brand new world. A world that already has a save keeps its saved seed.
+//	-pregen=<r>		Generate every unsaved chunk within r chunks of the origin in each dimension,
+//					write them to Data/Saves in parallel, report the time taken through ReportHeadlessResult, then exit without ever opening a window.
+void ApplyWorldSeedFromCommandLine( const std::string& commandLine );
+bool GetPregenerationRadiusFromCommandLine( const std::string& commandLine, int& out_radiusInChunks );
+void PregenerateWorld( int radiusInChunks );